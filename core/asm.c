@@ -26,7 +26,7 @@ PNAsm *potion_asm_clear(Potion *P, PNAsm * volatile asmb) {
 
 PNAsm *potion_asm_put(Potion *P, PNAsm * volatile asmb, PN val, size_t len) {
   u8 *ptr;
-  PN_FLEX_NEEDS(len, asmb, PN_TBYTES, PNAsm, ASM_UNIT);
+  PN_FLEX_NEEDS(len, asmb, PN_TBYTES, PNAsm, ASM_GROW(asmb));
   ptr = asmb->ptr + asmb->len;
 
   if (len == sizeof(u8))
@@ -42,7 +42,7 @@ PNAsm *potion_asm_put(Potion *P, PNAsm * volatile asmb, PN val, size_t len) {
 
 PNAsm *potion_asm_op(Potion *P, PNAsm * volatile asmb, u8 ins, int _a, int _b) {
   PN_OP *pos;
-  PN_FLEX_NEEDS(sizeof(PN_OP), asmb, PN_TBYTES, PNAsm, ASM_UNIT);
+  PN_FLEX_NEEDS(sizeof(PN_OP), asmb, PN_TBYTES, PNAsm, ASM_GROW(asmb));
   pos = (PN_OP *)(asmb->ptr + asmb->len);
 
   pos->code = ins;
@@ -55,7 +55,7 @@ PNAsm *potion_asm_op(Potion *P, PNAsm * volatile asmb, u8 ins, int _a, int _b) {
 
 PNAsm *potion_asm_write(Potion *P, PNAsm * volatile asmb, char *str, size_t len) {
   char *ptr;
-  PN_FLEX_NEEDS(len, asmb, PN_TBYTES, PNAsm, ASM_UNIT);
+  PN_FLEX_NEEDS(len, asmb, PN_TBYTES, PNAsm, ASM_GROW(asmb));
   ptr = (char *)asmb->ptr + asmb->len;
   PN_MEMCPY_N(ptr, str, char, len);
   asmb->len += len;
@@ -15,6 +15,9 @@
 #define POTION_ASM_H
 
 #define ASM_UNIT 512
+// buffers double once past a unit, so big functions aren't
+// copied over and over again as they're written out
+#define ASM_GROW(asmb) ((asmb)->siz > ASM_UNIT ? (asmb)->siz : ASM_UNIT)
 
 typedef struct {
   size_t from;
@@ -40,7 +43,7 @@ typedef struct {
       (OP_F)potion_##arch##_setlocal, \
       (OP_F)potion_##arch##_getupval, \
       (OP_F)potion_##arch##_setupval, \
-      (OP_F)NULL, \
+      (OP_F)potion_##arch##_gettable, \
       (OP_F)potion_##arch##_settable, \
       (OP_F)potion_##arch##_newlick, \
       (OP_F)potion_##arch##_getpath, \
@@ -72,26 +75,19 @@ typedef struct {
       (OP_F)potion_##arch##_named, \
       (OP_F)potion_##arch##_call, \
       (OP_F)potion_##arch##_callset, \
-      (OP_F)NULL, \
+      (OP_F)potion_##arch##_tailcall, \
       (OP_F)potion_##arch##_return, \
       (OP_F)potion_##arch##_method, \
-      (OP_F)potion_##arch##_class \
+      (OP_F)potion_##arch##_class, \
+      (OP_F)potion_##arch##_guard, \
+      (OP_F)potion_##arch##_puttable, \
+      (OP_F)potion_##arch##_concat \
     }, \
     .finish = potion_##arch##_finish, \
     .mcache = potion_##arch##_mcache, \
     .ivars = potion_##arch##_ivars \
   }
 
-#define PN_HAS_UPVALS(v) \
-  int v = 0; \
-  if (PN_TUPLE_LEN(f->protos) > 0) { \
-    PN_TUPLE_EACH(f->protos, i, proto2, { \
-      if (PN_TUPLE_LEN(PN_PROTO(proto2)->upvals) > 0) { \
-        v = 1; \
-      } \
-    }); \
-  }
-  
 #define ASM(ins) *asmp = potion_asm_put(P, *asmp, (PN)(ins), sizeof(u8))
 #define ASM2(pn) *asmp = potion_asm_put(P, *asmp, (PN)(pn), 2)
 #define ASMI(pn) *asmp = potion_asm_put(P, *asmp, (PN)(pn), sizeof(int))
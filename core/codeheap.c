@@ -0,0 +1,258 @@
+//
+// codeheap.c
+// a home for jitted code: functions are packed together
+// into shared chunks which are only writable while code
+// is being copied in (W^X) and are handed back once the
+// proto or vtable owning them has been collected.
+//
+// (c) 2008 why the lucky stiff, the freelance professor
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "potion.h"
+#include "internal.h"
+#include "gc.h"
+
+#define CODE_ALIGN  16
+#define CODE_CHUNK  (16 * POTION_PAGESIZE)
+#define CODE_SPLIT  64
+
+//
+// block headers are kept off to the side (in malloc'd
+// memory) so the chunks themselves can stay read+exec
+// even while the gc is updating owners.
+//
+struct PNCodeBlock {
+  struct PNCodeBlock *prev, *next; // address order
+  u8 *ptr;
+  size_t size;
+  PN owner; // PN_NIL when the block is free
+};
+
+struct PNCodeChunk {
+  struct PNCodeChunk *next;
+  u8 *base;
+  size_t size, tail;
+  struct PNCodeBlock *blocks, *last;
+};
+
+struct PNCodeHeap {
+  struct PNCodeChunk *chunks;
+  size_t used, holes, mapped;
+};
+
+static struct PNCodeHeap *potion_code_heap(Potion *P) {
+  struct PNMemory *M = P->mem;
+  if (M->code == NULL)
+    M->code = calloc(1, sizeof(struct PNCodeHeap));
+  return M->code;
+}
+
+static struct PNCodeChunk *potion_code_chunk(struct PNCodeHeap *h, size_t need) {
+  struct PNCodeChunk *c;
+  size_t size = PN_ALIGN(need, CODE_CHUNK);
+  u8 *base = potion_mmap(size, 0);
+  if (base == NULL) return NULL;
+  if (potion_mprotect(base, size, 1) != 0) {
+    potion_munmap(base, size);
+    return NULL;
+  }
+  c = calloc(1, sizeof(struct PNCodeChunk));
+  c->base = base;
+  c->size = size;
+  c->next = h->chunks;
+  h->chunks = c;
+  h->mapped += size;
+  return c;
+}
+
+static struct PNCodeBlock *potion_code_fit(struct PNCodeHeap *h, struct PNCodeChunk *c, size_t need) {
+  struct PNCodeBlock *b;
+  for (b = c->blocks; b != NULL; b = b->next) {
+    if (b->owner != PN_NIL || b->size < need) continue;
+    if (b->size - need >= CODE_SPLIT) {
+      struct PNCodeBlock *rest = calloc(1, sizeof(struct PNCodeBlock));
+      rest->ptr = b->ptr + need;
+      rest->size = b->size - need;
+      rest->prev = b;
+      rest->next = b->next;
+      if (b->next != NULL) b->next->prev = rest;
+      else c->last = rest;
+      b->next = rest;
+      b->size = need;
+    }
+    h->holes -= b->size;
+    return b;
+  }
+
+  if (c->size - c->tail < need) return NULL;
+  b = calloc(1, sizeof(struct PNCodeBlock));
+  b->ptr = c->base + c->tail;
+  b->size = need;
+  b->prev = c->last;
+  if (c->last != NULL) c->last->next = b;
+  else c->blocks = b;
+  c->last = b;
+  c->tail += need;
+  return b;
+}
+
+//
+// copies `len` bytes of machine code into the heap and
+// returns where it landed. `owner` is the object the code
+// lives and dies with (usually a proto or a vtable.)
+//
+void *potion_code_new(Potion *P, PN owner, const void *src, size_t len) {
+  struct PNCodeHeap *h = potion_code_heap(P);
+  struct PNCodeChunk *c;
+  struct PNCodeBlock *b = NULL;
+  size_t need = PN_ALIGN(len > 0 ? len : 1, CODE_ALIGN);
+  u8 *page, *end;
+
+  for (c = h->chunks; c != NULL; c = c->next)
+    if ((b = potion_code_fit(h, c, need)) != NULL) break;
+  if (b == NULL) {
+    if ((c = potion_code_chunk(h, need)) == NULL) {
+      fprintf(stderr, "** potion_code_new failed\n");
+      return NULL;
+    }
+    b = potion_code_fit(h, c, need);
+  }
+
+  b->owner = owner;
+  h->used += b->size;
+
+  page = (u8 *)((_PN)b->ptr & ~(_PN)(POTION_PAGESIZE - 1));
+  end = (u8 *)PN_ALIGN((_PN)(b->ptr + len), POTION_PAGESIZE);
+  potion_mprotect(page, end - page, 0);
+  PN_MEMCPY_N(b->ptr, src, u8, len);
+  potion_mprotect(page, end - page, 1);
+  return b->ptr;
+}
+
+static void potion_code_release(struct PNCodeHeap *h, struct PNCodeChunk *c, struct PNCodeBlock *b) {
+  struct PNCodeBlock *n;
+  h->used -= b->size;
+  h->holes += b->size;
+  b->owner = PN_NIL;
+
+  if (b->prev != NULL && b->prev->owner == PN_NIL) {
+    n = b;
+    b = b->prev;
+    b->size += n->size;
+    b->next = n->next;
+    if (n->next != NULL) n->next->prev = b;
+    else c->last = b;
+    free(n);
+  }
+  if (b->next != NULL && b->next->owner == PN_NIL) {
+    n = b->next;
+    b->size += n->size;
+    b->next = n->next;
+    if (n->next != NULL) n->next->prev = b;
+    else c->last = b;
+    free(n);
+  }
+
+  // a hole at the very end just goes back to the tail
+  if (b->next == NULL) {
+    c->tail -= b->size;
+    h->holes -= b->size;
+    c->last = b->prev;
+    if (b->prev != NULL) b->prev->next = NULL;
+    else c->blocks = NULL;
+    free(b);
+  }
+}
+
+static void potion_code_unmap(struct PNCodeHeap *h, struct PNCodeChunk **cp) {
+  struct PNCodeChunk *c = *cp;
+  *cp = c->next;
+  h->mapped -= c->size;
+  potion_munmap(c->base, c->size);
+  free(c);
+}
+
+void potion_code_free(Potion *P, void *ptr) {
+  struct PNCodeHeap *h = P->mem->code;
+  struct PNCodeChunk *c, **cp;
+  if (h == NULL || ptr == NULL) return;
+  for (cp = &h->chunks; (c = *cp) != NULL; cp = &c->next) {
+    struct PNCodeBlock *b;
+    if ((u8 *)ptr < c->base || (u8 *)ptr >= c->base + c->size) continue;
+    for (b = c->blocks; b != NULL; b = b->next)
+      if (b->ptr == ptr && b->owner != PN_NIL) {
+        potion_code_release(h, c, b);
+        if (c->blocks == NULL) potion_code_unmap(h, cp);
+        return;
+      }
+    return;
+  }
+}
+
+//
+// called by the gc once everything reachable has been
+// copied. an owner that got copied is followed to its new
+// home, an owner that was left behind takes its code with it.
+//
+void potion_code_sweep(Potion *P, int major) {
+  struct PNMemory *M = P->mem;
+  struct PNCodeHeap *h = M->code;
+  struct PNCodeChunk *c, **cp;
+  if (h == NULL) return;
+
+  cp = &h->chunks;
+  while ((c = *cp) != NULL) {
+    struct PNCodeBlock *b = c->blocks, *n;
+    for (; b != NULL; b = n) {
+      PN v = b->owner;
+      // releasing only ever merges free neighbours, so
+      // the next live block is safe to hold on to
+      for (n = b->next; n != NULL && n->owner == PN_NIL; n = n->next);
+      if (v == PN_NIL || IS_GC_PROTECTED(v) ||
+          !(IN_BIRTH_REGION(v) || (major && IN_OLDER_REGION(v))))
+        continue;
+      if (((struct PNFwd *)v)->fwd == POTION_COPIED) {
+        b->owner = ((struct PNFwd *)v)->ptr;
+        continue;
+      }
+      if (((struct PNObject *)v)->vt == PN_TPROTO) {
+        free(((struct PNProto *)v)->traces);
+        ((struct PNProto *)v)->traces = NULL;
+      }
+      potion_code_release(h, c, b);
+    }
+    if (c->blocks == NULL)
+      potion_code_unmap(h, cp);
+    else
+      cp = &c->next;
+  }
+}
+
+void potion_code_release_all(Potion *P) {
+  struct PNCodeHeap *h = P->mem->code;
+  if (h == NULL) return;
+  while (h->chunks != NULL) {
+    struct PNCodeBlock *b = h->chunks->blocks, *n;
+    for (; b != NULL; b = n) { n = b->next; free(b); }
+    potion_code_unmap(h, &h->chunks);
+  }
+  free(h);
+  P->mem->code = NULL;
+}
+
+PN potion_code_used(Potion *P, PN cl, PN self) {
+  struct PNCodeHeap *h = P->mem->code;
+  return PN_NUM(h == NULL ? 0 : h->used);
+}
+
+PN potion_code_holes(Potion *P, PN cl, PN self) {
+  struct PNCodeHeap *h = P->mem->code;
+  return PN_NUM(h == NULL ? 0 : h->holes);
+}
+
+PN potion_code_reserved(Potion *P, PN cl, PN self) {
+  struct PNCodeHeap *h = P->mem->code;
+  return PN_NUM(h == NULL ? 0 : h->mapped);
+}
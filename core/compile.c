@@ -9,12 +9,15 @@
 #include <math.h>
 #include "potion.h"
 #include "internal.h"
+#include "khash.h"
+#include "table.h"
 #include "ast.h"
 #include "opcodes.h"
 #include "asm.h"
 
-#define PN_ASM1(ins, _a)     f->asmb = (PN)potion_asm_op(P, (PNAsm *)f->asmb, (u8)ins, (int)_a, 0)
-#define PN_ASM2(ins, _a, _b) f->asmb = (PN)potion_asm_op(P, (PNAsm *)f->asmb, (u8)ins, (int)_a, (int)_b)
+// the proto may be promoted while its code is still growing
+#define PN_ASM1(ins, _a)     (f->asmb = (PN)potion_asm_op(P, (PNAsm *)f->asmb, (u8)ins, (int)_a, 0), PN_TOUCH(f))
+#define PN_ASM2(ins, _a, _b) (f->asmb = (PN)potion_asm_op(P, (PNAsm *)f->asmb, (u8)ins, (int)_a, (int)_b), PN_TOUCH(f))
 
 const struct {
   const char *name;
@@ -29,7 +32,8 @@ const struct {
   {"bitn", 2}, {"bitl", 2}, {"bitr", 2}, {"def", 2}, {"bind", 2}, {"message", 2},
   {"jump", 1}, {"test", 2}, {"testjmp", 2}, {"notjmp", 2}, {"named", 2},
   {"call", 2}, {"callset", 2}, {"tailcall", 2}, {"return", 1},
-  {"proto", 2}, {"class", 2}
+  {"proto", 2}, {"class", 2}, {"guard", 2}, {"puttable", 2},
+  {"concat", 2}
 };
 
 PN potion_proto_tree(Potion *P, PN cl, PN self) {
@@ -37,7 +41,9 @@ PN potion_proto_tree(Potion *P, PN cl, PN self) {
 }
 
 PN potion_proto_call(Potion *P, PN cl, PN self, PN args) {
-  return potion_vm(P, self, P->lobby, args, 0, NULL);
+  if (PN_IS_TUPLE(args))
+    return potion_vm(P, self, P->lobby, PN_TUPLE_LEN(args), PN_GET_TUPLE(args)->set, 0, NULL);
+  return potion_vm(P, self, P->lobby, 0, NULL, 0, NULL);
 }
 
 PN potion_proto_string(Potion *P, PN cl, PN self) {
@@ -78,7 +84,10 @@ PN potion_proto_string(Potion *P, PN cl, PN self) {
   });
   PN_TUPLE_EACH(t->values, i, v, {
     pn_printf(P, out, ".value ");
-    potion_bytes_obj_string(P, out, v);
+    if (PN_IS_PROTO(v))
+      pn_printf(P, out, "function %p", (void *)v);
+    else
+      potion_bytes_obj_string(P, out, v);
     pn_printf(P, out, " ; %u\n", i);
   });
   PN_TUPLE_EACH(t->protos, i, v, {
@@ -141,42 +150,98 @@ PN potion_proto_string(Potion *P, PN cl, PN self) {
   } else { \
     potion_source_asmb(P, f, loop, 0, (struct PNSource *)t->a[n], reg); \
   }
+
+//
+// while a proto is compiled, its locals, upvals and values
+// live in hashed indexes (each name or value to its slot), so
+// looking one up or adding one doesn't mean scanning a tuple
+// (or copying it to grow it by one.) the tuples are written
+// out once the proto's code is in, and the indexes dropped.
+//
+#define PN_LOCALS 0
+#define PN_UPVALS 1
+#define PN_VALUES 2
+#define PN_FIND(f, ix, x)  potion_index_find(P, (struct PNProto *)(f), ix, x)
+#define PN_STORE(f, ix, x) potion_index_put(P, (struct PNProto *)(f), ix, x)
+
+static PN_SIZE potion_index_find(Potion *P, vPN(Proto) f, int ix, PN x) {
+  PN n;
+  if (f->index == PN_NIL)
+    return PN_GET(ix == PN_LOCALS ? f->locals : ix == PN_UPVALS ? f->upvals : f->values, x);
+  n = potion_table_at(P, PN_NIL, PN_TUPLE_AT(f->index, ix), x);
+  return n == PN_NIL ? PN_NONE : PN_INT(n);
+}
+
+static PN_SIZE potion_index_put(Potion *P, vPN(Proto) f, int ix, PN x) {
+  PN_SIZE n = PN_FIND(f, ix, x);
+  if (n == PN_NONE) {
+    PN t = PN_TUPLE_AT(f->index, ix);
+    n = kh_size((struct PNTable *)potion_fwd(t));
+    potion_table_put(P, PN_NIL, t, x, PN_NUM(n));
+  }
+  return n;
+}
+
+// the index turned back into a tuple, each at its slot
+static PN potion_index_tuple(Potion *P, vPN(Proto) f, int ix) {
+  vPN(Table) t = (struct PNTable *)potion_fwd(PN_TUPLE_AT(f->index, ix));
+  vPN(Tuple) tup = PN_ALLOC_N(PN_TTUPLE, struct PNTuple, kh_size(t) * sizeof(PN));
+  unsigned k;
+  t = (struct PNTable *)potion_fwd(PN_TUPLE_AT(f->index, ix));
+  tup->len = kh_size(t);
+  for (k = kh_begin(t); k != kh_end(t); k++)
+    if (kh_exist(PN, t, k)) tup->set[PN_INT(kh_val(PN, t, k))] = kh_key(PN, t, k);
+  return (PN)tup;
+}
+
+static void potion_index_done(Potion *P, vPN(Proto) f) {
+  PN tup = potion_index_tuple(P, f, PN_LOCALS);
+  f->locals = tup;
+  tup = potion_index_tuple(P, f, PN_UPVALS);
+  f->upvals = tup;
+  tup = potion_index_tuple(P, f, PN_VALUES);
+  f->values = tup;
+  f->index = PN_NIL;
+  PN_TOUCH(f);
+}
+
 #define PN_BLOCK(reg, blk, sig) ({ \
   PN block = potion_send(blk, PN_compile, (PN)f, sig); \
   PN_SIZE num = PN_PUT(f->protos, block); \
   PN_ASM2(OP_PROTO, reg, num); \
   PN_TUPLE_EACH(((struct PNProto *)block)->upvals, i, v, { \
-    PN_SIZE numup = PN_GET(f->upvals, v); \
+    PN_SIZE numup = PN_FIND(f, PN_UPVALS, v); \
     if (numup != PN_NONE) PN_ASM2(OP_GETUPVAL, reg, numup); \
-    else                  PN_ASM2(OP_GETLOCAL, reg, PN_GET(f->locals, v)); \
+    else                  PN_ASM2(OP_GETLOCAL, reg, PN_FIND(f, PN_LOCALS, v)); \
   }); \
 })
 #define PN_UPVAL(name) ({ \
-  PN_SIZE numl = PN_GET(f->locals, name); \
+  PN_SIZE numl = PN_FIND(f, PN_LOCALS, name); \
   PN_SIZE numup = PN_NONE; \
   if (numl == PN_NONE) { \
-    numup = PN_GET(f->upvals, name); \
+    numup = PN_FIND(f, PN_UPVALS, name); \
     if (numup == PN_NONE) { \
       vPN(Proto) up = f; \
       int depth = 1; \
       while (PN_IS_PROTO(up->source)) { \
         up = (struct PNProto *)up->source; \
-        if (PN_NONE != (numup = PN_GET(up->locals, name))) break; \
+        if (PN_NONE != (numup = PN_FIND(up, PN_LOCALS, name))) break; \
         depth++; \
       } \
       if (numup != PN_NONE) { \
         up = f; \
         while (depth--) { \
-          up->upvals = PN_PUSH(up->upvals, name); \
+          PN_STORE(up, PN_UPVALS, name); \
           up = (struct PNProto *)up->source; \
         } \
       } \
-      numup = PN_GET(f->upvals, name); \
+      numup = PN_FIND(f, PN_UPVALS, name); \
     } \
   } \
   numup; \
 })
 #define PN_ARG_TABLE(args, reg, inc) potion_arg_asmb(P, f, loop, args, &reg, inc)
+#define PN_IS_SOURCE(v) (PN_IS_PTR(v) && PN_TYPE(v) == PN_TSOURCE)
 
 #define MAX_JUMPS 1024
 struct PNLoop {
@@ -187,46 +252,104 @@ struct PNLoop {
   int cjmpc;
 };
 
-void potion_source_asmb(Potion *, vPN(Proto), struct PNLoop *, PN_SIZE, vPN(Source), u8);
+void potion_source_asmb(Potion *, vPN(Proto), struct PNLoop *, PN_SIZE, vPN(Source), PN_SIZE);
+
+// is this the arg list of l (i), a lone positional arg?
+static int potion_arg_single(PN args) {
+  if (args == PN_NIL) return 0;
+  if (PN_PART(args) != AST_TABLE) return 1;
+  args = PN_S(args, 0);
+  return !PN_IS_NIL(args) && PN_TUPLE_LEN(args) == 1 &&
+    PN_PART(PN_TUPLE_AT(args, 0)) != AST_ASSIGN;
+}
+
+// the names in a block's sig, in order
+static PN potion_sig_names(Potion *P, PN src) {
+  PN names = PN_TUP0();
+  vPN(Source) t = (struct PNSource *)src;
+  if (src != PN_NIL && t->part == AST_TABLE && t->a[0] != PN_NIL) {
+    PN_TUPLE_EACH(t->a[0], i, v, {
+      vPN(Source) expr = (struct PNSource *)v;
+      if (expr->part == AST_EXPR) {
+        vPN(Source) name = (struct PNSource *)PN_TUPLE_AT(expr->a[0], 0);
+        if (name->part == AST_MESSAGE)
+          names = PN_PUSH(names, name->a[0]);
+      } else if (expr->part == AST_ASSIGN) {
+        vPN(Source) lhs = (struct PNSource *)expr->a[0];
+        if (lhs->part == AST_EXPR && PN_TUPLE_LEN(lhs->a[0]) == 1)
+        {
+          lhs = (struct PNSource *)PN_TUPLE_AT(lhs->a[0], 0);
+          if (lhs->part == AST_MESSAGE)
+            names = PN_PUSH(names, lhs->a[0]);
+        }
+      }
+    });
+  }
+  return names;
+}
+
+// the fewest arg slots a call with named args passes, since
+// the callee isn't known until it runs.
+#define NAMED_ARGS 8
+
+// a named arg's key, when it's a plain name (or number)
+static PN potion_arg_key(PN v) {
+  vPN(Source) lhs = (struct PNSource *)PN_S(v, 0);
+  if (lhs->part == AST_EXPR && PN_TUPLE_LEN(lhs->a[0]) == 1) {
+    lhs = (struct PNSource *)PN_TUPLE_AT(lhs->a[0], 0);
+    if (lhs->part == AST_MESSAGE || lhs->part == AST_VALUE)
+      return lhs->a[0];
+  }
+  return PN_NONE;
+}
 
-void potion_arg_asmb(Potion *P, vPN(Proto) f, struct PNLoop *loop, PN args, u8 *reg, int inc)
+void potion_arg_asmb(Potion *P, vPN(Proto) f, struct PNLoop *loop, PN args, PN_SIZE *reg, int inc)
 {
   if (args != PN_NIL) {
     if (PN_PART(args) == AST_TABLE) {
       args = PN_S(args, 0);
       if (!PN_IS_NIL(args)) {
-        u8 freg = *reg, sreg = *reg + PN_TUPLE_LEN(args) + 1;
+        // named args go where the callee's sig says, once it's
+        // known. so the positional ones (and nils) fill a window
+        // wide enough for them first.
+        PN_SIZE freg = *reg, sreg, width = PN_TUPLE_LEN(args);
+        int named = 0;
+        if (inc)
+          PN_TUPLE_EACH(args, i, v, { if (PN_PART(v) == AST_ASSIGN) named = 1; });
+        if (named && width < NAMED_ARGS) width = NAMED_ARGS;
+        sreg = freg + width + 1;
         PN_TUPLE_EACH(args, i, v, {
           if (inc) {
             (*reg)++;
-            if (PN_PART(v) == AST_ASSIGN) {
-              vPN(Source) lhs = (struct PNSource *)PN_S(v, 0);
-              potion_source_asmb(P, f, loop, 0, (struct PNSource *)PN_S(v, 1), sreg + 1);
-              if (lhs->part == AST_EXPR && PN_TUPLE_LEN(lhs->a[0]) == 1)
-              {
-                lhs = (struct PNSource *)PN_TUPLE_AT(lhs->a[0], 0);
-                if (lhs->part == AST_MESSAGE || lhs->part == AST_VALUE) {
-                  PN_OP op; op.a = lhs->a[0];
-                  if (!PN_IS_PTR(lhs->a[0]) && lhs->a[0] == (PN)op.a) {
-                    PN_ASM2(OP_LOADPN, sreg, lhs->a[0]);
-                  } else {
-                    PN_SIZE num = PN_PUT(f->values, lhs->a[0]);
-                    PN_ASM2(OP_LOADK, sreg, num);
-                  }
-                  lhs = NULL;
-                }
-              }
-
-              if (lhs != NULL)
-                potion_source_asmb(P, f, loop, 0, (struct PNSource *)lhs, sreg);
-
-              PN_ASM2(OP_NAMED, freg - 1, sreg + 1);
-              PN_REG(f, sreg + 1);
-            } else
+            if (PN_PART(v) == AST_ASSIGN)
+              PN_ASM2(OP_LOADPN, *reg, PN_NIL);
+            else
               potion_source_asmb(P, f, loop, 0, (struct PNSource *)v, *reg);
           } else
             potion_source_asmb(P, f, loop, 0, (struct PNSource *)v, *reg);
         });
+        if (!named) return;
+        while (*reg < freg + width)
+          PN_ASM2(OP_LOADPN, ++(*reg), PN_NIL);
+        PN_TUPLE_EACH(args, i, v, {
+          if (PN_PART(v) == AST_ASSIGN) {
+            PN key = potion_arg_key(v);
+            potion_source_asmb(P, f, loop, 0, (struct PNSource *)PN_S(v, 1), sreg + 1);
+            if (key == PN_NONE)
+              potion_source_asmb(P, f, loop, 0, (struct PNSource *)PN_S(v, 0), sreg);
+            else {
+              PN_OP op; op.a = key;
+              if (!PN_IS_PTR(key) && key == (PN)op.a) {
+                PN_ASM2(OP_LOADPN, sreg, key);
+              } else {
+                PN_SIZE num = PN_STORE(f, PN_VALUES, key);
+                PN_ASM2(OP_LOADK, sreg, num);
+              }
+            }
+            PN_ASM2(OP_NAMED, freg - 1, sreg + 1);
+            PN_REG(f, sreg + 1);
+          }
+        });
       }
     } else {
       if (inc) (*reg)++;
@@ -238,8 +361,568 @@ void potion_arg_asmb(Potion *P, vPN(Proto) f, struct PNLoop *loop, PN args, u8 *
   }
 }
 
+//
+// ("a", b, "c") join, or join(", "), on a tuple written out
+// right there, is an OP_CONCAT of the pieces (with the sep,
+// or nil, first): no tuple, and the string's made in one go.
+// the vm checks join is still the built-in one, and makes
+// the tuple and sends it join if it isn't.
+//
+static int potion_concat_asmb(Potion *P, vPN(Proto) f, struct PNLoop *loop, PN tbl, PN msg, PN_SIZE reg) {
+  PN items, args, sep = PN_NIL;
+  PN_SIZE breg = reg;
+  if (!P->optimize || PN_PART(tbl) != AST_TABLE || PN_PART(msg) != AST_MESSAGE ||
+      PN_S(msg, 0) != PN_join || PN_S(msg, 2) != PN_NIL)
+    return 0;
+  items = PN_S(tbl, 0);
+  if (!PN_IS_NIL(items))
+    PN_TUPLE_EACH(items, i, v, { if (PN_PART(v) == AST_ASSIGN) return 0; });
+
+  // the sep has to be a string, written right there
+  if ((args = PN_S(msg, 1)) != PN_NIL) {
+    if (PN_PART(args) == AST_TABLE) {
+      if (PN_IS_NIL(PN_S(args, 0)) || PN_TUPLE_LEN(PN_S(args, 0)) != 1) return 0;
+      args = PN_TUPLE_AT(PN_S(args, 0), 0);
+    }
+    if (PN_PART(args) == AST_EXPR && PN_TUPLE_LEN(PN_S(args, 0)) == 1)
+      args = PN_TUPLE_AT(PN_S(args, 0), 0);
+    if (PN_PART(args) != AST_VALUE || !PN_IS_STR(PN_S(args, 0)) ||
+        PN_S(args, 1) != PN_NIL || PN_S(args, 2) != PN_NIL)
+      return 0;
+    sep = PN_S(args, 0);
+  }
+
+  if (sep == PN_NIL)
+    PN_ASM2(OP_LOADPN, reg, PN_NIL);
+  else
+    PN_ASM2(OP_LOADK, reg, PN_STORE(f, PN_VALUES, sep));
+  if (!PN_IS_NIL(items))
+    PN_TUPLE_EACH(items, i, v, {
+      potion_source_asmb(P, f, loop, 0, (struct PNSource *)v, ++breg);
+    });
+  PN_ASM2(OP_CONCAT, reg, breg);
+  PN_REG(f, breg);
+  return 1;
+}
+
+//
+// inlining. a call to a small closure, bound just once to
+// a local, gets the closure's body compiled right into the
+// caller (its locals renamed so they can't run into the
+// caller's.) a guard checks the local still holds a closure
+// over that proto, and makes the ordinary call if not. the
+// renamed locals keep their last values until the next time
+// through, so a callee's locals can live a little longer.
+//
+#define INLINE_OPS   32
+#define INLINE_DEPTH 2
+
+// the proto which holds `name` as a local (nil if none does)
+static PN potion_inline_scope(Potion *P, vPN(Proto) f, PN name) {
+  while (PN_FIND(f, PN_LOCALS, name) == PN_NONE) {
+    if (!PN_IS_PROTO(f->source)) return PN_NIL;
+    f = (struct PNProto *)f->source;
+  }
+  return (PN)f;
+}
+
+// counts the assignments to `name` in a tree, noting the
+// function it's bound to (if it's bound to one.)
+static int potion_inline_binds(PN t, PN name, PN *def) {
+  int n = 0, i;
+  if (!PN_IS_SOURCE(t)) {
+    if (PN_IS_PTR(t) && PN_IS_TUPLE(t))
+      PN_TUPLE_EACH(t, j, v, { n += potion_inline_binds(v, name, def); });
+    return n;
+  }
+  if (PN_PART(t) == AST_ASSIGN || PN_PART(t) == AST_INC) {
+    PN lhs = PN_S(t, 0), rhs = PN_S(t, 1);
+    if (PN_PART(lhs) == AST_EXPR)
+      lhs = PN_TUPLE_AT(PN_S(lhs, 0), PN_TUPLE_LEN(PN_S(lhs, 0)) - 1);
+    if ((PN_PART(lhs) == AST_MESSAGE || PN_PART(lhs) == AST_QUERY) && PN_S(lhs, 0) == name) {
+      n++;
+      if (PN_PART(t) == AST_ASSIGN && PN_PART(rhs) == AST_EXPR && PN_TUPLE_LEN(PN_S(rhs, 0)) == 1)
+        rhs = PN_TUPLE_AT(PN_S(rhs, 0), 0);
+      if (PN_PART(t) == AST_ASSIGN && PN_PART(rhs) == AST_PROTO) *def = rhs;
+    }
+  }
+  for (i = 0; i < 3; i++) n += potion_inline_binds(PN_S(t, i), name, def);
+  return n;
+}
+
+// the param names of the block a local is bound to, if it's
+// bound just the once (so a call through it can only go there.)
+static PN potion_call_params(Potion *P, vPN(Proto) f, PN name) {
+  PN def = PN_NIL, up = potion_inline_scope(P, f, name);
+  if (up == PN_NIL || potion_inline_binds(PN_PROTO(up)->tree, name, &def) != 1 || def == PN_NIL)
+    return PN_NIL;
+  return potion_sig_names(P, PN_S(def, 0));
+}
+
+// 2 for a plain value, 1 for a local (or upval) read, 0 for
+// anything which might have an effect.
+static int potion_arg_pure(Potion *P, vPN(Proto) f, PN v) {
+  PN t;
+  if (PN_PART(v) != AST_EXPR || PN_TUPLE_LEN(PN_S(v, 0)) != 1) return 0;
+  t = PN_TUPLE_AT(PN_S(v, 0), 0);
+  if (PN_S(t, 1) != PN_NIL || PN_S(t, 2) != PN_NIL) return 0;
+  if (PN_PART(t) == AST_VALUE) return 2;
+  return PN_PART(t) == AST_MESSAGE && potion_inline_scope(P, f, PN_S(t, 0)) != PN_NIL;
+}
+
+// a call to a known block, with named args, gets them put in
+// order while compiling: where the sig says, nil for any left
+// out. (a key the sig doesn't have leaves it to the vm, as do
+// args which would then be worked out in a different order.)
+static PN potion_call_named(Potion *P, vPN(Proto) f, PN name, PN args) {
+  PN params, slots, tup;
+  PN_SIZE n = 0, len, i, last = 0;
+  int named = 0, pure = 1;
+  if (args == PN_NIL || PN_PART(args) != AST_TABLE || PN_IS_NIL(PN_S(args, 0))) return args;
+  PN_TUPLE_EACH(PN_S(args, 0), j, v, {
+    if (PN_PART(v) == AST_ASSIGN) {
+      named = 1;
+      v = PN_S(v, 1);
+    }
+    if (!potion_arg_pure(P, f, v)) pure = 0;
+  });
+  if (!named || (params = potion_call_params(P, f, name)) == PN_NIL) return args;
+
+  len = PN_TUPLE_LEN(params);
+  slots = potion_tuple_with_size(P, len);
+  for (i = 0; i < len; i++) PN_TUPLE_AT(slots, i) = PN_NIL;
+  PN_TUPLE_EACH(PN_S(args, 0), j, v, {
+    PN_SIZE x = n;
+    if (PN_PART(v) == AST_ASSIGN) {
+      PN key = potion_arg_key(v);
+      if (PN_IS_NUM(key)) x = PN_INT(key);
+      else if (key == PN_NONE || (x = PN_GET(params, key)) == PN_NONE) return args;
+      v = PN_S(v, 1);
+    } else
+      n++;
+    if (x >= len || PN_TUPLE_AT(slots, x) != PN_NIL) return args;
+    if (!pure && potion_arg_pure(P, f, v) != 2) {
+      if (x < last) return args;
+      last = x;
+    }
+    PN_TUPLE_AT(slots, x) = v;
+  });
+
+  tup = PN_TUP0();
+  PN_TUPLE_EACH(slots, j, v, {
+    tup = PN_PUSH(tup, v == PN_NIL ? PN_AST(EXPR, PN_TUP(PN_AST(VALUE, PN_NIL))) : v);
+  });
+  if (P->verbose) printf("; named args to %s put in order\n", PN_STR_PTR(name));
+  return PN_AST(TABLE, tup);
+}
+
+static int potion_inline_mentions(PN t, PN name) {
+  int i;
+  if (!PN_IS_SOURCE(t)) {
+    if (PN_IS_PTR(t) && PN_IS_TUPLE(t))
+      PN_TUPLE_EACH(t, j, v, { if (potion_inline_mentions(v, name)) return 1; });
+    return 0;
+  }
+  if (PN_PART(t) == AST_MESSAGE && PN_S(t, 0) == name) return 1;
+  for (i = 0; i < 3; i++)
+    if (potion_inline_mentions(PN_S(t, i), name)) return 1;
+  return 0;
+}
+
+// is local `name` set by one of the plain assignments the
+// body starts with, before anything could read it?
+static int potion_inline_sets(Potion *P, PN tree, PN name) {
+  if (!PN_IS_PTR(PN_S(tree, 0)) || !PN_IS_TUPLE(PN_S(tree, 0))) return 0;
+  PN_TUPLE_EACH(PN_S(tree, 0), i, s, {
+    PN lhs;
+    if (!PN_IS_SOURCE(s) || PN_PART(s) != AST_ASSIGN) return 0;
+    lhs = PN_S(s, 0);
+    if (PN_PART(lhs) != AST_EXPR || PN_TUPLE_LEN(PN_S(lhs, 0)) != 1) return 0;
+    lhs = PN_TUPLE_AT(PN_S(lhs, 0), 0);
+    if (PN_PART(lhs) != AST_MESSAGE || PN_S(lhs, 1) != PN_NIL) return 0;
+    if (potion_inline_mentions(PN_S(s, 1), name)) return 0;
+    if (PN_S(lhs, 0) == name) return 1;
+  });
+  return 0;
+}
+
+// does the tree of `c` mean the same thing compiled in `f`?
+// (any name which isn't local to `c` has to be found in the
+// same place from both, or nowhere at all.)
+static const char *potion_inline_names(Potion *P, vPN(Proto) f, vPN(Proto) c, PN t, int count) {
+  const char *why = NULL;
+  int i;
+  if (!PN_IS_SOURCE(t)) {
+    if (PN_IS_PTR(t) && PN_IS_TUPLE(t))
+      PN_TUPLE_EACH(t, j, v, { if (why == NULL) why = potion_inline_names(P, f, c, v, 0); });
+    return why;
+  }
+  switch (PN_PART(t)) {
+    case AST_QUERY: case AST_PATHQ:
+    return "it has queries";
+    case AST_EXPR:
+      PN_TUPLE_EACH(PN_S(t, 0), j, v, { if (why == NULL) why = potion_inline_names(P, f, c, v, j); });
+    return why;
+    case AST_TABLE:
+      if (!PN_IS_PTR(PN_S(t, 0))) return NULL;
+      PN_TUPLE_EACH(PN_S(t, 0), j, v, {
+        if (why == NULL)
+          why = potion_inline_names(P, f, c, PN_PART(v) == AST_ASSIGN ? PN_S(v, 1) : v, 0);
+      });
+    return why;
+    case AST_MESSAGE: {
+      PN name = PN_S(t, 0);
+      if (name == PN_return) return "it returns early";
+      if (count == 0 && PN_GET(c->locals, name) == PN_NONE &&
+          potion_inline_scope(P, f, name) != (PN_GET(c->upvals, name) == PN_NONE ? PN_NIL :
+            potion_inline_scope(P, (struct PNProto *)c->source, name)))
+        return "its names mean something else here";
+    }
+    break;
+  }
+  for (i = 0; i < 3 && why == NULL; i++) why = potion_inline_names(P, f, c, PN_S(t, i), 0);
+  return why;
+}
+
+// copies a tree, renaming the locals of `c` to `names`
+static PN potion_inline_copy(Potion *P, vPN(Proto) c, PN names, PN t, int count) {
+  PN a, b, d;
+  if (!PN_IS_SOURCE(t)) {
+    if (PN_IS_PTR(t) && PN_IS_TUPLE(t)) {
+      PN tup = PN_TUP0();
+      PN_TUPLE_EACH(t, j, v, { tup = PN_PUSH(tup, potion_inline_copy(P, c, names, v, 0)); });
+      return tup;
+    }
+    return t;
+  }
+  a = PN_S(t, 0);
+  switch (PN_PART(t)) {
+    case AST_EXPR: {
+      PN tup = PN_TUP0();
+      PN_TUPLE_EACH(a, j, v, { tup = PN_PUSH(tup, potion_inline_copy(P, c, names, v, j)); });
+      return PN_AST(EXPR, tup);
+    }
+    case AST_TABLE: {
+      PN tup = PN_TUP0();
+      if (!PN_IS_PTR(a)) return t;
+      PN_TUPLE_EACH(a, j, v, {
+        if (PN_PART(v) == AST_ASSIGN) // named, so the key stays put
+          v = PN_AST2(ASSIGN, PN_S(v, 0), potion_inline_copy(P, c, names, PN_S(v, 1), 0));
+        else
+          v = potion_inline_copy(P, c, names, v, 0);
+        tup = PN_PUSH(tup, v);
+      });
+      return PN_AST(TABLE, tup);
+    }
+    case AST_MESSAGE:
+      if (count == 0 && PN_GET(c->locals, a) != PN_NONE)
+        a = PN_TUPLE_AT(names, PN_GET(c->locals, a));
+    break;
+    default:
+      a = potion_inline_copy(P, c, names, a, 0);
+    break;
+  }
+  b = potion_inline_copy(P, c, names, PN_S(t, 1), 0);
+  d = potion_inline_copy(P, c, names, PN_S(t, 2), 0);
+  return potion_source(P, PN_PART(t), a, b, d);
+}
+
+// tries inlining the call `t`, once the closure is loaded
+// into `reg` and its arguments are in `reg + 2` to `breg`.
+// returns the jump which skips the ordinary call (or -1 if
+// the call is to be made as usual.)
+static int potion_inline_asmb(Potion *P, vPN(Proto) f, vPN(Source) t, PN_SIZE reg, PN_SIZE breg) {
+  PN name = t->a[0], args = t->a[1], def = PN_NIL, names, body;
+  vPN(Proto) up = (struct PNProto *)potion_inline_scope(P, f, name);
+  vPN(Proto) c = NULL;
+  const char *why = NULL;
+  int jmp, params = 0;
+  PN_SIZE areg = reg + 1;
+
+  if (t->part != AST_MESSAGE || t->a[2] != PN_NIL || (PN)up == PN_NIL) return -1;
+  if (potion_inline_binds(up->tree, name, &def) != 1) {
+    if (def == PN_NIL) return -1;
+    why = "it's bound more than once";
+  } else if (def == PN_NIL)
+    return -1;
+
+  if (why == NULL) {
+    int named = 0;
+    PN_TUPLE_EACH(up->protos, i, v, {
+      if (PN_PROTO(v)->tree == PN_S(def, 1)) c = PN_PROTO(v);
+    });
+    if (PN_PART(args) == AST_TABLE && PN_IS_PTR(PN_S(args, 0)))
+      PN_TUPLE_EACH(PN_S(args, 0), i, v, { if (PN_PART(v) == AST_ASSIGN) named = 1; });
+
+    if (c == NULL) why = "it isn't compiled yet";
+    else {
+      PN_TUPLE_EACH(c->sig, i, v, { if (PN_IS_STR(v)) params++; });
+      if (PN_TUPLE_LEN(c->protos) > 0) why = "it makes closures";
+      else if (PN_TUPLE_LEN(c->paths) > 0) why = "it has paths on self";
+      else if (PN_OP_LEN(c->asmb) > INLINE_OPS) why = "it's too big";
+      else if (P->inlining >= INLINE_DEPTH) why = "it's too deep";
+      else if (named || breg - areg != params) why = "the arguments don't match";
+      else why = potion_inline_names(P, f, c, c->tree, 0);
+    }
+  }
+  if (why != NULL) {
+    if (P->verbose) printf("; not inlining %s: %s\n", PN_STR_PTR(name), why);
+    return -1;
+  }
+
+  names = PN_TUP0();
+  PN_TUPLE_EACH(c->locals, i, v, {
+    char local[256];
+    snprintf(local, sizeof(local), "%s:%d:%s", PN_STR_PTR(name), P->inlining + 1, PN_STR_PTR(v));
+    names = PN_PUSH(names, potion_str(P, local));
+  });
+  body = potion_inline_copy(P, c, names, c->tree, 0);
+
+  PN_ASM2(OP_GUARD, reg, PN_STORE(f, PN_VALUES, (PN)c));
+  jmp = PN_OP_LEN(f->asmb);
+  PN_ASM2(OP_NOTJMP, reg, 0);
+  PN_TUPLE_EACH(c->sig, i, v, {
+    if (PN_IS_STR(v)) {
+      areg++;
+      PN_ASM2(OP_SETLOCAL, areg, PN_STORE(f, PN_LOCALS, PN_TUPLE_AT(names, PN_GET(c->locals, v))));
+    }
+  });
+  PN_TUPLE_EACH(c->locals, i, v, {
+    if (PN_GET(c->sig, v) == PN_NONE && !potion_inline_sets(P, c->tree, v)) {
+      PN_ASM2(OP_LOADPN, reg, PN_NIL);
+      PN_ASM2(OP_SETLOCAL, reg, PN_STORE(f, PN_LOCALS, PN_TUPLE_AT(names, i)));
+    }
+  });
+
+  PN_ASM1(OP_SELF, reg);
+  P->inlining++;
+  potion_source_asmb(P, f, NULL, 0, (struct PNSource *)body, reg);
+  P->inlining--;
+  PN_ASM1(OP_JMP, 0);
+  PN_OP_AT(f->asmb, jmp).b = (PN_OP_LEN(f->asmb) - jmp) - 1;
+  if (P->verbose) printf("; inlined %s (%d ops)\n", PN_STR_PTR(name), (int)PN_OP_LEN(c->asmb));
+  return PN_OP_LEN(f->asmb) - 1;
+}
+
+//
+// loops. n times, a to (b, block), a step (b, s, block) and
+// t each, given a literal block, run the block's body right
+// in the caller, counting in hidden locals. a guard checks
+// the method sent is still the built-in one (so the receiver
+// is a number or a tuple, and nobody's redefined it) and
+// makes the ordinary call if not.
+//
+enum { LOOP_TIMES, LOOP_TO, LOOP_STEP, LOOP_EACH };
+
+// a hidden local of loop `name`, one per inlining depth
+static PN_SIZE potion_loop_local(Potion *P, vPN(Proto) f, PN name, const char *part) {
+  char local[256];
+  snprintf(local, sizeof(local), "%s:%d:%s", PN_STR_PTR(name), P->inlining + 1, part);
+  return PN_STORE(f, PN_LOCALS, potion_str(P, local));
+}
+
+// is `blk` the literal block of a loop sent somewhere in `t`?
+// (those are the only closures a loop's body can make, since
+// one inside would be inlined, or at least never kept.)
+static int potion_loop_block(Potion *P, PN t, PN blk) {
+  int i;
+  if (!PN_IS_SOURCE(t)) {
+    if (PN_IS_PTR(t) && PN_IS_TUPLE(t))
+      PN_TUPLE_EACH(t, j, v, { if (potion_loop_block(P, v, blk)) return 1; });
+    return 0;
+  }
+  if (PN_PART(t) == AST_MESSAGE) {
+    PN name = PN_S(t, 0), args = PN_S(t, 1);
+    if (PN_S(t, 2) == blk)
+      return name == potion_str(P, "times") || name == potion_str(P, "each");
+    if (PN_S(t, 2) == PN_NIL && args != PN_NIL && PN_PART(args) == AST_TABLE &&
+        PN_IS_PTR(PN_S(args, 0)) && PN_TUPLE_LEN(PN_S(args, 0)) > 1 &&
+        (name == potion_str(P, "to") || name == potion_str(P, "step"))) {
+      PN last = PN_TUPLE_AT(PN_S(args, 0), PN_TUPLE_LEN(PN_S(args, 0)) - 1);
+      if (PN_PART(last) == AST_EXPR && PN_TUPLE_LEN(PN_S(last, 0)) == 1)
+        last = PN_TUPLE_AT(PN_S(last, 0), 0);
+      if (PN_PART(last) == AST_PROTO && PN_S(last, 1) == blk) return 1;
+    }
+  }
+  for (i = 0; i < 3; i++)
+    if (potion_loop_block(P, PN_S(t, i), blk)) return 1;
+  return 0;
+}
+
+// tries inlining the loop `t`, once the method is in `reg`,
+// the receiver in `reg + 1` and the args and block up to
+// `breg`. returns the jump which skips the ordinary call
+// (or -1 if the call is to be made as usual.)
+static int potion_loop_asmb(Potion *P, vPN(Proto) f, vPN(Source) t, PN_SIZE reg, PN_SIZE breg) {
+  PN name = t->a[0], blk = t->a[2], sig = t->a[1], m, names, body, pn = PN_NIL, def = PN_NIL;
+  vPN(Proto) c = NULL;
+  const char *why = NULL;
+  PN_F native;
+  int kind, nargs = 0, jmp, top, done, own = 0;
+  PN_SIZE ctr, lim, from = 0, step = 0, cond = breg + 1;
+
+  if (t->part != AST_MESSAGE || !P->optimize) return -1;
+  if (blk == PN_NIL && sig != PN_NIL && PN_PART(sig) == AST_TABLE && PN_IS_PTR(PN_S(sig, 0))) {
+    PN last;
+    nargs = PN_TUPLE_LEN(PN_S(sig, 0)) - 1;
+    PN_TUPLE_EACH(PN_S(sig, 0), i, v, { if (PN_PART(v) == AST_ASSIGN) return -1; });
+    last = PN_TUPLE_AT(PN_S(sig, 0), nargs);
+    if (PN_PART(last) == AST_EXPR && PN_TUPLE_LEN(PN_S(last, 0)) == 1)
+      last = PN_TUPLE_AT(PN_S(last, 0), 0);
+    if (PN_PART(last) != AST_PROTO) return -1;
+    blk = PN_S(last, 1);
+    sig = PN_S(last, 0);
+  }
+  if (blk == PN_NIL) return -1;
+
+  if (name == potion_str(P, "times") && nargs == 0)
+    kind = LOOP_TIMES, native = (PN_F)potion_num_times;
+  else if (name == potion_str(P, "to") && nargs == 1)
+    kind = LOOP_TO, native = (PN_F)potion_num_to;
+  else if (name == potion_str(P, "step") && nargs == 2)
+    kind = LOOP_STEP, native = (PN_F)potion_num_step;
+  else if (name == potion_str(P, "each") && nargs == 0)
+    kind = LOOP_EACH, native = (PN_F)potion_tuple_each;
+  else
+    return -1;
+  m = potion_bind(P, kind == LOOP_EACH ? potion_tuple_empty(P) : PN_NUM(0), name);
+  if (!PN_IS_CLOSURE(m) || PN_CLOSURE(m)->method != native) return -1;
+
+  PN_TUPLE_EACH(f->protos, i, v, {
+    if (PN_PROTO(v)->tree == blk) c = PN_PROTO(v);
+  });
+  if (c == NULL) why = "it isn't compiled yet";
+  else if (PN_TUPLE_LEN(c->paths) > 0) why = "it has paths on self";
+  else if (potion_inline_mentions(c->tree, PN_self)) why = "it uses self";
+  else if (P->inlining >= INLINE_DEPTH) why = "it's too deep";
+  else why = potion_inline_names(P, f, c, c->tree, 0);
+  if (why == NULL)
+    PN_TUPLE_EACH(c->protos, i, v, {
+      if (!potion_loop_block(P, c->tree, PN_PROTO(v)->tree)) why = "it makes closures";
+    });
+  if (why != NULL) {
+    if (P->verbose) printf("; not inlining %s: %s\n", PN_STR_PTR(name), why);
+    return -1;
+  }
+
+  names = PN_TUP0();
+  PN_TUPLE_EACH(c->locals, i, v, {
+    char local[256];
+    snprintf(local, sizeof(local), "%s:%d:%s", PN_STR_PTR(name), P->inlining + 1, PN_STR_PTR(v));
+    names = PN_PUSH(names, potion_str(P, local));
+  });
+  body = potion_inline_copy(P, c, names, c->tree, 0);
+  PN_TUPLE_EACH(c->sig, i, v, {
+    if (PN_IS_STR(v) && pn == PN_NIL) pn = v;
+  });
+  // a count the body never sets can be counted in directly
+  if (kind != LOOP_EACH && pn != PN_NIL && potion_inline_binds(c->tree, pn, &def) == 0)
+    own = 1;
+
+  PN_ASM2(OP_MOVE, cond, reg);
+  PN_ASM2(OP_GUARD, cond, PN_STORE(f, PN_VALUES, m));
+  jmp = PN_OP_LEN(f->asmb);
+  PN_ASM2(OP_NOTJMP, cond, 0);
+  PN_REG(f, cond);
+
+  // the counter starts at 0 (or the receiver) and runs
+  // while it's short of the limit
+  ctr = own ? PN_STORE(f, PN_LOCALS, PN_TUPLE_AT(names, PN_GET(c->locals, pn))) :
+    potion_loop_local(P, f, name, "at");
+  lim = potion_loop_local(P, f, name, "end");
+  if (kind == LOOP_TIMES) {
+    PN_ASM2(OP_SETLOCAL, reg + 1, lim);
+    PN_ASM2(OP_LOADPN, reg, PN_NUM(0));
+    PN_ASM2(OP_SETLOCAL, reg, ctr);
+  } else if (kind == LOOP_EACH) {
+    from = potion_loop_local(P, f, name, "of");
+    PN_ASM2(OP_SETLOCAL, reg + 1, from);
+    PN_ASM2(OP_LOADK, reg, PN_STORE(f, PN_VALUES, potion_bind(P, potion_tuple_empty(P), potion_str(P, "length"))));
+    PN_ASM2(OP_CALL, reg, reg + 1);
+    PN_ASM2(OP_SETLOCAL, reg, lim);
+    PN_ASM2(OP_LOADPN, reg, PN_NUM(0));
+    PN_ASM2(OP_SETLOCAL, reg, ctr);
+  } else {
+    from = potion_loop_local(P, f, name, "from");
+    step = potion_loop_local(P, f, name, "by");
+    PN_ASM2(OP_SETLOCAL, reg + 1, ctr);
+    PN_ASM2(OP_SETLOCAL, reg + 1, from);
+    PN_ASM2(OP_SETLOCAL, reg + 2, lim);
+    if (kind == LOOP_STEP)
+      PN_ASM2(OP_SETLOCAL, reg + 3, step);
+    else {
+      // counting down if the end's below the start, and
+      // stopping once it's gone one past the end
+      PN_ASM2(OP_LOADPN, reg, PN_NUM(1));
+      PN_ASM2(OP_SETLOCAL, reg, step);
+      PN_ASM2(OP_LT, reg + 2, reg + 1);
+      PN_ASM2(OP_NOTJMP, reg + 2, 2);
+      PN_ASM2(OP_LOADPN, reg, PN_NUM(-1));
+      PN_ASM2(OP_SETLOCAL, reg, step);
+      PN_ASM2(OP_GETLOCAL, reg + 1, lim);
+      PN_ASM2(OP_ADD, reg + 1, reg);
+      PN_ASM2(OP_SETLOCAL, reg + 1, lim);
+    }
+  }
+
+  top = PN_OP_LEN(f->asmb);
+  PN_ASM2(OP_GETLOCAL, reg, ctr);
+  PN_ASM2(OP_GETLOCAL, reg + 1, lim);
+  PN_ASM2(kind == LOOP_TO ? OP_NEQ : kind == LOOP_STEP ? OP_LTE : OP_LT, reg, reg + 1);
+  done = PN_OP_LEN(f->asmb);
+  PN_ASM2(OP_NOTJMP, reg, 0);
+
+  // the block's first arg is the count (or the item), any
+  // others are nil, and its locals start out nil each time
+  PN_TUPLE_EACH(c->locals, i, v, {
+    PN_SIZE num;
+    if ((v == pn && own) || !potion_inline_mentions(c->tree, v)) continue;
+    num = PN_STORE(f, PN_LOCALS, PN_TUPLE_AT(names, i));
+    if (v == pn) {
+      PN_ASM2(OP_GETLOCAL, reg, ctr);
+      if (kind == LOOP_EACH) {
+        PN_ASM2(OP_MOVE, reg + 2, reg);
+        PN_ASM2(OP_GETLOCAL, reg, from);
+        PN_ASM1(OP_SELF, reg + 1);
+        PN_ASM2(OP_GETTABLE, reg, reg + 2);
+      }
+      PN_ASM2(OP_SETLOCAL, reg, num);
+    } else if (PN_GET(c->sig, v) != PN_NONE || !potion_inline_sets(P, c->tree, v)) {
+      PN_ASM2(OP_LOADPN, reg, PN_NIL);
+      PN_ASM2(OP_SETLOCAL, reg, num);
+    }
+  });
+
+  P->inlining++;
+  potion_source_asmb(P, f, NULL, 0, (struct PNSource *)body, reg);
+  P->inlining--;
+  PN_ASM2(OP_GETLOCAL, reg, ctr);
+  if (kind == LOOP_TO || kind == LOOP_STEP)
+    PN_ASM2(OP_GETLOCAL, reg + 1, step);
+  else
+    PN_ASM2(OP_LOADPN, reg + 1, PN_NUM(1));
+  PN_ASM2(OP_ADD, reg, reg + 1);
+  PN_ASM2(OP_SETLOCAL, reg, ctr);
+  PN_ASM1(OP_JMP, top - (long)PN_OP_LEN(f->asmb) - 1);
+  PN_OP_AT(f->asmb, done).b = (PN_OP_LEN(f->asmb) - done) - 1;
+
+  // and answers what the method would have: the count for
+  // times and to, the steps taken for step, the tuple for each
+  PN_ASM2(OP_GETLOCAL, reg, kind == LOOP_EACH ? from : ctr);
+  if (kind == LOOP_TO || kind == LOOP_STEP) {
+    PN_ASM2(OP_GETLOCAL, reg + 1, from);
+    PN_ASM2(OP_SUB, reg, reg + 1);
+    PN_ASM2(OP_GETLOCAL, reg + 1, step);
+    PN_ASM2(kind == LOOP_TO ? OP_MULT : OP_DIV, reg, reg + 1);
+  }
+  PN_ASM1(OP_JMP, 0);
+  PN_OP_AT(f->asmb, jmp).b = (PN_OP_LEN(f->asmb) - jmp) - 1;
+  if (P->verbose) printf("; inlined %s loop\n", PN_STR_PTR(name));
+  return PN_OP_LEN(f->asmb) - 1;
+}
+
 void potion_source_asmb(Potion *P, vPN(Proto) f, struct PNLoop *loop, PN_SIZE count,
-                        vPN(Source) t, u8 reg) {
+                        vPN(Source) t, PN_SIZE reg) {
   PN_REG(f, reg);
 
   switch (t->part) {
@@ -254,7 +937,11 @@ void potion_source_asmb(Potion *P, vPN(Proto) f, struct PNLoop *loop, PN_SIZE co
 
     case AST_EXPR:
       if (t->a[0] != PN_NIL) {
+        int joined = 0;
         PN_TUPLE_EACH(t->a[0], i, v, {
+          if (i == 0 && PN_TUPLE_LEN(t->a[0]) > 1)
+            joined = potion_concat_asmb(P, f, loop, v, PN_TUPLE_AT(t->a[0], 1), reg);
+          if (i <= 1 && joined) continue;
           potion_source_asmb(P, f, loop, i, (struct PNSource *)v, reg);
         });
       }
@@ -269,11 +956,11 @@ void potion_source_asmb(Potion *P, vPN(Proto) f, struct PNLoop *loop, PN_SIZE co
       if (!PN_IS_PTR(t->a[0]) && t->a[0] == (PN)op.a) {
         PN_ASM2(OP_LOADPN, reg, t->a[0]);
       } else {
-        PN_SIZE num = PN_PUT(f->values, t->a[0]);
+        PN_SIZE num = PN_STORE(f, PN_VALUES, t->a[0]);
         PN_ASM2(OP_LOADK, reg, num);
       }
       if (t->a[1] != PN_NIL) {
-        u8 breg = reg;
+        PN_SIZE breg = reg;
         PN_ASM1(OP_SELF, ++breg);
         PN_ARG_TABLE(t->a[1], breg, 1);
         if (t->a[2] != PN_NIL) {
@@ -288,7 +975,8 @@ void potion_source_asmb(Potion *P, vPN(Proto) f, struct PNLoop *loop, PN_SIZE co
     case AST_ASSIGN: {
       vPN(Source) lhs = (struct PNSource *)t->a[0];
       PN_SIZE num = PN_NONE, c = count;
-      u8 opcode = OP_GETUPVAL, breg = reg;
+      u8 opcode = OP_GETUPVAL;
+      PN_SIZE breg = reg;
 
       if (lhs->part == AST_EXPR) {
         unsigned long i = 0;
@@ -303,17 +991,17 @@ void potion_source_asmb(Potion *P, vPN(Proto) f, struct PNLoop *loop, PN_SIZE co
         if (c == 0) {
           num = PN_UPVAL(lhs->a[0]);
           if (num == PN_NONE) {
-            num = PN_PUT(f->locals, lhs->a[0]);
+            num = PN_STORE(f, PN_LOCALS, lhs->a[0]);
             opcode = OP_GETLOCAL;
           }
         } else {
-          num = PN_PUT(f->values, lhs->a[0]);
+          num = PN_STORE(f, PN_VALUES, lhs->a[0]);
           PN_ASM2(OP_LOADK, ++breg, num);
           opcode = OP_DEF;
           num = ++breg;
         }
       } else if (lhs->part == AST_PATH || lhs->part == AST_PATHQ) {
-        num = PN_PUT(f->values, lhs->a[0]);
+        num = PN_STORE(f, PN_VALUES, lhs->a[0]);
         if (c == 0) {
           PN_PUT(f->paths, PN_NUM(num));
           PN_ASM1(OP_SELF, reg);
@@ -323,7 +1011,14 @@ void potion_source_asmb(Potion *P, vPN(Proto) f, struct PNLoop *loop, PN_SIZE co
         num = ++breg;
       }
 
-      if (lhs->a[1] != PN_NIL) {
+      if (lhs->a[1] != PN_NIL && (opcode == OP_GETLOCAL || opcode == OP_GETUPVAL) &&
+          potion_arg_single(lhs->a[1])) {
+        breg = reg;
+        PN_ASM2(opcode, reg, num);
+        PN_ARG_TABLE(lhs->a[1], breg, 1);
+        potion_source_asmb(P, f, loop, 0, (struct PNSource *)t->a[1], ++breg);
+        PN_ASM2(OP_PUTTABLE, reg, breg);
+      } else if (lhs->a[1] != PN_NIL) {
         breg = reg;
         PN_ASM2(opcode, ++breg, num);
         PN_ASM2(OP_CALLSET, reg, breg);
@@ -360,12 +1055,12 @@ void potion_source_asmb(Potion *P, vPN(Proto) f, struct PNLoop *loop, PN_SIZE co
     break;
 
     case AST_INC: {
-      u8 breg = reg;
+      PN_SIZE breg = reg;
       vPN(Source) lhs = (struct PNSource *)t->a[0];
       PN_SIZE num = PN_UPVAL(lhs->a[0]);
       u8 opcode = OP_SETUPVAL;
       if (num == PN_NONE) {
-        num = PN_PUT(f->locals, lhs->a[0]);
+        num = PN_STORE(f, PN_LOCALS, lhs->a[0]);
         opcode = OP_SETLOCAL;
       }
 
@@ -428,7 +1123,7 @@ void potion_source_asmb(Potion *P, vPN(Proto) f, struct PNLoop *loop, PN_SIZE co
     // TODO: this stuff is ugly and repetitive
     case AST_MESSAGE:
     case AST_QUERY: {
-      u8 breg = reg;
+      PN_SIZE breg = reg;
       int arg = (t->a[1] != PN_NIL);
       int call = (t->a[2] != PN_NIL || arg);
       if (t->part == AST_MESSAGE && t->a[0] == PN_if) {
@@ -453,7 +1148,7 @@ void potion_source_asmb(Potion *P, vPN(Proto) f, struct PNLoop *loop, PN_SIZE co
         potion_source_asmb(P, f, loop, 0, (struct PNSource *)t->a[2], reg);
         PN_OP_AT(f->asmb, jmp).b = (PN_OP_LEN(f->asmb) - jmp) - 1;
       } else if (t->part == AST_MESSAGE && t->a[0] == PN_class) {
-        u8 breg = reg;
+        PN_SIZE breg = reg;
         if (count == 0)
           PN_ASM1(OP_SELF, reg);
         if (t->a[2] != PN_NIL) {
@@ -510,15 +1205,15 @@ void potion_source_asmb(Potion *P, vPN(Proto) f, struct PNLoop *loop, PN_SIZE co
         if (count == 0 && t->part == AST_MESSAGE) {
           num = PN_UPVAL(t->a[0]);
           if (num == PN_NONE) {
-            num = PN_GET(f->locals, t->a[0]);
+            num = PN_FIND(f, PN_LOCALS, t->a[0]);
             opcode = OP_GETLOCAL;
           }
         }
 
         if (num == PN_NONE && t->a[0] != PN_NIL) {
-          u8 oreg = ++breg;
+          PN_SIZE oreg = ++breg;
           int jmp = 0;
-          num = PN_PUT(f->values, t->a[0]);
+          num = PN_STORE(f, PN_VALUES, t->a[0]);
           if (count == 0) {
             PN_ASM1(OP_SELF, oreg);
           } else {
@@ -537,7 +1232,10 @@ void potion_source_asmb(Potion *P, vPN(Proto) f, struct PNLoop *loop, PN_SIZE co
             PN_BLOCK(breg, t->a[2], t->a[1]);
           }
           if (t->part == AST_MESSAGE) {
+            int skip = potion_loop_asmb(P, f, t, reg, breg);
             PN_ASM2(OP_CALL, reg, breg);
+            if (skip >= 0)
+              PN_OP_AT(f->asmb, skip).a = (PN_OP_LEN(f->asmb) - skip) - 1;
           } else
             if (t->a[1] != PN_NIL) {
               PN_ASM2(OP_CALL, reg, breg);
@@ -549,13 +1247,22 @@ void potion_source_asmb(Potion *P, vPN(Proto) f, struct PNLoop *loop, PN_SIZE co
           if (num != PN_NONE)
             PN_ASM2(opcode, reg, num);
           if (call) {
+            int jmp;
+            PN args = potion_call_named(P, f, t->a[0], t->a[1]);
             PN_ASM1(OP_SELF, ++breg);
-            PN_ARG_TABLE(t->a[1], breg, 1);
+            PN_ARG_TABLE(args, breg, 1);
             if (t->a[2] != PN_NIL) {
               breg++;
               PN_BLOCK(breg, t->a[2], PN_NIL);
             }
-            PN_ASM2(OP_CALL, reg, breg);
+            jmp = (num != PN_NONE && P->optimize ? potion_inline_asmb(P, f, args == t->a[1] ? t :
+              (struct PNSource *)potion_source(P, t->part, t->a[0], args, t->a[2]), reg, breg) : -1);
+            if (jmp >= 0)
+              PN_ASM2(opcode, reg, num);
+            PN_ASM2(jmp < 0 && t->a[2] == PN_NIL && potion_arg_single(args) ?
+              OP_GETTABLE : OP_CALL, reg, breg);
+            if (jmp >= 0)
+              PN_OP_AT(f->asmb, jmp).a = (PN_OP_LEN(f->asmb) - jmp) - 1;
           }
         }
       }
@@ -565,7 +1272,7 @@ void potion_source_asmb(Potion *P, vPN(Proto) f, struct PNLoop *loop, PN_SIZE co
 
     case AST_PATH:
     case AST_PATHQ: {
-      PN_SIZE num = PN_PUT(f->values, t->a[0]);
+      PN_SIZE num = PN_STORE(f, PN_VALUES, t->a[0]);
       if (count == 0) {
         PN_PUT(f->paths, PN_NUM(num));
         PN_ASM1(OP_SELF, reg);
@@ -579,8 +1286,8 @@ void potion_source_asmb(Potion *P, vPN(Proto) f, struct PNLoop *loop, PN_SIZE co
     break;
 
     case AST_LICK: {
-      u8 breg = reg;
-      PN_SIZE num = PN_PUT(f->values, t->a[0]);
+      PN_SIZE breg = reg;
+      PN_SIZE num = PN_STORE(f, PN_VALUES, t->a[0]);
       PN_ASM2(OP_LOADK, reg, num);
       if (t->a[1] != PN_NIL)
         potion_source_asmb(P, f, loop, 0, (struct PNSource *)t->a[1], ++breg);
@@ -603,7 +1310,7 @@ void potion_source_asmb(Potion *P, vPN(Proto) f, struct PNLoop *loop, PN_SIZE co
             {
               lhs = (struct PNSource *)PN_TUPLE_AT(lhs->a[0], 0);
               if (lhs->part == AST_MESSAGE) {
-                PN_SIZE num = PN_PUT(f->values, lhs->a[0]);
+                PN_SIZE num = PN_STORE(f, PN_VALUES, lhs->a[0]);
                 PN_ASM2(OP_LOADK, reg + 1, num);
                 lhs = NULL;
               }
@@ -626,35 +1333,1265 @@ void potion_source_asmb(Potion *P, vPN(Proto) f, struct PNLoop *loop, PN_SIZE co
   }
 }
 
-PN potion_sig_compile(Potion *P, vPN(Proto) f, PN src) {
-  PN sig = PN_TUP0();
-  vPN(Source) t = (struct PNSource *)src;
-  if (t->part == AST_TABLE && t->a[0] != PN_NIL) {
-    PN_TUPLE_EACH(t->a[0], i, v, {
-      vPN(Source) expr = (struct PNSource *)v;
-      if (expr->part == AST_EXPR) {
-        vPN(Source) name = (struct PNSource *)PN_TUPLE_AT(expr->a[0], 0);
-        if (name->part == AST_MESSAGE)
-        {
-          PN_PUT(f->locals, name->a[0]);
-          sig = PN_PUSH(PN_PUSH(sig, name->a[0]), PN_NUM('o'));
+//
+// constant folding. before a tree is assembled, operators
+// with constant operands are worked out (just as the vm
+// would) and conditionals on constants lose their dead
+// branches, along with anything following a `return`,
+// `break` or `continue`.
+//
+static PN potion_source_fold(Potion *, PN);
+
+// `(x)` as an operand, which only groups
+static int potion_fold_parens(PN t) {
+  PN e;
+  if (!PN_IS_SOURCE(t) || PN_PART(t) != AST_EXPR || !PN_IS_PTR(PN_S(t, 0)) ||
+      !PN_IS_TUPLE(PN_S(t, 0)) || PN_TUPLE_LEN(PN_S(t, 0)) != 1)
+    return 0;
+  e = PN_TUPLE_AT(PN_S(t, 0), 0);
+  return (PN_IS_SOURCE(e) && PN_PART(e) == AST_TABLE);
+}
+
+// is `t` a constant (a number, a decimal, a boolean or nil)?
+// `parens` is set where `(x)` groups, rather than makes a tuple.
+static int potion_fold_const(Potion *P, PN t, int parens, PN *val) {
+  if (!PN_IS_SOURCE(t)) return 0;
+  if (parens && potion_fold_parens(t)) {
+    PN items = PN_S(PN_TUPLE_AT(PN_S(t, 0), 0), 0);
+    return (PN_IS_PTR(items) && PN_IS_TUPLE(items) && PN_TUPLE_LEN(items) == 1 &&
+      potion_fold_const(P, PN_TUPLE_AT(items, 0), 0, val));
+  }
+  switch (PN_PART(t)) {
+    case AST_VALUE:
+      if (PN_S(t, 1) != PN_NIL || PN_S(t, 2) != PN_NIL) return 0;
+      if (PN_IS_PTR(PN_S(t, 0)) && !PN_IS_DECIMAL(PN_S(t, 0))) return 0;
+      *val = PN_S(t, 0);
+      return 1;
+    case AST_EXPR: case AST_CODE:
+      return (PN_IS_PTR(PN_S(t, 0)) && PN_IS_TUPLE(PN_S(t, 0)) && PN_TUPLE_LEN(PN_S(t, 0)) == 1 &&
+        potion_fold_const(P, PN_TUPLE_AT(PN_S(t, 0), 0), 0, val));
+  }
+  return 0;
+}
+
+// `(x)` in an operand is just x, so it can stand in for
+// the operator once the operator is gone.
+static PN potion_fold_unparen(Potion *P, PN t) {
+  if (potion_fold_parens(t)) {
+    PN items = PN_S(PN_TUPLE_AT(PN_S(t, 0), 0), 0);
+    return (items == PN_NIL ? PN_AST(VALUE, PN_NIL) : PN_AST(CODE, items));
+  }
+  return t;
+}
+
+// decimals are only folded when they'll come back intact
+// from a compiled (.pnb) file.
+static PN potion_fold_real(Potion *P, double v) {
+  PN d = potion_real(P, v), str = potion_num_string(P, PN_NIL, d);
+  if (v != v || strtod(PN_STR_PTR(str), NULL) != v) return PN_NONE;
+  return d;
+}
+
+static PN potion_fold_math(Potion *P, u8 part, PN a, PN b) {
+  if (PN_IS_NUM(a) && PN_IS_NUM(b)) {
+    long x = PN_INT(a), y = PN_INT(b);
+    switch (part) {
+      case AST_PLUS:  return PN_NUM(x + y);
+      case AST_MINUS: return PN_NUM(x - y);
+      case AST_TIMES: return PN_NUM(x * y);
+      case AST_DIV:   return (y == 0 ? PN_NONE : PN_NUM(x / y));
+      case AST_REM:   return (y == 0 ? PN_NONE : PN_NUM(x % y));
+      case AST_POW:   return PN_NUM((int)pow((double)x, (double)y));
+      case AST_BITL:  return (y < 0 || y >= 64 ? PN_NONE : PN_NUM(x << y));
+      case AST_BITR:  return (y < 0 || y >= 64 ? PN_NONE : PN_NUM(x >> y));
+      case AST_CMP:   return PN_NUM(y - x);
+      case AST_EQ:    return PN_BOOL(x == y);
+      case AST_NEQ:   return PN_BOOL(x != y);
+      case AST_LT:    return PN_BOOL(x < y);
+      case AST_LTE:   return PN_BOOL(x <= y);
+      case AST_GT:    return PN_BOOL(x > y);
+      case AST_GTE:   return PN_BOOL(x >= y);
+    }
+  } else if ((PN_IS_NUM(a) || PN_IS_DECIMAL(a)) && (PN_IS_NUM(b) || PN_IS_DECIMAL(b))) {
+    double x = PN_DBL(a), y = PN_DBL(b);
+    switch (part) {
+      case AST_PLUS:  return potion_fold_real(P, x + y);
+      case AST_MINUS: return potion_fold_real(P, x - y);
+      case AST_TIMES: return potion_fold_real(P, x * y);
+      case AST_DIV:   return (y == 0.0 ? PN_NONE : potion_fold_real(P, x / y));
+    }
+  } else if (!PN_IS_PTR(a) && !PN_IS_PTR(b)) {
+    switch (part) {
+      case AST_EQ:    return PN_BOOL(a == b);
+      case AST_NEQ:   return PN_BOOL(a != b);
+    }
+  }
+  return PN_NONE;
+}
+
+// the test of a clause in an `if` chain, if it's known
+// before running (an `else` always passes.)
+static int potion_fold_test(Potion *P, PN msg, PN *test) {
+  PN args = PN_S(msg, 1);
+  *test = PN_TRUE;
+  if (PN_S(msg, 0) == PN_else) return 1;
+  *test = PN_NIL;
+  if (args == PN_NIL) return 1;
+  if (PN_PART(args) == AST_TABLE) {
+    PN cond = PN_S(args, 0);
+    return (PN_IS_PTR(cond) && PN_IS_TUPLE(cond) && PN_TUPLE_LEN(cond) == 1 &&
+      potion_fold_const(P, PN_TUPLE_AT(cond, 0), 0, test));
+  }
+  return potion_fold_const(P, args, 0, test);
+}
+
+// an `if`, `elsif`, `else` chain with constant tests keeps
+// only the branches that can still be taken.
+static PN potion_fold_if(Potion *P, PN t) {
+  PN items = PN_S(t, 0), kept = PN_NIL;
+  PN_SIZE i, len;
+  if (!PN_IS_PTR(items) || !PN_IS_TUPLE(items) || PN_TUPLE_LEN(items) < 1) return t;
+  len = PN_TUPLE_LEN(items);
+  for (i = 0; i < len; i++) {
+    PN v = PN_TUPLE_AT(items, i), name;
+    if (!PN_IS_SOURCE(v) || PN_PART(v) != AST_MESSAGE) return t;
+    name = PN_S(v, 0);
+    if ((i == 0) != (name == PN_if) || (name != PN_if && name != PN_elsif && name != PN_else))
+      return t;
+  }
+
+  for (i = 0; i < len; i++) {
+    PN v = PN_TUPLE_AT(items, i), test;
+    if (!potion_fold_test(P, v, &test)) {
+      if (kept == PN_NIL) {
+        if (PN_S(v, 0) != PN_if)
+          v = potion_source(P, AST_MESSAGE, PN_if, PN_S(v, 1), PN_S(v, 2));
+        kept = PN_TUP(v);
+      } else
+        kept = PN_PUSH(kept, v);
+    } else if (PN_TEST(test)) {
+      if (kept == PN_NIL)
+        return (PN_S(v, 2) == PN_NIL ? PN_AST(VALUE, PN_NIL) : PN_AST(CODE, PN_S(PN_S(v, 2), 0)));
+      kept = PN_PUSH(kept, potion_source(P, AST_MESSAGE, PN_else, PN_NIL, PN_S(v, 2)));
+      break;
+    }
+  }
+
+  if (kept == PN_NIL) return PN_AST(VALUE, PN_NIL);
+  PN_S(t, 0) = kept;
+  PN_TOUCH(t);
+  return t;
+}
+
+static int potion_fold_jumps(PN t) {
+  PN v;
+  if (!PN_IS_SOURCE(t) || PN_PART(t) != AST_EXPR || !PN_IS_PTR(PN_S(t, 0)) ||
+      PN_TUPLE_LEN(PN_S(t, 0)) != 1)
+    return 0;
+  v = PN_TUPLE_AT(PN_S(t, 0), 0);
+  return (PN_IS_SOURCE(v) && PN_PART(v) == AST_MESSAGE &&
+    (PN_S(v, 0) == PN_return || PN_S(v, 0) == PN_break || PN_S(v, 0) == PN_continue));
+}
+
+// which clause of an `if` chain a statement holds (and
+// nil if it's something else.)
+static PN potion_fold_clause(PN t) {
+  PN name = PN_NIL;
+  if (!PN_IS_SOURCE(t) || PN_PART(t) != AST_EXPR || !PN_IS_PTR(PN_S(t, 0)) ||
+      !PN_IS_TUPLE(PN_S(t, 0)) || PN_TUPLE_LEN(PN_S(t, 0)) < 1)
+    return PN_NIL;
+  PN_TUPLE_EACH(PN_S(t, 0), i, v, {
+    if (!PN_IS_SOURCE(v) || PN_PART(v) != AST_MESSAGE ||
+        (PN_S(v, 0) != PN_if && PN_S(v, 0) != PN_elsif && PN_S(v, 0) != PN_else))
+      return PN_NIL;
+    if (i == 0) name = PN_S(v, 0);
+  });
+  return name;
+}
+
+static PN potion_fold_each(Potion *P, PN tup, int stmts) {
+  PN live;
+  PN_SIZE i, n, len;
+  if (!PN_IS_PTR(tup) || !PN_IS_TUPLE(tup)) return tup;
+  len = PN_TUPLE_LEN(tup);
+  if (!stmts) {
+    for (i = 0; i < len; i++) {
+      PN v = PN_TUPLE_AT(tup, i), n = potion_source_fold(P, v);
+      if (n != v) {
+        PN_TUPLE_AT(tup, i) = n;
+        PN_TOUCH(tup);
+      }
+    }
+    return tup;
+  }
+
+  // an `elsif` or `else` on its own line continues the chain
+  // above it, so the whole chain is gathered up before folding.
+  // there can't be more statements than there were, so `live`
+  // is made that long and cut down after (like a pop.)
+  live = potion_tuple_with_size(P, len);
+  for (i = 0; i < len; i++) PN_TUPLE_AT(live, i) = PN_NIL;
+  for (i = 0, n = 0; i < len; i++) {
+    PN v = PN_TUPLE_AT(tup, i);
+    if (potion_fold_clause(v) == PN_if) {
+      PN next = (i + 1 < len ? potion_fold_clause(PN_TUPLE_AT(tup, i + 1)) : PN_NIL);
+      if (next == PN_elsif || next == PN_else) {
+        PN clauses = PN_TUP0();
+        PN_TUPLE_EACH(PN_S(v, 0), j, c, { clauses = PN_PUSH(clauses, c); });
+        while (next == PN_elsif || next == PN_else) {
+          PN_TUPLE_EACH(PN_S(PN_TUPLE_AT(tup, ++i), 0), j, c, { clauses = PN_PUSH(clauses, c); });
+          next = (i + 1 < len ? potion_fold_clause(PN_TUPLE_AT(tup, i + 1)) : PN_NIL);
         }
-      } else if (expr->part == AST_ASSIGN) {
-        vPN(Source) lhs = (struct PNSource *)expr->a[0];
-        if (lhs->part == AST_EXPR && PN_TUPLE_LEN(lhs->a[0]) == 1)
-        {
-          lhs = (struct PNSource *)PN_TUPLE_AT(lhs->a[0], 0);
-          if (lhs->part == AST_MESSAGE) {
-            PN_PUT(f->locals, lhs->a[0]);
-            sig = PN_PUSH(PN_PUSH(sig, lhs->a[0]), PN_NUM('o'));
+        v = PN_AST(EXPR, clauses);
+      }
+    }
+    v = potion_source_fold(P, v);
+    PN_TUPLE_AT(live, n++) = v;
+    PN_TOUCH(live);
+    if (potion_fold_jumps(v)) break;
+  }
+  PN_GET_TUPLE(live)->len = n;
+  return live;
+}
+
+static PN potion_source_fold(Potion *P, PN t) {
+  vPN(Source) s = (struct PNSource *)t;
+  PN a, b;
+  int i;
+  if (!PN_IS_SOURCE(t)) return t;
+
+  switch (s->part) {
+    case AST_PROTO: // folded when it's compiled
+    return t;
+
+    case AST_CODE: case AST_BLOCK:
+      s->a[0] = potion_fold_each(P, s->a[0], 1);
+      PN_TOUCH(s);
+    return t;
+
+    case AST_EXPR:
+      s->a[0] = potion_fold_each(P, s->a[0], 0);
+      PN_TOUCH(s);
+    return potion_fold_if(P, t);
+
+    case AST_CMP: case AST_EQ: case AST_NEQ:
+    case AST_GT: case AST_GTE: case AST_LT: case AST_LTE:
+    case AST_PLUS: case AST_MINUS: case AST_TIMES: case AST_DIV:
+    case AST_REM:  case AST_POW:   case AST_BITL:  case AST_BITR:
+      s->a[0] = potion_source_fold(P, s->a[0]);
+      s->a[1] = potion_source_fold(P, s->a[1]);
+      PN_TOUCH(s);
+      if (potion_fold_const(P, s->a[0], 1, &a) && potion_fold_const(P, s->a[1], 1, &b)) {
+        PN c = potion_fold_math(P, s->part, a, b);
+        if (c != PN_NONE) return PN_AST(VALUE, c);
+      }
+    return t;
+
+    case AST_NOT: case AST_WAVY:
+      s->a[0] = potion_source_fold(P, s->a[0]);
+      PN_TOUCH(s);
+      if (potion_fold_const(P, s->a[0], 1, &a)) {
+        if (s->part == AST_NOT) return PN_AST(VALUE, PN_BOOL(!PN_TEST(a)));
+        if (PN_IS_NUM(a)) return PN_AST(VALUE, PN_NUM(~PN_INT(a)));
+      }
+    return t;
+
+    case AST_AND: case AST_OR:
+      s->a[0] = potion_source_fold(P, s->a[0]);
+      s->a[1] = potion_source_fold(P, s->a[1]);
+      PN_TOUCH(s);
+      if (potion_fold_const(P, s->a[0], 1, &a)) {
+        if (PN_TEST(a) == (s->part == AST_AND))
+          return potion_fold_unparen(P, s->a[1]);
+        return PN_AST(VALUE, a);
+      }
+    return t;
+  }
+
+  for (i = 0; i < 3; i++) {
+    if (PN_IS_SOURCE(s->a[i]))
+      s->a[i] = potion_source_fold(P, s->a[i]);
+    else if (PN_IS_PTR(s->a[i]) && PN_IS_TUPLE(s->a[i]))
+      s->a[i] = potion_fold_each(P, s->a[i], 0);
+  }
+  PN_TOUCH(s);
+  return t;
+}
+
+//
+// the peephole pass. once a function is assembled, jumps
+// to jumps are threaded through, loads into a register
+// that's written again before it's read are dropped (or
+// made straight into the register they're moved to) and
+// a TEST of something that's already a boolean goes.
+// what's left is packed together and jumps fixed up.
+//
+#define PEEP_PASSES 8
+#define PEEP_JUMP(op) ((op).code == OP_JMP || (op).code == OP_TESTJMP || (op).code == OP_NOTJMP)
+#define PEEP_OFF(op)  ((op).code == OP_JMP ? (op).a : (op).b)
+#define PEEP_FITS(n)  PN_OP_A_FITS(n)
+
+// does `op` read register `r`?
+static int potion_peep_reads(PN_OP op, int r) {
+  switch (op.code) {
+    case OP_LOADK: case OP_LOADPN: case OP_SELF: case OP_NEWTUPLE:
+    case OP_GETLOCAL: case OP_GETUPVAL: case OP_JMP:
+    return 0;
+    case OP_MOVE: case OP_BITN: case OP_CALLSET:
+    return r == op.b;
+    case OP_SETLOCAL: case OP_SETUPVAL: case OP_TEST: case OP_NOT:
+    case OP_TESTJMP: case OP_NOTJMP: case OP_GUARD:
+    return r == op.a;
+  }
+  return r == op.a || r == op.a + 1 || r == op.b || (r > op.a && r <= op.b + 1);
+}
+
+// is register `r` written over before anything reads it,
+// going on from `pos`? (anything that leaves the straight
+// line, calls out or sets up a closure ends the search.)
+static int potion_peep_dead(PN_OP *ops, u8 *gone, PN_SIZE len, PN_SIZE pos, int r) {
+  PN_SIZE i;
+  for (i = pos + 1; i < len; i++) {
+    PN_OP op = ops[i];
+    if (gone[i]) continue;
+    switch (op.code) {
+      case OP_JMP: case OP_TESTJMP: case OP_NOTJMP: case OP_CALL:
+      case OP_NAMED: case OP_RETURN: case OP_PROTO: case OP_CLASS:
+      case OP_TAILCALL: case OP_GETTABLE: case OP_PUTTABLE: case OP_CONCAT:
+      return 0;
+    }
+    if (potion_peep_reads(op, r)) return 0;
+    if (op.a == r && op.code != OP_SETLOCAL && op.code != OP_SETUPVAL &&
+        op.code != OP_SETTABLE && op.code != OP_SETPATH)
+      return 1;
+  }
+  return 0;
+}
+
+static int potion_peep_pass(Potion *P, vPN(Proto) f) {
+  PN_OP *ops = (PN_OP *)((PNFlex *)f->asmb)->ptr;
+  PN_SIZE i, len = PN_OP_LEN(f->asmb), n = 0;
+  u8 *gone = calloc(len + 1, 3), *upv = gone + len + 1, *tgt = upv + len + 1;
+  PN_SIZE *to = malloc(sizeof(PN_SIZE) * (len + 1));
+  int changed = 0;
+
+  // the ops after a PROTO carry its upvals, they aren't run
+  for (i = 0; i < len; i++) {
+    if (ops[i].code == OP_PROTO) {
+      PN_SIZE j, c = PN_TUPLE_LEN(PN_PROTO(PN_TUPLE_AT(f->protos, ops[i].b))->upvals);
+      for (j = 1; j <= c && i + j < len; j++) upv[i + j] = 1;
+      i += c;
+    } else if (PEEP_JUMP(ops[i]) && i + PEEP_OFF(ops[i]) + 1 <= len)
+      tgt[i + PEEP_OFF(ops[i]) + 1] = 1;
+  }
+
+  for (i = 0; i < len; i++) {
+    PN_OP op = ops[i];
+    if (upv[i]) continue;
+    if (PEEP_JUMP(op) && PEEP_OFF(op) >= 0) {
+      PN_SIZE t = i + PEEP_OFF(op) + 1;
+      int hops;
+      for (hops = 0; hops < PEEP_PASSES && t < len && !upv[t]; hops++) {
+        PN_OP op2 = ops[t];
+        PN_SIZE t2;
+        if (op2.code == OP_JMP)
+          t2 = t + op2.a + 1;
+        else if (op.code != OP_JMP && op2.code == op.code && op2.a == op.a)
+          t2 = t + op2.b + 1;
+        else if (op.code != OP_JMP && PEEP_JUMP(op2) && op2.code != OP_JMP && op2.a == op.a)
+          t2 = t + 1;
+        else
+          break;
+        if (t2 <= i || t2 > len || !PEEP_FITS((long)t2 - (long)i - 1)) break;
+        t = t2;
+      }
+      if (t != i + PEEP_OFF(op) + 1) {
+        if (op.code == OP_JMP) ops[i].a = t - i - 1;
+        else ops[i].b = t - i - 1;
+        tgt[t] = 1;
+        changed = 1;
+      }
+      if (t == i + 1) gone[i] = 1;
+    } else if (op.code == OP_MOVE && op.a == op.b) {
+      gone[i] = 1;
+    } else if (op.code == OP_TEST && i > 0 && !tgt[i] && !gone[i - 1] && !upv[i - 1] &&
+               ops[i - 1].a == op.a &&
+               ((ops[i - 1].code >= OP_NOT && ops[i - 1].code <= OP_GTE && ops[i - 1].code != OP_CMP) ||
+                ops[i - 1].code == OP_TEST)) {
+      gone[i] = 1;
+    } else if (op.code == OP_MOVE || op.code == OP_LOADK || op.code == OP_LOADPN ||
+               op.code == OP_SELF || op.code == OP_GETLOCAL || op.code == OP_GETUPVAL ||
+               op.code == OP_NEWTUPLE) {
+      if (potion_peep_dead(ops, gone, len, i, op.a))
+        gone[i] = 1;
+      else if (i + 1 < len && ops[i + 1].code == OP_MOVE && ops[i + 1].b == op.a &&
+               ops[i + 1].a != op.a && !tgt[i + 1] && !upv[i + 1] &&
+               potion_peep_dead(ops, gone, len, i + 1, op.a)) {
+        ops[i].a = ops[i + 1].a;
+        gone[++i] = 1;
+      }
+    }
+  }
+
+  // pack the ops left and point the jumps at their new homes
+  for (i = 0; i <= len; i++) {
+    to[i] = n;
+    if (i < len && !gone[i]) n++;
+  }
+  for (i = 0; i < len; i++) {
+    PN_OP op = ops[i];
+    if (gone[i]) continue;
+    if (PEEP_JUMP(op) && !upv[i]) {
+      long off = (long)to[i + PEEP_OFF(op) + 1] - (long)to[i] - 1;
+      if (op.code == OP_JMP) op.a = off;
+      else op.b = off;
+    }
+    ops[to[i]] = op;
+  }
+  if (n < len) {
+    PN_FLEX_SIZE(f->asmb) = n * sizeof(PN_OP);
+    changed = 1;
+  }
+  free(gone);
+  free(to);
+  return changed;
+}
+
+static void potion_peephole(Potion *P, vPN(Proto) f) {
+  int i;
+  for (i = 0; i < PEEP_PASSES && potion_peep_pass(P, f); i++);
+}
+
+//
+// register allocation. registers are handed out by how
+// deeply an expression nests, so a frame is as big as its
+// deepest expression even though few registers hold
+// anything at once. here each value's live range (its web:
+// the writes and reads which reach each other) is worked
+// out and the webs are packed into as few registers as
+// will hold them. the operands of a CALL (and SETTABLE,
+// DEF and the like) have to sit side by side, so webs
+// meeting there are placed as a group.
+//
+#define REGS_MAX_WORK (1 << 20)
+
+#define REG_AT(v, i, r)      (v)[(i) * n + (r)]
+#define REG_NODE(i, r, side) ((((i) * n) + (r)) * 2 + (side))
+#define REG_LIVE(i, r, side) ((side) ? (REG_AT(out, i, r) || REG_AT(wr, i, r)) : REG_AT(in, i, r))
+
+// marks the registers `op` reads and writes, which must
+// all be below `n`. ops the allocator doesn't know return 0.
+static int potion_regs_of(PN_OP op, u8 *rd, u8 *wr, int n) {
+  int i, hi = op.b > op.a ? op.b : op.a;
+  switch (op.code) {
+    case OP_JMP:
+    return 1;
+    case OP_MOVE: case OP_CALLSET:
+      if (op.a < 0 || op.b < 0 || hi >= n) return 0;
+      rd[op.b] = wr[op.a] = 1;
+    return 1;
+    case OP_LOADK: case OP_LOADPN: case OP_SELF: case OP_GETLOCAL:
+    case OP_GETUPVAL: case OP_NEWTUPLE: case OP_PROTO:
+      if (op.a < 0 || op.a >= n) return 0;
+      wr[op.a] = 1;
+    return 1;
+    case OP_SETLOCAL: case OP_SETUPVAL: case OP_TESTJMP: case OP_NOTJMP:
+    case OP_RETURN:
+      if (op.a < 0 || op.a >= n) return 0;
+      rd[op.a] = 1;
+    return 1;
+    case OP_NOT: case OP_TEST: case OP_GUARD:
+      if (op.a < 0 || op.a >= n) return 0;
+      rd[op.a] = wr[op.a] = 1;
+    return 1;
+    case OP_SETTUPLE: case OP_GETPATH: case OP_ADD: case OP_SUB:
+    case OP_MULT: case OP_DIV: case OP_REM: case OP_POW: case OP_CMP:
+    case OP_EQ: case OP_NEQ: case OP_LT: case OP_LTE: case OP_GT:
+    case OP_GTE: case OP_BITN: case OP_BITL: case OP_BITR: case OP_BIND:
+    case OP_MESSAGE: case OP_CLASS:
+      if (op.a < 0 || op.b < 0 || hi >= n) return 0;
+      rd[op.a] = rd[op.b] = wr[op.a] = 1;
+    return 1;
+    case OP_SETTABLE: case OP_SETPATH: case OP_DEF: case OP_PUTTABLE:
+      if (op.a < 0 || op.b < 0 || hi >= n || op.a + 1 >= n) return 0;
+      rd[op.a] = rd[op.a + 1] = rd[op.b] = 1;
+      if (op.code == OP_DEF || op.code == OP_PUTTABLE) wr[op.a] = 1;
+    return 1;
+    case OP_NEWLICK:
+      if (op.a < 0 || op.b < op.a || op.b >= n) return 0;
+      rd[op.a] = wr[op.a] = 1;
+      if (op.b > op.a) rd[op.a + 1] = 1;
+      if (op.b > op.a + 1) rd[op.b] = 1;
+    return 1;
+    case OP_CALL: case OP_GETTABLE:
+      if (op.a < 0 || op.b <= op.a || op.b >= n) return 0;
+      for (i = op.a; i <= op.b; i++) rd[i] = 1;
+      wr[op.a] = wr[op.a + 1] = 1;
+    return 1;
+    case OP_CONCAT:
+      if (op.a < 0 || op.b < op.a || op.b >= n) return 0;
+      for (i = op.a; i <= op.b; i++) rd[i] = 1;
+      wr[op.a] = 1;
+    return 1;
+  }
+  return 0;
+}
+
+// where control goes after op `i` (up to two places)
+static int potion_regs_next(PN_OP op, PN_SIZE i, PN_SIZE *s) {
+  int ns = 0;
+  if (op.code == OP_JMP) s[ns++] = i + op.a + 1;
+  else if (op.code != OP_RETURN) {
+    s[ns++] = i + 1;
+    if (op.code == OP_TESTJMP || op.code == OP_NOTJMP) s[ns++] = i + op.b + 1;
+  }
+  return ns;
+}
+
+// fills in what each op reads and writes and which
+// registers are live going in and coming out of it, in
+// the four len * n arrays starting at `rd`, followed by
+// a mark on each op which only carries a PROTO's upvals.
+// 0 if there's an op the allocator doesn't know.
+static int potion_regs_live(vPN(Proto) f, PN_OP *ops, PN_SIZE len, int n, u8 *rd) {
+  u8 *wr = rd + len * n, *in = wr + len * n, *out = in + len * n, *upv = out + len * n;
+  PN_SIZE i, j;
+  int r, changed = 1;
+
+  // the ops after a PROTO carry its upvals, they aren't run
+  for (i = 0; i < len; i++) {
+    if (upv[i]) continue;
+    if (!potion_regs_of(ops[i], &REG_AT(rd, i, 0), &REG_AT(wr, i, 0), n))
+      return 0;
+    if (ops[i].code == OP_PROTO) {
+      PN_SIZE c = PN_TUPLE_LEN(PN_PROTO(PN_TUPLE_AT(f->protos, ops[i].b))->upvals);
+      for (j = 1; j <= c && i + j < len; j++) upv[i + j] = 1;
+    }
+  }
+
+  // liveness, back to front until nothing moves
+  while (changed) {
+    changed = 0;
+    i = len;
+    while (i-- > 0) {
+      PN_SIZE s[2];
+      int ns = potion_regs_next(ops[i], i, s), x;
+      if (upv[i]) ns = 1, s[0] = i + 1;
+      for (x = 0; x < ns; x++)
+        if (s[x] < len)
+          for (r = 0; r < n; r++)
+            if (REG_AT(in, s[x], r)) REG_AT(out, i, r) = 1;
+      for (r = 0; r < n; r++) {
+        u8 v = REG_AT(rd, i, r) || (REG_AT(out, i, r) && !REG_AT(wr, i, r));
+        if (v != REG_AT(in, i, r)) { REG_AT(in, i, r) = v; changed = 1; }
+      }
+    }
+  }
+  return 1;
+}
+
+static int potion_regs_find(int *set, int x) {
+  while (set[x] != x) x = set[x] = set[set[x]];
+  return x;
+}
+
+// the group a web belongs to, and where in it
+static int potion_regs_group(int *grp, int *off, int x, int *o) {
+  *o = 0;
+  while (grp[x] != x) { *o += off[x]; x = grp[x]; }
+  return x;
+}
+
+// webs in a group keep their distance: reg(y) - reg(x) == k
+static int potion_regs_tie(int *grp, int *off, int x, int y, int k) {
+  int ox, oy;
+  x = potion_regs_group(grp, off, x, &ox);
+  y = potion_regs_group(grp, off, y, &oy);
+  if (x == y) return oy - ox == k;
+  grp[y] = x;
+  off[y] = ox + k - oy;
+  return 1;
+}
+
+static void potion_regalloc(Potion *P, vPN(Proto) f) {
+  PN_OP *ops = (PN_OP *)((PNFlex *)f->asmb)->ptr;
+  PN_SIZE len = PN_OP_LEN(f->asmb), i, j, k, nodes;
+  int n = PN_INT(f->stack), r, webs = 0, top = 0;
+  u8 *rd, *wr, *in, *out, *upv, *occ = NULL;
+  int *set = NULL, *web = NULL, *grp = NULL, *off = NULL, *reg = NULL;
+  int *start = NULL, *pts = NULL, *held = NULL, *gof, *gnext;
+
+  if (n < 2 || len * n > REGS_MAX_WORK) return;
+  nodes = len * n * 2;
+  rd = calloc(len * n * 4 + len, 1);
+  wr = rd + len * n; in = wr + len * n; out = in + len * n;
+  upv = out + len * n;
+  if (!potion_regs_live(f, ops, len, n, rd)) goto done;
+
+  // webs: a value carried along an edge, past an op or
+  // read and written back by the same op is one web
+  set = malloc(sizeof(int) * nodes);
+  for (k = 0; k < nodes; k++) set[k] = k;
+  for (i = 0; i < len; i++) {
+    PN_SIZE s[2];
+    int ns = potion_regs_next(ops[i], i, s), x;
+    if (upv[i]) ns = 1, s[0] = i + 1;
+    for (r = 0; r < n; r++)
+      if ((REG_AT(in, i, r) && REG_AT(out, i, r) && !REG_AT(wr, i, r)) ||
+          (REG_AT(rd, i, r) && REG_AT(wr, i, r)))
+        set[potion_regs_find(set, REG_NODE(i, r, 1))] = potion_regs_find(set, REG_NODE(i, r, 0));
+    for (x = 0; x < ns; x++)
+      if (s[x] < len)
+        for (r = 0; r < n; r++)
+          if (REG_AT(in, s[x], r))
+            set[potion_regs_find(set, REG_NODE(s[x], r, 0))] = potion_regs_find(set, REG_NODE(i, r, 1));
+  }
+
+  // number the webs in the order they start and gather
+  // up the points (either side of an op) they cover
+  web = malloc(sizeof(int) * nodes);
+  for (k = 0; k < nodes; k++) web[k] = -1;
+  for (k = 0; k < nodes; k++) {
+    int root;
+    i = k / (n * 2); r = (k / 2) % n;
+    if (!REG_LIVE(i, r, k & 1)) continue;
+    root = potion_regs_find(set, k);
+    if (web[root] == -1) web[root] = webs++;
+  }
+  start = calloc(webs + 1, sizeof(int));
+  for (k = 0; k < nodes; k++) {
+    i = k / (n * 2); r = (k / 2) % n;
+    if (REG_LIVE(i, r, k & 1)) start[web[potion_regs_find(set, k)] + 1]++;
+  }
+  for (r = 0; r < webs; r++) start[r + 1] += start[r];
+  pts = malloc(sizeof(int) * (start[webs] + 1));
+  held = calloc(webs + 1, sizeof(int));
+  for (k = 0; k < nodes; k++) {
+    int w;
+    i = k / (n * 2); r = (k / 2) % n;
+    if (!REG_LIVE(i, r, k & 1)) continue;
+    w = web[potion_regs_find(set, k)];
+    pts[start[w] + held[w]++] = k / (n * 2) * 2 + (k & 1);
+  }
+
+  // operands which have to stay side by side
+  grp = malloc(sizeof(int) * webs);
+  off = calloc(webs, sizeof(int));
+  for (r = 0; r < webs; r++) grp[r] = r;
+  for (i = 0; i < len; i++) {
+    PN_OP op = ops[i];
+    int hi = op.a;
+    if (upv[i]) continue;
+    if (op.code == OP_SETTABLE || op.code == OP_SETPATH || op.code == OP_DEF ||
+        op.code == OP_PUTTABLE) hi = op.a + 1;
+    else if (op.code == OP_CALL || op.code == OP_GETTABLE || op.code == OP_NEWLICK ||
+             op.code == OP_CONCAT) hi = op.b;
+    for (r = op.a + 1; r <= hi; r++)
+      if (REG_AT(rd, i, r) &&
+          !potion_regs_tie(grp, off, web[potion_regs_find(set, REG_NODE(i, op.a, 0))],
+            web[potion_regs_find(set, REG_NODE(i, r, 0))], r - op.a))
+        goto done;
+  }
+
+  // each group, in the order they start, goes to the lowest
+  // registers that are free at every point its webs cover.
+  // a group's webs are chained in order, from its first.
+  reg = malloc(sizeof(int) * webs * 3);
+  gof = reg + webs; gnext = gof + webs;
+  for (r = 0; r < webs; r++) reg[r] = -1;
+  for (r = webs - 1; r >= 0; r--) {
+    int g = potion_regs_group(grp, off, r, &gof[r]);
+    gnext[r] = reg[g];
+    reg[g] = r;
+  }
+  for (r = 0; r < webs; r++) reg[r] = -1;
+  occ = calloc(len * 2 * n, 1);
+  for (r = 0; r < webs; r++) {
+    int lo = 0, hi = 0, base, w, placed = 0;
+    if (reg[r] != -1) continue;
+    for (w = r; w != -1; w = gnext[w]) {
+      if (gof[w] < lo) lo = gof[w];
+      if (gof[w] > hi) hi = gof[w];
+    }
+    for (base = -lo; base + hi < n && !placed; base++) {
+      int bad = 0, last = r;
+      for (w = r; w != -1 && !bad; w = gnext[w]) {
+        for (j = start[w]; j < start[w + 1]; j++)
+          if (occ[pts[j] * n + base + gof[w]]) { bad = 1; break; }
+          else occ[pts[j] * n + base + gof[w]] = 1;
+        if (bad) {
+          // undo this web's marks up to the clash, and the webs before it
+          while (j-- > start[w]) occ[pts[j] * n + base + gof[w]] = 0;
+        }
+        last = w;
+      }
+      if (bad) {
+        for (w = r; w != last; w = gnext[w])
+          for (j = start[w]; j < start[w + 1]; j++) occ[pts[j] * n + base + gof[w]] = 0;
+        continue;
+      }
+      for (w = r; w != -1; w = gnext[w]) {
+        reg[w] = base + gof[w];
+        if (reg[w] >= top) top = reg[w] + 1;
+      }
+      placed = 1;
+    }
+    if (!placed) goto done;
+  }
+
+  // anything read before it's written (self, in register 0)
+  // is whatever the frame starts with, so it can't move
+  for (r = 0; r < n; r++)
+    if (REG_AT(in, 0, r) && reg[web[potion_regs_find(set, REG_NODE(0, r, 0))]] != r)
+      goto done;
+
+  // everything fits, so rename
+  for (i = 0; i < len; i++) {
+    PN_OP *op = &ops[i];
+    int a = op->a;
+    if (upv[i] || op->code == OP_JMP) continue;
+    if (op->code == OP_PROTO) {
+      op->a = reg[web[potion_regs_find(set, REG_NODE(i, a, 1))]];
+      for (j = i + 1; j < len && upv[j]; j++) ops[j].a = op->a;
+      continue;
+    }
+    op->a = reg[web[potion_regs_find(set, REG_NODE(i, a, !REG_AT(rd, i, a)))]];
+    switch (op->code) {
+      case OP_MOVE: case OP_CALLSET: case OP_SETTUPLE: case OP_GETPATH:
+      case OP_ADD: case OP_SUB: case OP_MULT: case OP_DIV: case OP_REM:
+      case OP_POW: case OP_CMP: case OP_EQ: case OP_NEQ: case OP_LT:
+      case OP_LTE: case OP_GT: case OP_GTE: case OP_BITN: case OP_BITL:
+      case OP_BITR: case OP_BIND: case OP_MESSAGE: case OP_CLASS:
+      case OP_SETTABLE: case OP_SETPATH: case OP_DEF: case OP_PUTTABLE:
+        op->b = reg[web[potion_regs_find(set, REG_NODE(i, op->b, 0))]];
+      break;
+      case OP_CALL: case OP_GETTABLE: case OP_NEWLICK: case OP_CONCAT:
+        op->b = op->a + (op->b - a);
+      break;
+    }
+  }
+  if (top < 1) top = 1;
+  f->stack = PN_NUM(top);
+
+done:
+  free(rd); free(set); free(web); free(start); free(pts); free(held);
+  free(grp); free(off); free(reg); free(occ);
+}
+
+//
+// redundant loads. a value that's loaded again while it's
+// still sitting in a register (a constant, a local, a path
+// off the same object) is taken from that register, and
+// loads that can't change inside a loop are moved out in
+// front of it, into registers of their own. whatever ends
+// up never read is dropped. anything which may send a
+// message (and so run code which changes an upval or an
+// object) forgets what it knew about upvals and paths. only
+// the latest CSE_KEYS loads are remembered, so a long run of
+// straight-line code doesn't make every op search them all.
+//
+#define CSE_PASSES 4
+#define CSE_KEYS   256
+#define CSE_LOAD(op) ((op).code == OP_LOADK || (op).code == OP_LOADPN || \
+  (op).code == OP_SELF || (op).code == OP_GETLOCAL || (op).code == OP_GETUPVAL)
+
+struct PNCseKey {
+  u8 code;
+  int x, y, v;
+};
+
+// ops which never call out to anything the script wrote
+static int potion_cse_pure(PN_OP op) {
+  switch (op.code) {
+    case OP_MOVE: case OP_LOADK: case OP_LOADPN: case OP_SELF:
+    case OP_NEWTUPLE: case OP_SETTUPLE: case OP_GETLOCAL: case OP_SETLOCAL:
+    case OP_GETUPVAL: case OP_SETUPVAL: case OP_GETPATH: case OP_POW:
+    case OP_NOT: case OP_CMP: case OP_EQ: case OP_NEQ: case OP_LT:
+    case OP_LTE: case OP_GT: case OP_GTE: case OP_JMP: case OP_TEST:
+    case OP_TESTJMP: case OP_NOTJMP: case OP_RETURN: case OP_GUARD:
+    return 1;
+  }
+  return 0;
+}
+
+// marks the ops after a PROTO, and the locals they capture
+static void potion_cse_upvals(vPN(Proto) f, PN_OP *ops, PN_SIZE len, u8 *upv, u8 *caught) {
+  PN_SIZE i, j;
+  for (i = 0; i < len; i++)
+    if (ops[i].code == OP_PROTO) {
+      PN_SIZE c = PN_TUPLE_LEN(PN_PROTO(PN_TUPLE_AT(f->protos, ops[i].b))->upvals);
+      for (j = 1; j <= c && i + j < len; j++) {
+        upv[i + j] = 1;
+        if (ops[i + j].code == OP_GETLOCAL && caught != NULL) caught[ops[i + j].b] = 1;
+      }
+      i += c;
+    }
+}
+
+// moves loads which stay the same all through a loop out
+// in front of it. a loop is everything from a backward
+// jump's target up to the last jump back there, so long as
+// nothing from outside jumps into the middle of it.
+static int potion_cse_hoist(Potion *P, vPN(Proto) f) {
+  PN_OP *ops = (PN_OP *)((PNFlex *)f->asmb)->ptr;
+  PN_SIZE len = PN_OP_LEN(f->asmb), i, h, e, n2 = 0;
+  int n = PN_INT(f->stack), regs = n, fits = 1;
+  int nl = PN_TUPLE_LEN(f->locals), nu = PN_TUPLE_LEN(f->upvals);
+  u8 *upv = calloc(len + len + nl + nl + nu + 1, 1), *head = upv + len, *caught = head + len,
+     *setl = caught + nl, *setu = setl + nl;
+  PN_SIZE *end = calloc(len + 1, sizeof(PN_SIZE)), *to = malloc(sizeof(PN_SIZE) * (len + 1));
+  PN_SIZE *pre = calloc(len + 1, sizeof(PN_SIZE));
+  int *hoist = malloc(sizeof(int) * (len + 1));
+  PN_OP *adds = malloc(sizeof(PN_OP) * (len + 1));
+  PN_SIZE nadds = 0;
+
+  potion_cse_upvals(f, ops, len, upv, caught);
+  for (i = 0; i < len; i++) {
+    hoist[i] = -1;
+    if (!upv[i] && ops[i].code == OP_JMP && ops[i].a < 0 && (long)i + ops[i].a + 1 >= 0) {
+      head[i + ops[i].a + 1] = 1;
+      end[i + ops[i].a + 1] = i;
+    }
+  }
+
+  for (h = 0; h < len; h++) {
+    int impure = 0, open = 1;
+    PN_SIZE first = nadds;
+    if (!head[h]) continue;
+    e = end[h];
+
+    // only way in is through the top
+    for (i = 0; i < len && open; i++) {
+      long t;
+      if (upv[i] || !PEEP_JUMP(ops[i]) || (i >= h && i <= e)) continue;
+      t = (long)i + PEEP_OFF(ops[i]) + 1;
+      if (t > (long)h && t <= (long)e) open = 0;
+    }
+    if (!open) continue;
+
+    memset(setl, 0, nl + nu);
+    for (i = h; i <= e; i++) {
+      if (upv[i]) continue;
+      if (!potion_cse_pure(ops[i]) || ops[i].code == OP_PROTO) impure = 1;
+      if (ops[i].code == OP_SETLOCAL && ops[i].b < nl) setl[ops[i].b] = 1;
+      if (ops[i].code == OP_SETUPVAL && ops[i].b < nu) setu[ops[i].b] = 1;
+    }
+
+    for (i = h; i <= e; i++) {
+      PN_OP op = ops[i];
+      PN_SIZE k;
+      if (upv[i] || hoist[i] >= 0 || !CSE_LOAD(op)) continue;
+      if (op.code == OP_GETLOCAL &&
+          (op.b >= nl || setl[op.b] || (caught[op.b] && impure))) continue;
+      if (op.code == OP_GETUPVAL && (op.b >= nu || setu[op.b] || impure)) continue;
+      if (op.code == OP_SELF) op.b = 0;
+      for (k = first; k < nadds; k++)
+        if (adds[k].code == op.code && adds[k].b == op.b) break;
+      if (k == nadds) {
+        if (!PN_OP_A_FITS(regs + 1)) continue;
+        adds[nadds].code = op.code;
+        adds[nadds].a = regs++;
+        adds[nadds++].b = op.b;
+      }
+      hoist[i] = adds[k].a;
+    }
+    pre[h] = nadds - first;
+  }
+
+  if (nadds == 0) goto done;
+
+  // lay out the new ops and check every jump still fits
+  for (i = 0, n2 = 0; i <= len; i++) {
+    n2 += pre[i];
+    to[i] = n2;
+    if (i < len) n2++;
+  }
+  for (i = 0; i < len && fits; i++) {
+    if (!upv[i] && PEEP_JUMP(ops[i])) {
+      PN_SIZE t = i + PEEP_OFF(ops[i]) + 1;
+      long at = (long)to[t] - ((pre[t] && (i < t || i > end[t])) ? (long)pre[t] : 0);
+      if (!PEEP_FITS(at - (long)to[i] - 1)) fits = 0;
+    }
+  }
+
+  if (fits) {
+    PNAsm *asmb = potion_asm_new(P);
+    PN_SIZE k = 0;
+    for (i = 0; i < len; i++) {
+      PN_OP op = ops[i];
+      PN_SIZE c;
+      for (c = 0; c < pre[i]; c++, k++)
+        asmb = potion_asm_op(P, asmb, adds[k].code, adds[k].a, adds[k].b);
+      if (hoist[i] >= 0) {
+        op.code = OP_MOVE;
+        op.b = hoist[i];
+      } else if (!upv[i] && PEEP_JUMP(op)) {
+        PN_SIZE t = i + PEEP_OFF(op) + 1;
+        long at = (long)to[t] - ((pre[t] && (i < t || i > end[t])) ? (long)pre[t] : 0);
+        if (op.code == OP_JMP) op.a = at - (long)to[i] - 1;
+        else op.b = at - (long)to[i] - 1;
+      }
+      asmb = potion_asm_op(P, asmb, op.code, op.a, op.b);
+    }
+    f->asmb = (PN)asmb;
+    f->stack = PN_NUM(regs);
+    PN_TOUCH(f);
+  }
+
+done:
+  free(upv); free(end); free(to); free(pre); free(hoist); free(adds);
+  return nadds > 0 && fits;
+}
+
+// the register holding value `v` longest (or `r` itself)
+static int potion_cse_holder(int *vn, int *since, int n, int v, int r) {
+  int x, best = -1;
+  for (x = 0; x < n; x++)
+    if (vn[x] == v && (best < 0 || since[x] < since[best])) best = x;
+  return best < 0 ? r : best;
+}
+
+static int potion_cse_find(struct PNCseKey *keys, int nk, u8 code, int x, int y) {
+  int k;
+  for (k = 0; k < nk; k++)
+    if (keys[k].code == code && keys[k].x == x && keys[k].y == y) return k;
+  return -1;
+}
+
+// numbers the values in each register down every straight
+// run of ops. a load of something already in a register
+// turns into a move from it, and any operand which is only
+// read is taken from the register that's held its value
+// longest, which leaves the later loads with nobody to read
+// them.
+static int potion_cse_number(Potion *P, vPN(Proto) f) {
+  PN_OP *ops = (PN_OP *)((PNFlex *)f->asmb)->ptr;
+  PN_SIZE len = PN_OP_LEN(f->asmb), i;
+  int n = PN_INT(f->stack), nl = PN_TUPLE_LEN(f->locals), nk = 0, nv = 0, r, changed = 0;
+  u8 *upv = calloc(len + len + nl + 1, 1), *lead = upv + len, *caught = lead + len;
+  int *vn = malloc(sizeof(int) * n * 2), *since = vn + n;
+  struct PNCseKey *keys = malloc(sizeof(struct PNCseKey) * (CSE_KEYS + 1));
+  u8 *rd = malloc(n * 2), *wr = rd + n;
+
+  potion_cse_upvals(f, ops, len, upv, caught);
+  for (i = 0; i < len; i++)
+    if (!upv[i] && PEEP_JUMP(ops[i]) && i + PEEP_OFF(ops[i]) + 1 < len)
+      lead[i + PEEP_OFF(ops[i]) + 1] = 1;
+
+#define CSE_VN(r) (vn[r] >= 0 ? vn[r] : (since[r] = -1, vn[r] = nv++))
+#define CSE_USE(r) ({ \
+  int y = potion_cse_holder(vn, since, n, CSE_VN(r), r); \
+  if (y != (r)) { r = y; changed = 1; } \
+})
+
+  for (i = 0; i <= len; i++) {
+    PN_OP *op;
+    if (i == 0 || i == len || lead[i] ||
+        (!upv[i - 1] && (ops[i - 1].code == OP_JMP || ops[i - 1].code == OP_RETURN))) {
+      for (r = 0; r < n; r++) vn[r] = -1;
+      nk = 0;
+    }
+    if (i == len) break;
+    if (upv[i]) continue;
+    op = &ops[i];
+    if (nk >= CSE_KEYS) {
+      memmove(keys, keys + CSE_KEYS / 2, sizeof(struct PNCseKey) * (nk - CSE_KEYS / 2));
+      nk -= CSE_KEYS / 2;
+    }
+
+    // operands which are only read
+    switch (op->code) {
+      case OP_MOVE: case OP_CALLSET: case OP_SETTUPLE: case OP_GETPATH:
+      case OP_ADD: case OP_SUB: case OP_MULT: case OP_DIV: case OP_REM:
+      case OP_POW: case OP_CMP: case OP_EQ: case OP_NEQ: case OP_LT:
+      case OP_LTE: case OP_GT: case OP_GTE: case OP_BITL: case OP_BITR:
+      case OP_BIND: case OP_MESSAGE: case OP_CLASS: case OP_SETTABLE:
+      case OP_SETPATH: case OP_DEF: case OP_PUTTABLE:
+        if (op->b >= 0 && op->b < n && op->b != op->a) { int b = op->b; CSE_USE(b); op->b = b; }
+      break;
+      case OP_SETLOCAL: case OP_SETUPVAL: case OP_TESTJMP: case OP_NOTJMP:
+      case OP_RETURN:
+        if (op->a >= 0 && op->a < n) { int a = op->a; CSE_USE(a); op->a = a; }
+      break;
+    }
+
+    switch (op->code) {
+      case OP_MOVE:
+        if (op->a < n && op->b < n) {
+          vn[op->a] = CSE_VN(op->b);
+          since[op->a] = i;
+          continue;
+        }
+      break;
+      case OP_LOADK: case OP_LOADPN: case OP_SELF: case OP_GETLOCAL:
+      case OP_GETUPVAL: case OP_GETPATH: {
+        int x = op->code == OP_SELF ? 0 : op->b, y = 0, k, v;
+        if (op->a >= n || op->b >= n) break;
+        if (op->code == OP_GETPATH) x = CSE_VN(op->a), y = CSE_VN(op->b);
+        if ((k = potion_cse_find(keys, nk, op->code, x, y)) >= 0) {
+          int h;
+          v = keys[k].v;
+          h = potion_cse_holder(vn, since, n, v, op->a);
+          if (vn[op->a] == v && op->code != OP_GETPATH) {
+            op->code = OP_MOVE;
+            op->b = op->a;
+            changed = 1;
+            continue;
+          }
+          if (h != op->a && vn[h] == v) {
+            op->code = OP_MOVE;
+            op->b = h;
+            changed = 1;
           }
+        } else {
+          v = nv++;
+          keys[nk].code = op->code; keys[nk].x = x; keys[nk].y = y; keys[nk++].v = v;
         }
+        vn[op->a] = v;
+        since[op->a] = i;
+        continue;
       }
-    });
+      case OP_SETLOCAL: case OP_SETUPVAL: {
+        u8 code = op->code == OP_SETLOCAL ? OP_GETLOCAL : OP_GETUPVAL;
+        int k = potion_cse_find(keys, nk, code, op->b, 0);
+        if (op->a >= n) break;
+        if (k < 0) k = nk++;
+        keys[k].code = code; keys[k].x = op->b; keys[k].y = 0;
+        keys[k].v = CSE_VN(op->a);
+        continue;
+      }
+    }
+
+    // anything else: forget what might have changed,
+    // and whatever it writes is something new
+    if (!potion_cse_pure(*op) || op->code == OP_PROTO || op->code == OP_SETPATH) {
+      int k, m = 0;
+      for (k = 0; k < nk; k++)
+        if (keys[k].code == OP_GETUPVAL || keys[k].code == OP_GETPATH ||
+            (keys[k].code == OP_GETLOCAL && keys[k].x < nl && caught[keys[k].x])) continue;
+        else keys[m++] = keys[k];
+      nk = m;
+    }
+    memset(rd, 0, n * 2);
+    if (!potion_regs_of(*op, rd, wr, n)) {
+      for (r = 0; r < n; r++) vn[r] = -1;
+      nk = 0;
+      continue;
+    }
+    for (r = 0; r < n; r++)
+      if (wr[r]) { vn[r] = nv++; since[r] = i; }
+  }
+#undef CSE_VN
+#undef CSE_USE
+
+  free(upv); free(vn); free(keys); free(rd);
+  return changed;
+}
+
+// drops loads into registers nobody reads
+static int potion_cse_sweep(Potion *P, vPN(Proto) f) {
+  PN_OP *ops = (PN_OP *)((PNFlex *)f->asmb)->ptr;
+  PN_SIZE len = PN_OP_LEN(f->asmb), i;
+  int n = PN_INT(f->stack), changed = 0;
+  u8 *rd, *out, *upv;
+
+  if (len * n > REGS_MAX_WORK) return 0;
+  rd = calloc(len * n * 4 + len, 1);
+  out = rd + len * n * 3; upv = out + len * n;
+  if (potion_regs_live(f, ops, len, n, rd))
+    for (i = 0; i < len; i++) {
+      PN_OP op = ops[i];
+      if (upv[i] || !(CSE_LOAD(op) || op.code == OP_MOVE || op.code == OP_NEWTUPLE)) continue;
+      if (op.code == OP_MOVE && op.a == op.b) continue;
+      if (!REG_AT(out, i, op.a)) {
+        ops[i].code = OP_MOVE;
+        ops[i].b = op.a;
+        changed = 1;
+      }
+    }
+  free(rd);
+  return changed;
+}
+
+static void potion_cse(Potion *P, vPN(Proto) f) {
+  int i;
+  for (i = 0; i < CSE_PASSES && potion_cse_hoist(P, f); i++);
+  for (i = 0; i < CSE_PASSES; i++) {
+    int changed = potion_cse_number(P, f);
+    changed |= potion_cse_sweep(P, f);
+    if (!changed) break;
   }
+  potion_peephole(P, f);
+}
+
+PN potion_sig_compile(Potion *P, vPN(Proto) f, PN src) {
+  PN sig = PN_TUP0();
+  PN_TUPLE_EACH(potion_sig_names(P, src), i, v, {
+    PN_STORE(f, PN_LOCALS, v);
+    sig = PN_PUSH(PN_PUSH(sig, v), PN_NUM('o'));
+  });
   return sig;
 }
 
+// a call whose result is returned straight away (maybe over a
+// JMP or two) becomes a TAILCALL, which can reuse the frame. the
+// RETURN stays, for the calls that can't.
+static void potion_tailcalls(Potion *P, vPN(Proto) f) {
+  PN_OP *ops = (PN_OP *)((PNFlex *)f->asmb)->ptr;
+  PN_SIZE i, j, len = PN_OP_LEN(f->asmb);
+  int hops;
+  for (i = 0; i < len; i++) {
+    if (ops[i].code == OP_PROTO) {
+      i += PN_TUPLE_LEN(PN_PROTO(PN_TUPLE_AT(f->protos, ops[i].b))->upvals);
+      continue;
+    }
+    if (ops[i].code != OP_CALL && ops[i].code != OP_GETTABLE) continue;
+    for (j = i + 1, hops = 0; j < len && ops[j].code == OP_JMP && hops < 8; hops++)
+      j += ops[j].a + 1;
+    if (j < len && ops[j].code == OP_RETURN && ops[j].a == ops[i].a)
+      ops[i].code = OP_TAILCALL;
+  }
+}
+
+// does closure f (or one inside it) assign upval n, or
+// pass it on where it couldn't be marked flat?
+static int potion_upval_set(vPN(Proto) f, PN_SIZE n) {
+  PN_OP *ops = (PN_OP *)((PNFlex *)f->asmb)->ptr;
+  PN_SIZE i, len = PN_OP_LEN(f->asmb);
+  if (n >= sizeof(f->flat) * 8) return 1;
+  for (i = 0; i < len; i++) {
+    if (ops[i].code == OP_SETUPVAL && ops[i].b == n) return 1;
+    if (ops[i].code == OP_PROTO) {
+      vPN(Proto) g = (struct PNProto *)PN_TUPLE_AT(f->protos, ops[i].b);
+      PN_SIZE j, c = PN_TUPLE_LEN(g->upvals);
+      for (j = 1; j <= c && i + j < len; j++)
+        if (ops[i + j].code == OP_GETUPVAL && ops[i + j].b == n &&
+            potion_upval_set(g, j - 1)) return 1;
+      i += c;
+    }
+  }
+  return 0;
+}
+
+static void potion_upval_flat(vPN(Proto) f, PN_SIZE n) {
+  PN_OP *ops = (PN_OP *)((PNFlex *)f->asmb)->ptr;
+  PN_SIZE i, len = PN_OP_LEN(f->asmb);
+  f->flat |= 1UL << n;
+  for (i = 0; i < len; i++) {
+    if (ops[i].code == OP_PROTO) {
+      vPN(Proto) g = (struct PNProto *)PN_TUPLE_AT(f->protos, ops[i].b);
+      PN_SIZE j, c = PN_TUPLE_LEN(g->upvals);
+      for (j = 1; j <= c && i + j < len; j++)
+        if (ops[i + j].code == OP_GETUPVAL && ops[i + j].b == n)
+          potion_upval_flat(g, j - 1);
+      i += c;
+    }
+  }
+}
+
+// a captured local which is assigned once, before any closure
+// takes it, and never again (not by a closure either) can be
+// copied into the closure, rather than shared through a ref.
+// args count as assigned on entry. the assignment has to be
+// outside any loop and on every path to the closures.
+static void potion_proto_flat(Potion *P, vPN(Proto) f) {
+  PN_OP *ops = (PN_OP *)((PNFlex *)f->asmb)->ptr;
+  PN_SIZE i, j, n, len = PN_OP_LEN(f->asmb), nl = PN_TUPLE_LEN(f->locals);
+  long *at;
+  u8 *bad, *upv;
+  if (nl == 0 || PN_TUPLE_LEN(f->protos) == 0) return;
+  at = malloc(sizeof(long) * nl);
+  bad = calloc(nl + len, 1), upv = bad + nl;
+  for (n = 0; n < nl; n++) at[n] = -2;
+  PN_TUPLE_EACH(f->sig, i, v, {
+    if (PN_IS_STR(v)) at[PN_GET(f->locals, v)] = -1;
+  });
+
+  // the ops after a PROTO carry its upvals, they aren't run
+  for (i = 0; i < len; i++) {
+    if (ops[i].code == OP_PROTO) {
+      PN_SIZE c = PN_TUPLE_LEN(PN_PROTO(PN_TUPLE_AT(f->protos, ops[i].b))->upvals);
+      for (j = 1; j <= c && i + j < len; j++) upv[i + j] = 1;
+      i += c;
+    } else if (ops[i].code == OP_SETLOCAL && ops[i].b < nl) {
+      if (at[ops[i].b] != -2) bad[ops[i].b] = 1;
+      at[ops[i].b] = i;
+    }
+  }
+  for (n = 0; n < nl; n++) {
+    if (at[n] == -2) bad[n] = 1;
+    if (bad[n] || at[n] < 0) continue;
+    for (i = 0; i < len; i++) {
+      long t = i + PEEP_OFF(ops[i]) + 1;
+      if (upv[i] || !PEEP_JUMP(ops[i])) continue;
+      if (((long)i < at[n] && t > at[n]) || ((long)i > at[n] && t <= at[n])) {
+        bad[n] = 1;
+        break;
+      }
+    }
+  }
+  for (i = 0; i < len; i++) {
+    if (ops[i].code == OP_PROTO) {
+      vPN(Proto) g = (struct PNProto *)PN_TUPLE_AT(f->protos, ops[i].b);
+      PN_SIZE c = PN_TUPLE_LEN(g->upvals);
+      for (j = 1; j <= c && i + j < len; j++) {
+        n = ops[i + j].b;
+        if (ops[i + j].code == OP_GETLOCAL && n < nl &&
+            ((long)i < at[n] || potion_upval_set(g, j - 1))) bad[n] = 1;
+      }
+      i += c;
+    }
+  }
+  for (i = 0; i < len; i++) {
+    if (ops[i].code == OP_PROTO) {
+      vPN(Proto) g = (struct PNProto *)PN_TUPLE_AT(f->protos, ops[i].b);
+      PN_SIZE c = PN_TUPLE_LEN(g->upvals);
+      for (j = 1; j <= c && i + j < len; j++)
+        if (ops[i + j].code == OP_GETLOCAL && ops[i + j].b < nl && !bad[ops[i + j].b])
+          potion_upval_flat(g, j - 1);
+      i += c;
+    }
+  }
+  free(at);
+  free(bad);
+}
+
+// which locals a nested closure captures. the upvals carried
+// after a PROTO are the only place a local is turned into a
+// ref, so every other local can skip the ref test.
+static unsigned long potion_proto_refs(vPN(Proto) f) {
+  PN_OP *ops = (PN_OP *)((PNFlex *)f->asmb)->ptr;
+  PN_SIZE i, len = PN_OP_LEN(f->asmb);
+  unsigned long refs = 0;
+  for (i = 0; i < len; i++) {
+    if (ops[i].code == OP_PROTO) {
+      vPN(Proto) g = (struct PNProto *)PN_TUPLE_AT(f->protos, ops[i].b);
+      PN_SIZE j, c = PN_TUPLE_LEN(g->upvals);
+      for (j = 1; j <= c && i + j < len; j++)
+        if (ops[i + j].code == OP_GETLOCAL && ops[i + j].b < sizeof(refs) * 8 &&
+            !PN_UPVAL_FLAT(g, j - 1))
+          refs |= 1UL << ops[i + j].b;
+      i += c;
+    }
+  }
+  return refs;
+}
+
+// the local each argument lands in, worked out once here so
+// a call can drop its args right in without looking up names.
+static void potion_proto_args(Potion *P, vPN(Proto) f) {
+  PN map = PN_TUP0();
+  if (PN_IS_TUPLE(f->sig)) {
+    PN_TUPLE_EACH(f->sig, i, v, {
+      if (PN_IS_STR(v))
+        map = PN_PUSH(map, PN_NUM(PN_GET(f->locals, v)));
+    });
+  }
+  f->argmap = map;
+  f->arity = PN_TUPLE_LEN(map);
+  PN_TOUCH(f);
+}
+
 PN potion_source_compile(Potion *P, PN cl, PN self, PN source, PN sig) {
   vPN(Proto) f;
   vPN(Source) t = (struct PNSource *)self;
@@ -674,15 +2611,33 @@ PN potion_source_compile(Potion *P, PN cl, PN self, PN source, PN sig) {
   f->upvals = PN_TUP0();
   f->values = PN_TUP0();
   f->tree = self;
+  f->argmap = PN_NIL;
+  f->index = PN_TUP0();
+  f->index = PN_PUSH(PN_PUSH(PN_PUSH(f->index, potion_table_empty(P)), potion_table_empty(P)),
+    potion_table_empty(P));
   f->sig = (sig == PN_NIL ? PN_TUP0() : potion_sig_compile(P, f, sig));
   f->asmb = (PN)potion_asm_new(P);
+  f->jit = NULL;
+  f->traces = NULL;
+  f->flat = 0;
 
+  if (P->optimize) potion_source_fold(P, (PN)t);
   potion_source_asmb(P, f, NULL, 0, t, 0);
   PN_ASM1(OP_RETURN, 0);
+  potion_index_done(P, f);
+  if (P->optimize) {
+    potion_peephole(P, f);
+    potion_cse(P, f);
+    potion_regalloc(P, f);
+  }
+  potion_tailcalls(P, f);
 
   f->localsize = PN_TUPLE_LEN(f->locals);
   f->upvalsize = PN_TUPLE_LEN(f->upvals);
   f->pathsize = PN_TUPLE_LEN(f->paths);
+  if (P->optimize) potion_proto_flat(P, f);
+  f->refs = potion_proto_refs(f);
+  potion_proto_args(P, f);
   return (PN)f;
 }
 
@@ -690,7 +2645,7 @@ PN potion_source_compile(Potion *P, PN cl, PN self, PN source, PN sig) {
 #define READ_PN(pn, ptr) ({PN rpn = *(PN *)ptr; ptr += pn; rpn;})
 #define READ_CONST(pn, ptr) ({ \
     PN val = READ_PN(pn, ptr); \
-    if (PN_IS_PTR(val)) { \
+    if (!PN_IS_NUM(val) && (val & PN_REF_MASK)) { \
       if (val & 2) { \
         size_t len = ((val ^ 2) >> 4) - 1; \
         val = potion_decimal(P, (char *)ptr, len); \
@@ -704,57 +2659,107 @@ PN potion_source_compile(Potion *P, PN cl, PN self, PN source, PN sig) {
     val; \
   })
 
+// a count of 255 or more is a 255 byte, then the whole count
+#define READ_COUNT(pn, ptr) ({ \
+    long rc = READ_U8(ptr); \
+    if (rc == 255) rc = (long)READ_PN(pn, ptr); \
+    rc; \
+  })
 #define READ_TUPLE(ptr) \
-  long i = 0, count = READ_U8(ptr); \
-  PN tup = potion_tuple_with_size(P, (PN_SIZE)count); \
-  for (; i < count; i++)
+  long i = 0, count = READ_COUNT(pn, ptr); \
+  PN volatile tup = potion_tuple_with_size(P, (PN_SIZE)count); \
+  for (; i < count; i++) PN_TUPLE_AT(tup, i) = PN_NIL; \
+  for (i = 0; i < count; i++)
+// (the gc looks at every slot, and the tuple can move as each is read in.)
 #define READ_VALUES(pn, ptr) ({ \
-    READ_TUPLE(ptr) PN_TUPLE_AT(tup, i) = READ_CONST(pn, ptr); \
+    READ_TUPLE(ptr) { PN rv = READ_CONST(pn, ptr); PN_TUPLE_AT(tup, i) = rv; PN_TOUCH(tup); } \
     tup; \
   })
 #define READ_PROTOS(pn, ptr) ({ \
-    READ_TUPLE(ptr) PN_TUPLE_AT(tup, i) = potion_proto_load(P, (PN)f, pn, &(ptr)); \
+    READ_TUPLE(ptr) { PN rv = potion_proto_load(P, (PN)f, pn, &(ptr)); PN_TUPLE_AT(tup, i) = rv; PN_TOUCH(tup); } \
     tup; \
   })
 
-// TODO: this byte string is volatile, need to avoid using ptr
-PN potion_proto_load(Potion *P, PN up, u8 pn, u8 **ptr) {
+// can every op be written in the narrow form?
+static int potion_proto_narrow(vPN(Proto) f) {
+  PN_SIZE i, len = PN_OP_LEN(f->asmb);
+  for (i = 0; i < len; i++)
+    if (!PN_OP_NARROW_FITS(PN_OP_AT(f->asmb, i))) return 0;
+  return 1;
+}
+
+// (read each part in before storing it, the proto can move or get old.)
+#define READ_PART(part, read) ({ PN rv = read; f->part = rv; PN_TOUCH(f); })
+
+PN potion_proto_load(Potion *P, PN volatile up, u8 pn, u8 **ptr) {
   PN len = 0;
   PNAsm * volatile asmb = NULL;
   vPN(Proto) f = PN_ALLOC(PN_TPROTO, struct PNProto);
-  f->source = READ_CONST(pn, *ptr);
-  if (f->source == PN_NIL) f->source = up; 
-  f->sig = READ_VALUES(pn, *ptr);
-  f->stack = READ_CONST(pn, *ptr);
-  f->values = READ_VALUES(pn, *ptr);
-  f->paths = READ_VALUES(pn, *ptr);
-  f->locals = READ_VALUES(pn, *ptr);
-  f->upvals = READ_VALUES(pn, *ptr);
-  f->protos = READ_PROTOS(pn, *ptr);
+  // the gc may look the proto over while its parts are read in
+  f->source = f->sig = f->stack = f->values = f->paths = f->locals =
+    f->upvals = f->protos = f->tree = f->index = f->argmap = f->asmb = PN_NIL;
+  READ_PART(source, READ_CONST(pn, *ptr));
+  if (f->source == PN_NIL) READ_PART(source, up);
+  READ_PART(sig, READ_VALUES(pn, *ptr));
+  READ_PART(stack, READ_CONST(pn, *ptr));
+  READ_PART(values, READ_VALUES(pn, *ptr));
+  READ_PART(paths, READ_VALUES(pn, *ptr));
+  READ_PART(locals, READ_VALUES(pn, *ptr));
+  READ_PART(upvals, READ_VALUES(pn, *ptr));
+  READ_PART(protos, READ_PROTOS(pn, *ptr));
 
+  // ops are narrow, unless the length's low bit says wide
   len = READ_PN(pn, *ptr);
-  PN_FLEX_NEW(asmb, PN_TBYTES, PNAsm, len);
-  PN_MEMCPY_N(asmb->ptr, *ptr, u8, len);
-  asmb->len = len;
+  if (len & 1) {
+    len ^= 1;
+    PN_FLEX_NEW(asmb, PN_TBYTES, PNAsm, len);
+    PN_MEMCPY_N(asmb->ptr, *ptr, u8, len);
+    asmb->len = len;
+  } else {
+    PN_SIZE i, n = len / sizeof(PN_OP_NARROW);
+    PN_FLEX_NEW(asmb, PN_TBYTES, PNAsm, n * sizeof(PN_OP));
+    for (i = 0; i < n; i++) {
+      PN_OP_NARROW op;
+      PN_MEMCPY(&op, *ptr + i * sizeof(PN_OP_NARROW), PN_OP_NARROW);
+      ((PN_OP *)asmb->ptr)[i].code = op.code;
+      ((PN_OP *)asmb->ptr)[i].a = op.a;
+      ((PN_OP *)asmb->ptr)[i].b = op.b;
+    }
+    asmb->len = n * sizeof(PN_OP);
+  }
 
-  f->asmb = (PN)asmb;
+  READ_PART(asmb, (PN)asmb);
+  f->jit = NULL;
+  f->traces = NULL;
+  f->flat = 0;
   f->localsize = PN_TUPLE_LEN(f->locals);
   f->upvalsize = PN_TUPLE_LEN(f->upvals);
   f->pathsize = PN_TUPLE_LEN(f->paths);
+  if (P->optimize) potion_proto_flat(P, f);
+  f->refs = potion_proto_refs(f);
+  potion_proto_args(P, f);
   *ptr += len;
   return (PN)f;
 }
 
 // TODO: load from a stream
 PN potion_source_load(Potion *P, PN cl, PN buf) {
-  u8 *ptr;
-  vPN(BHeader) h = (struct PNBHeader *)PN_STR_PTR(buf);
-  if ((size_t)PN_STR_LEN(buf) <= sizeof(struct PNBHeader) || 
+  u8 *ptr, *bytes;
+  PN proto;
+  size_t len = PN_STR_LEN(buf);
+  struct PNBHeader *h = (struct PNBHeader *)PN_STR_PTR(buf);
+  if (len <= sizeof(struct PNBHeader) || 
       strncmp((char *)h->sig, POTION_SIG, 4) != 0)
     return PN_NIL;
 
+  // buf can move while the protos are allocated, so load from a copy
+  bytes = malloc(len);
+  PN_MEMCPY_N(bytes, h, u8, len);
+  h = (struct PNBHeader *)bytes;
   ptr = h->proto;
-  return potion_proto_load(P, PN_NIL, h->pn, &ptr);
+  proto = potion_proto_load(P, PN_NIL, h->pn, &ptr);
+  free(bytes);
+  return proto;
 }
 
 #define WRITE_U8(un, ptr) ({*ptr = (u8)un; ptr += sizeof(u8);})
@@ -776,9 +2781,13 @@ PN potion_source_load(Potion *P, PN cl, PN buf) {
       WRITE_PN(cval, ptr); \
     } \
   })
+#define WRITE_COUNT(count, ptr) ({ \
+    if (count < 255) WRITE_U8(count, ptr); \
+    else { WRITE_U8(255, ptr); WRITE_PN((PN)count, ptr); } \
+  })
 #define WRITE_TUPLE(tup, ptr) \
   long i = 0, count = PN_TUPLE_LEN(tup); \
-  WRITE_U8(count, ptr); \
+  WRITE_COUNT(count, ptr); \
   for (; i < count; i++)
 #define WRITE_VALUES(tup, ptr) ({ \
     WRITE_TUPLE(tup, ptr) WRITE_CONST(PN_TUPLE_AT(tup, i), ptr); \
@@ -800,15 +2809,46 @@ long potion_proto_dump(Potion *P, PN proto, PN out, long pos) {
   WRITE_VALUES(f->locals, ptr);
   WRITE_VALUES(f->upvals, ptr);
   WRITE_PROTOS(f->protos, ptr);
-  WRITE_PN(PN_FLEX_SIZE(f->asmb), ptr);
-  PN_MEMCPY_N(ptr, ((PNFlex *)f->asmb)->ptr, u8, PN_FLEX_SIZE(f->asmb));
-  ptr += PN_FLEX_SIZE(f->asmb);
+  if (potion_proto_narrow(f)) {
+    PN_SIZE i, n = PN_OP_LEN(f->asmb);
+    WRITE_PN(n * sizeof(PN_OP_NARROW), ptr);
+    for (i = 0; i < n; i++) {
+      PN_OP_NARROW op;
+      op.code = PN_OP_AT(f->asmb, i).code;
+      op.a = PN_OP_AT(f->asmb, i).a;
+      op.b = PN_OP_AT(f->asmb, i).b;
+      PN_MEMCPY(ptr, &op, PN_OP_NARROW);
+      ptr += sizeof(PN_OP_NARROW);
+    }
+  } else {
+    WRITE_PN(PN_FLEX_SIZE(f->asmb) | 1, ptr);
+    PN_MEMCPY_N(ptr, ((PNFlex *)f->asmb)->ptr, u8, PN_FLEX_SIZE(f->asmb));
+    ptr += PN_FLEX_SIZE(f->asmb);
+  }
   return (char *)ptr - start;
 }
 
+// the most a proto's dump can take up
+#define DUMP_CONST(v) (sizeof(PN) + (PN_IS_STR(v) ? PN_STR_LEN(v) : \
+    PN_IS_DECIMAL(v) ? PN_STR_LEN(potion_num_string(P, PN_NIL, v)) : 0))
+#define DUMP_VALUES(tup) ({ \
+    long dv = 1 + sizeof(PN); \
+    PN_TUPLE_EACH(tup, i, v, { dv += DUMP_CONST(v); }); \
+    dv; \
+  })
+
+static long potion_proto_dumpsize(Potion *P, PN proto) {
+  vPN(Proto) f = (struct PNProto *)proto;
+  long size = DUMP_CONST(f->source) + DUMP_VALUES(f->sig) + DUMP_CONST(f->stack) +
+    DUMP_VALUES(f->values) + DUMP_VALUES(f->paths) + DUMP_VALUES(f->locals) +
+    DUMP_VALUES(f->upvals) + 1 + sizeof(PN) + sizeof(PN) + PN_FLEX_SIZE(f->asmb);
+  PN_TUPLE_EACH(f->protos, i, v, { size += potion_proto_dumpsize(P, v); });
+  return size;
+}
+
 // TODO: dump to a stream
 PN potion_source_dump(Potion *P, PN cl, PN proto) {
-  PN pnb = potion_bytes(P, 8192);
+  PN pnb = potion_bytes(P, sizeof(struct PNBHeader) + potion_proto_dumpsize(P, proto));
   struct PNBHeader h;
   PN_MEMCPY_N(h.sig, POTION_SIG, u8, 4);
   h.major = POTION_MAJOR;
@@ -828,7 +2868,7 @@ PN potion_run(Potion *P, PN code) {
   PN_CLOSURE(cl)->data[0] = code;
   return PN_PROTO(code)->jit(P, cl, P->lobby);
 #else
-  return potion_vm(P, code, P->lobby, PN_NIL, 0, NULL);
+  return potion_vm(P, code, P->lobby, 0, NULL, 0, NULL);
 #endif
 }
 
@@ -0,0 +1,26 @@
+#define POTION_DATE   "2026-10-18"
+#define POTION_COMMIT "7cf279a"
+#define POTION_REV    1
+
+#define POTION_CC     "gcc"
+#define POTION_CFLAGS "-Wall -fno-strict-aliasing -Wno-return-type -O2"
+#define POTION_DEBUG  0
+#define POTION_JIT    1
+#define POTION_MAKE   "make"
+#define POTION_PREFIX "/usr/local"
+
+#define POTION_JIT_TARGET POTION_X86
+#define POTION_PLATFORM "x86_64-linux-gnu"
+#define POTION_WIN32    0
+
+#define PN_SIZE_T     8
+#define LONG_SIZE_T   8
+#define DOUBLE_SIZE_T 8
+#define INT_SIZE_T    4
+#define SHORT_SIZE_T  2
+#define CHAR_SIZE_T   1
+#define LONGLONG_SIZE_T   8
+#define PN_LITTLE_ENDIAN  1
+#define POTION_PAGESIZE   4096
+#define POTION_STACK_DIR  -1
+#define POTION_ARGS_DIR   -1
@@ -63,6 +63,12 @@ int potion_munmap(void *mem, size_t len)
   return VirtualFree(mem, len, MEM_DECOMMIT) != 0 ? 0 : -1;
 }
 
+int potion_mprotect(void *mem, size_t len, const char exec)
+{
+  DWORD old;
+  return VirtualProtect(mem, len, exec ? PAGE_EXECUTE_READ : PAGE_READWRITE, &old) != 0 ? 0 : -1;
+}
+
 #else
 #include <sys/mman.h>
 
@@ -80,4 +86,9 @@ int potion_munmap(void *mem, size_t len)
   return munmap(mem, len);
 }
 
+int potion_mprotect(void *mem, size_t len, const char exec)
+{
+  return mprotect(mem, len, exec ? (PROT_READ|PROT_EXEC) : (PROT_READ|PROT_WRITE));
+}
+
 #endif
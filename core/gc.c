@@ -27,14 +27,15 @@ PN_SIZE potion_stack_len(Potion *P, _PN **p) {
 
 #define HAS_REAL_TYPE(v) (P->vts == NULL || (((struct PNFwd *)v)->fwd == POTION_COPIED || PN_TYPECHECK(PN_VTYPE(v))))
 
-static PN_SIZE pngc_mark_array(Potion *P, register _PN *x, register long n, int forward) {
+PN_SIZE pngc_mark_array(Potion *P, register _PN *x, register long n, int forward) {
   _PN v;
   PN_SIZE i = 0;
   struct PNMemory *M = P->mem;
 
   while (n--) {
     v = *x;
-    if (IS_GC_PROTECTED(v) || IN_BIRTH_REGION(v) || IN_OLDER_REGION(v)) {
+    if (!(v & PN_PRIMITIVE) &&
+        (IS_GC_PROTECTED(v) || IN_BIRTH_REGION(v) || IN_OLDER_REGION(v))) {
       v = potion_fwd(v);
       switch (forward) {
         case 0: // count only
@@ -73,7 +74,10 @@ PN_SIZE potion_mark_stack(Potion *P, int forward) {
   end = M->cstack;
 #endif
   if (n <= 0) return 0;
-  return pngc_mark_array(P, start, n, forward);
+  n = pngc_mark_array(P, start, n, forward);
+  if (P->parser != NULL)
+    n += potion_code_mark(P, forward);
+  return n;
 }
 
 void *pngc_page_new(int *sz, const char exec) {
@@ -93,6 +97,7 @@ static inline int NEW_BIRTH_REGION(struct PNMemory *M, void **wb, int sz) {
   DEL_BIRTH_REGION();
   SET_GEN(birth, newad, sz);
   SET_STOREPTR(5 + keeps);
+  return sz;
 }
 
 //
@@ -121,8 +126,9 @@ static int potion_gc_minor(Potion *P, int sz) {
     M->old_lo, M->old_hi, (long)(M->old_hi - M->old_lo),
     (long)((void *)M->birth_hi - (void *)M->birth_storeptr));
   potion_mark_stack(P, 1);
-
-  GC_MINOR_STRINGS();
+  // fields of the interpreter (like the parser's buffer) get
+  // young objects stored in them without a write barrier
+  potion_mark_minor(P, (const struct PNObject *)P);
 
   wb = (void **)M->birth_storeptr;
   for (storead = wb; storead < (void **)M->birth_hi; storead++) {
@@ -136,6 +142,9 @@ static int potion_gc_minor(Potion *P, int sz) {
     scanptr = potion_mark_minor(P, scanptr);
   scanptr = 0;
 
+  GC_MINOR_STRINGS();
+  potion_code_sweep(P, 0);
+
   sz += 2 * POTION_PAGESIZE;
   sz = max(sz, potion_birth_suggest(sz, M->old_lo, M->old_cur));
 
@@ -194,6 +203,7 @@ static int potion_gc_major(Potion *P, int siz) {
   scanptr = 0;
 
   GC_MAJOR_STRINGS();
+  potion_code_sweep(P, 1);
 
   pngc_page_delete((void *)prevoldlo, (char *)prevoldhi - (char *)prevoldlo);
   prevoldlo = 0;
@@ -404,6 +414,8 @@ void *potion_mark_minor(Potion *P, const struct PNObject *ptr) {
       GC_MINOR_UPDATE(((struct PNProto *)ptr)->values);
       GC_MINOR_UPDATE(((struct PNProto *)ptr)->protos);
       GC_MINOR_UPDATE(((struct PNProto *)ptr)->tree);
+      GC_MINOR_UPDATE(((struct PNProto *)ptr)->index);
+      GC_MINOR_UPDATE(((struct PNProto *)ptr)->argmap);
       GC_MINOR_UPDATE(((struct PNProto *)ptr)->asmb);
     break;
     case PN_TTABLE:
@@ -496,6 +508,8 @@ void *potion_mark_major(Potion *P, const struct PNObject *ptr) {
       GC_MAJOR_UPDATE(((struct PNProto *)ptr)->values);
       GC_MAJOR_UPDATE(((struct PNProto *)ptr)->protos);
       GC_MAJOR_UPDATE(((struct PNProto *)ptr)->tree);
+      GC_MAJOR_UPDATE(((struct PNProto *)ptr)->index);
+      GC_MAJOR_UPDATE(((struct PNProto *)ptr)->argmap);
       GC_MAJOR_UPDATE(((struct PNProto *)ptr)->asmb);
     break;
     case PN_TTABLE:
@@ -565,6 +579,7 @@ void potion_gc_release(Potion *P) {
   void *oldlo = (void *)M->old_lo;
   void *oldhi = (void *)M->old_hi;
 
+  potion_code_release_all(P);
   if (M->birth_lo != M) {
     void *protend = (void *)PN_ALIGN((_PN)M->protect, POTION_PAGESIZE);
     pngc_page_delete((void *)M, (char *)protend - (char *)M);
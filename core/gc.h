@@ -156,6 +156,7 @@ static inline int potion_birth_suggest(int need, volatile void *oldlo, volatile
 
 PN_SIZE potion_stack_len(Potion *, _PN **);
 PN_SIZE potion_mark_stack(Potion *, int);
+PN_SIZE pngc_mark_array(Potion *, register _PN *, register long, int);
 void *potion_gc_copy(Potion *, struct PNObject *);
 void *pngc_page_new(int *, const char);
 void *potion_mark_minor(Potion *, const struct PNObject *);
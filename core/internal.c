@@ -11,8 +11,8 @@
 #include "gc.h"
 
 PN PN_allocate, PN_break, PN_call, PN_class, PN_compile, PN_continue, PN_def,
-   PN_delegated, PN_else, PN_elsif, PN_if, PN_lookup, PN_loop, PN_print,
-   PN_return, PN_self, PN_string, PN_while;
+   PN_delegated, PN_else, PN_elsif, PN_if, PN_join, PN_lookup, PN_loop,
+   PN_print, PN_return, PN_self, PN_string, PN_while;
 PN PN_add, PN_sub, PN_mult, PN_div, PN_rem, PN_bitn, PN_bitl, PN_bitr;
 
 PN potion_allocate(Potion *P, PN cl, PN self, PN len) {
@@ -54,6 +54,7 @@ static void potion_init(Potion *P) {
   PN_else = potion_str(P, "else");
   PN_elsif = potion_str(P, "elsif");
   PN_if = potion_str(P, "if");
+  PN_join = potion_str(P, "join");
   PN_lookup = potion_str(P, "lookup");
   PN_loop = potion_str(P, "loop");
   PN_print = potion_str(P, "print");
@@ -101,6 +102,7 @@ Potion *potion_create(void *sp) {
   PN_FLEX_NEW(P->vts, PN_TFLEX, PNFlex, TYPE_BATCH_SIZE);
   PN_FLEX_SIZE(P->vts) = PN_TYPE_ID(PN_TUSER) + 1;
   P->prec = PN_PREC;
+  P->optimize = 1;
   potion_init(P);
   return P;
 }
@@ -117,6 +119,12 @@ PN potion_delegated(Potion *P, PN closure, PN self) {
 
 PN potion_call(Potion *P, PN cl, PN_SIZE argc, PN * volatile argv) {
   vPN(Closure) c = PN_CLOSURE(cl);
+  // bytecode and argv natives take the args as they are, no varargs in between
+  if (c->flags & PN_CLOSURE_ARGV)
+    return argc > 0 ? ((PN_FV)c->method)(P, cl, argv[0], argc - 1, argv + 1) :
+      ((PN_FV)c->method)(P, cl, cl, 0, NULL);
+  if (c->method == (PN_F)potion_vm_proto && argc > 0)
+    return potion_vm(P, c->data[0], argv[0], argc - 1, argv + 1, c->extra - 1, &c->data[1]);
   switch (argc) {
     case 0:
     return c->method(P, cl, cl);
@@ -76,7 +76,12 @@ struct PNBHeader {
 size_t potion_cp_strlen_utf8(const char *);
 void *potion_mmap(size_t, const char);
 int potion_munmap(void *, size_t);
-#define PN_ALLOC_FUNC(size) potion_mmap(size, 1)
+int potion_mprotect(void *, size_t, const char);
+void *potion_code_new(Potion *, PN, const void *, size_t);
+void potion_code_free(Potion *, void *);
+void potion_code_sweep(Potion *, int);
+void potion_code_release_all(Potion *);
+PN_SIZE potion_code_mark(Potion *, int);
 
 //
 // stack manipulation routines
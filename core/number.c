@@ -11,9 +11,11 @@
 #include "potion.h"
 #include "internal.h"
 
-#define PN_DBL(num) (PN_IS_NUM(num) ? (double)PN_INT(num) : ((struct PNDecimal *)num)->value)
-
 PN potion_real(Potion *P, double v) {
+#if PN_FLONUM
+  PN n = potion_flonum(v);
+  if (n != PN_NIL) return n;
+#endif
   vPN(Decimal) d = PN_ALLOC_N(PN_TNUMBER, struct PNDecimal, 0);
   d->value = v;
   return (PN)d;
@@ -87,11 +89,12 @@ static PN potion_num_number(Potion *P, PN closure, PN self) {
   return self;
 }
 
-static PN potion_num_step(Potion *P, PN cl, PN self, PN end, PN step, PN block) {
+PN potion_num_step(Potion *P, PN cl, PN self, PN end, PN step, PN block) {
   int i, j = PN_INT(end), k = PN_INT(step);
   for (i = PN_INT(self); i <= j; i += k) {
-    PN_CLOSURE(block)->method(P, block, self, PN_NUM(i));
+    potion_closure_call(block, self, PN_NUM(i));
   }
+  return PN_NUM((i - PN_INT(self)) / k);
 }
 
 PN potion_num_string(Potion *P, PN closure, PN self) {
@@ -99,7 +102,7 @@ PN potion_num_string(Potion *P, PN closure, PN self) {
   if (PN_IS_NUM(self)) {
     sprintf(ints, "%ld", PN_INT(self));
   } else {
-    int len = sprintf(ints, "%.16f", ((struct PNDecimal *)self)->value);
+    int len = sprintf(ints, "%.16f", PN_DBL(self));
     while (len > 0 && ints[len - 1] == '0') len--;
     if (ints[len - 1] == '.') len++;
     ints[len] = '\0';
@@ -107,10 +110,10 @@ PN potion_num_string(Potion *P, PN closure, PN self) {
   return potion_str(P, ints);
 }
 
-static PN potion_num_times(Potion *P, PN cl, PN self, PN block) {
+PN potion_num_times(Potion *P, PN cl, PN self, PN block) {
   int i, j = PN_INT(self);
   for (i = 0; i < j; i++)
-    PN_CLOSURE(block)->method(P, block, self, PN_NUM(i));
+    potion_closure_call(block, self, PN_NUM(i));
   return PN_NUM(i);
 }
 
@@ -118,7 +121,7 @@ PN potion_num_to(Potion *P, PN cl, PN self, PN end, PN block) {
   int i, s = 1, j = PN_INT(self), k = PN_INT(end);
   if (k < j) s = -1;
   for (i = j; i != k + s; i += s)
-    PN_CLOSURE(block)->method(P, block, self, PN_NUM(i));
+    potion_closure_call(block, self, PN_NUM(i));
   return PN_NUM(abs(i - j));
 }
 
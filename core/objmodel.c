@@ -21,11 +21,18 @@ PN potion_closure_new(Potion *P, PN_F meth, PN sig, PN_SIZE extra) {
   if (PN_IS_TUPLE(sig) && PN_TUPLE_LEN(sig) > 0)
     c->sig = sig;
   c->extra = extra;
+  c->flags = 0;
   for (i = 0; i < c->extra; i++)
     c->data[i] = PN_NIL;
   return (PN)c;
 }
 
+PN potion_closure_argv(Potion *P, PN_FV meth, PN sig) {
+  PN cl = potion_closure_new(P, (PN_F)meth, sig, 0);
+  PN_CLOSURE(cl)->flags = PN_CLOSURE_ARGV;
+  return cl;
+}
+
 PN potion_closure_code(Potion *P, PN cl, PN self) {
   if (PN_CLOSURE(self)->extra > 0 && PN_IS_PROTO(PN_CLOSURE(self)->data[0])) 
     return PN_CLOSURE(self)->data[0];
@@ -86,35 +93,39 @@ PN potion_class(Potion *P, PN cl, PN self, PN ivars) {
   PNType t = PN_FLEX_SIZE(P->vts) + PN_TNIL;
   PN_FLEX_NEEDS(1, P->vts, PN_TFLEX, PNFlex, TYPE_BATCH_SIZE);
   self = potion_type_new(P, t, parent);
+  // count the type in right away so the gc keeps the
+  // vtable's slot up to date while the ivars are built
+  PN_FLEX_SIZE(P->vts)++;
+  PN_TOUCH(P->vts);
   if (PN_IS_TUPLE(pvars)) {
     if (!PN_IS_TUPLE(ivars)) ivars = PN_TUP0();
     PN_TUPLE_EACH(pvars, i, v, {PN_PUT(ivars, v);});
   }
-  if (PN_IS_TUPLE(ivars))
+  if (PN_IS_TUPLE(ivars)) {
     potion_ivars(P, PN_NIL, self, ivars);
+    self = PN_VTABLE(t);
+    parent = ((struct PNVtable *)self)->parent;
+  }
 
   if (!PN_IS_CLOSURE(cl))
     cl = ((struct PNVtable *)parent)->ctor;
   ((struct PNVtable *)self)->ctor = cl;
-
-  PN_FLEX_SIZE(P->vts)++;
-  PN_TOUCH(P->vts);
   return self;
 }
 
 PN potion_ivars(Potion *P, PN cl, PN self, PN ivars) {
-  struct PNVtable *vt = (struct PNVtable *)self;
+  vPN(Vtable) vt = (struct PNVtable *)self;
+  vPN(Tuple) iv = (struct PNTuple *)ivars;
 #if POTION_JIT == 1
-  // TODO: allocate assembled instructions together into single pages
-  // since many times these tables are <100 bytes.
   PNAsm * volatile asmb = potion_asm_new(P);
-  P->targets[POTION_JIT_TARGET].ivars(P, ivars, &asmb);
-  vt->ivfunc = PN_ALLOC_FUNC(asmb->len);
-  PN_MEMCPY_N(vt->ivfunc, asmb->ptr, u8, asmb->len);
+  P->targets[POTION_JIT_TARGET].ivars(P, (PN)iv, &asmb);
+  potion_code_free(P, vt->ivfunc);
+  vt->ivfunc = potion_code_new(P, (PN)vt, asmb->ptr, asmb->len);
 #endif
-  vt->ivlen = PN_TUPLE_LEN(ivars);
-  vt->ivars = ivars;
-  return self;
+  vt->ivlen = PN_TUPLE_LEN(iv);
+  vt->ivars = (PN)iv;
+  PN_TOUCH(vt);
+  return (PN)vt;
 }
 
 static inline long potion_obj_find_ivar(Potion *P, PN self, PN ivar) {
@@ -148,7 +159,10 @@ PN potion_obj_set(Potion *P, PN cl, PN self, PN ivar, PN value) {
 }
 
 PN potion_proto_method(Potion *P, PN cl, PN self, PN args) {
-  return potion_vm(P, PN_CLOSURE(cl)->data[0], P->lobby, args, 0, NULL);
+  if (PN_IS_TUPLE(args))
+    return potion_vm(P, PN_CLOSURE(cl)->data[0], P->lobby, PN_TUPLE_LEN(args),
+      PN_GET_TUPLE(args)->set, 0, NULL);
+  return potion_vm(P, PN_CLOSURE(cl)->data[0], P->lobby, 0, NULL, 0, NULL);
 }
 
 PN potion_getter_method(Potion *P, PN cl, PN self) {
@@ -176,19 +190,12 @@ PN potion_def_method(Potion *P, PN closure, PN self, PN key, PN method) {
   PN_TOUCH(self);
 
 #ifdef JIT_MCACHE
-  // TODO: make this more flexible, store in fixed gc, see ivfunc TODO also
-  // this is disabled until method weakrefs can be stored in fixed memory
+  // TODO: this is disabled until method weakrefs can be stored in fixed memory
   if (P->targets[POTION_JIT_TARGET].mcache != NULL) {
     PNAsm * volatile asmb = potion_asm_new(P);
     P->targets[POTION_JIT_TARGET].mcache(P, vt, &asmb);
-    if (asmb->len <= 4096) {
-      if (vt->mcache == NULL)
-        vt->mcache = PN_ALLOC_FUNC(4096);
-      PN_MEMCPY_N(vt->mcache, asmb->ptr, u8, asmb->len);
-    } else if (vt->mcache != NULL) {
-      potion_munmap(vt->mcache, 4096);
-      vt->mcache = NULL;
-    }
+    potion_code_free(P, vt->mcache);
+    vt->mcache = potion_code_new(P, self, asmb->ptr, asmb->len);
   }
 #endif
   return method;
@@ -224,7 +231,7 @@ PN potion_bind(Potion *P, PN rcv, PN msg) {
 PN potion_message(Potion *P, PN rcv, PN msg) {
   PN cl = potion_bind(P, rcv, msg);
   if (PN_IS_CLOSURE(cl) && PN_CLOSURE(cl)->sig == PN_NIL)
-    return PN_CLOSURE(cl)->method(P, cl, rcv, PN_NIL);
+    return potion_closure_call(cl, rcv, PN_NIL);
   return cl;
 }
 
@@ -9,16 +9,31 @@
 
 #pragma pack(push, 1)
 
+//
+// in memory, every op is the wide form: registers and jumps
+// to 23 bits, constants and locals to 31. a .pnb keeps the
+// narrow 32-bit form (12-bit fields) for any proto whose ops
+// all fit it, and the wide one for the rest.
+//
+typedef struct {
+  u8 code:8;
+  int a:24;
+  int b:32;
+} PN_OP;
+
 typedef struct {
   u8 code:8;
   int a:12;
   int b:12;
-} PN_OP;
+} PN_OP_NARROW;
 
 #pragma pack(pop)
 
 #define PN_OP_AT(asmb, n) ((PN_OP *)((PNFlex *)asmb)->ptr)[n]
 #define PN_OP_LEN(asmb)   (PN_FLEX_SIZE(asmb) / sizeof(PN_OP))
+#define PN_OP_A_FITS(n)   ((n) >= -0x7FFFFF && (n) <= 0x7FFFFF)
+#define PN_OP_NARROW_FITS(op) \
+  ((op).a >= -2048 && (op).a <= 2047 && (op).b >= -2048 && (op).b <= 2047)
 
 enum PN_OPCODE {
   OP_NONE,
@@ -67,7 +82,10 @@ enum PN_OPCODE {
   OP_TAILCALL,
   OP_RETURN,
   OP_PROTO,
-  OP_CLASS
+  OP_CLASS,
+  OP_GUARD,
+  OP_PUTTABLE,
+  OP_CONCAT
 };
 
 #endif
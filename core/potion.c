@@ -7,6 +7,7 @@
 #include <stdio.h>
 #include <sys/stat.h>
 #include <sys/stat.h>
+#include <sys/time.h>
 #include <fcntl.h>
 #include <unistd.h>
 
@@ -25,9 +26,12 @@ static void potion_cmd_usage() {
   printf("usage: potion [options] [script] [arguments]\n"
       "  -B, --bytecode     run with bytecode VM (slower, but cross-platform)\n"
       "  -X, --x86          run with x86 JIT VM (faster, x86 and x86-64)\n"
+      "  -T, --trace        run with bytecode VM, compiling hot loops (x86-64)\n"
       "  -I, --inspect      print only the return value\n"
       "  -V, --verbose      show bytecode and ast info\n"
       "  -c, --compile      compile the script to bytecode\n"
+      "  -O0, -O1           turn the compiler's optimizations off or on (on by default)\n"
+      "  -s, --stats        show gc and code heap sizes (after the script, if given)\n"
       "  -h, --help         show this helpful stuff\n"
       "  -v, --version      show version\n"
       "(default: %s)\n",
@@ -39,14 +43,22 @@ static void potion_cmd_usage() {
   );
 }
 
+static void potion_print_stats(Potion *P) {
+  long used = PN_INT(potion_code_used(P, 0, 0)), holes = PN_INT(potion_code_holes(P, 0, 0));
+  printf("GC (fixed=%ld, actual=%ld, reserved=%ld)\n",
+      PN_INT(potion_gc_fixed(P, 0, 0)), PN_INT(potion_gc_actual(P, 0, 0)),
+      PN_INT(potion_gc_reserved(P, 0, 0)));
+  printf("code (used=%ld, free=%ld, reserved=%ld, fragmentation=%ld%%)\n",
+      used, holes, PN_INT(potion_code_reserved(P, 0, 0)),
+      used + holes > 0 ? (100 * holes) / (used + holes) : 0);
+}
+
 static void potion_cmd_stats(void *sp) {
   Potion *P = potion_create(sp);
   printf("sizeof(PN=%d, PNObject=%d, PNTuple=%d, PNTuple+1=%d, PNTable=%d)\n",
       (int)sizeof(PN), (int)sizeof(struct PNObject), (int)sizeof(struct PNTuple),
       (int)(sizeof(PN) + sizeof(struct PNTuple)), (int)sizeof(struct PNTable));
-  printf("GC (fixed=%ld, actual=%ld, reserved=%ld)\n",
-      PN_INT(potion_gc_fixed(P, 0, 0)), PN_INT(potion_gc_actual(P, 0, 0)),
-      PN_INT(potion_gc_reserved(P, 0, 0)));
+  potion_print_stats(P);
   potion_destroy(P);
 }
 
@@ -54,11 +66,20 @@ static void potion_cmd_version() {
   printf(potion_banner, POTION_JIT);
 }
 
-static void potion_cmd_compile(char *filename, int exec, int verbose, void *sp) {
+// milliseconds since `start`
+static double potion_elapsed(struct timeval *start) {
+  struct timeval end;
+  gettimeofday(&end, NULL);
+  return (end.tv_sec - start->tv_sec) * 1000.0 + (end.tv_usec - start->tv_usec) / 1000.0;
+}
+
+static void potion_cmd_compile(char *filename, int exec, int verbose, int showstats, int optimize, void *sp) {
   PN buf;
   int fd = -1;
   struct stat stats;
+  struct timeval start;
   Potion *P = potion_create(sp);
+  P->optimize = optimize;
   if (stat(filename, &stats) == -1) {
     fprintf(stderr, "** %s does not exist.", filename);
     goto done;
@@ -89,20 +110,24 @@ static void potion_cmd_compile(char *filename, int exec, int verbose, void *sp)
         potion_send(potion_send(code, PN_string), PN_print);
         printf("\n");
       }
-      code = potion_send(code, PN_compile, potion_str(P, filename), PN_NIL);
       if (verbose > 1)
         printf("\n-- compiled --\n");
+      P->verbose = (verbose > 1);
+      code = potion_send(code, PN_compile, potion_str(P, filename), PN_NIL);
+      P->verbose = 0;
     }
     if (verbose > 1) {
       potion_send(potion_send(code, PN_string), PN_print);
       printf("\n");
     }
-    if (exec == 1) {
-      code = potion_vm(P, code, P->lobby, PN_NIL, 0, NULL);
+    if (exec == 1 || exec == 3) {
+      P->trace = (exec == 3);
+      gettimeofday(&start, NULL);
+      code = potion_vm(P, code, P->lobby, 0, NULL, 0, NULL);
       if (verbose > 1)
-        printf("\n-- vm returned %p (fixed=%ld, actual=%ld, reserved=%ld) --\n", (void *)code,
+        printf("\n-- vm returned %p (fixed=%ld, actual=%ld, reserved=%ld, time=%.3fms) --\n", (void *)code,
           PN_INT(potion_gc_fixed(P, 0, 0)), PN_INT(potion_gc_actual(P, 0, 0)),
-          PN_INT(potion_gc_reserved(P, 0, 0)));
+          PN_INT(potion_gc_reserved(P, 0, 0)), potion_elapsed(&start));
       if (verbose) {
         potion_send(potion_send(code, PN_string), PN_print);
         printf("\n");
@@ -112,11 +137,12 @@ static void potion_cmd_compile(char *filename, int exec, int verbose, void *sp)
       PN val;
       PN cl = potion_closure_new(P, (PN_F)potion_jit_proto(P, code, POTION_JIT_TARGET), PN_NIL, 1);
       PN_CLOSURE(cl)->data[0] = code;
+      gettimeofday(&start, NULL);
       val = PN_PROTO(code)->jit(P, cl, P->lobby);
       if (verbose > 1)
-        printf("\n-- jit returned %p (fixed=%ld, actual=%ld, reserved=%ld) --\n", PN_PROTO(code)->jit,
+        printf("\n-- jit returned %p (fixed=%ld, actual=%ld, reserved=%ld, time=%.3fms) --\n", PN_PROTO(code)->jit,
           PN_INT(potion_gc_fixed(P, 0, 0)), PN_INT(potion_gc_actual(P, 0, 0)),
-          PN_INT(potion_gc_reserved(P, 0, 0)));
+          PN_INT(potion_gc_reserved(P, 0, 0)), potion_elapsed(&start));
       if (verbose) {
         potion_send(potion_send(val, PN_string), PN_print);
         printf("\n");
@@ -165,6 +191,8 @@ static void potion_cmd_compile(char *filename, int exec, int verbose, void *sp)
     }
 #endif
 
+    if (showstats)
+      potion_print_stats(P);
   } else {
     fprintf(stderr, "** could not read entire file.");
   }
@@ -178,7 +206,7 @@ done:
 
 int main(int argc, char *argv[]) {
   POTION_INIT_STACK(sp);
-  int i, verbose = 0, exec = 1 + POTION_JIT;
+  int i, verbose = 0, showstats = 0, optimize = 1, exec = 1 + POTION_JIT;
 
   if (argc > 1) {
     for (i = 0; i < argc; i++) {
@@ -208,8 +236,17 @@ int main(int argc, char *argv[]) {
 
       if (strcmp(argv[i], "-s") == 0 ||
           strcmp(argv[i], "--stats") == 0) {
-        potion_cmd_stats(sp);
-        return 0;
+        if (i == argc - 1) {
+          potion_cmd_stats(sp);
+          return 0;
+        }
+        showstats = 1;
+        continue;
+      }
+
+      if (strcmp(argv[i], "-O0") == 0 || strcmp(argv[i], "-O1") == 0) {
+        optimize = argv[i][2] - '0';
+        continue;
       }
 
       if (strcmp(argv[i], "-c") == 0 ||
@@ -226,9 +263,14 @@ int main(int argc, char *argv[]) {
           strcmp(argv[i], "--x86") == 0) {
         exec = 2;
       }
+
+      if (strcmp(argv[i], "-T") == 0 ||
+          strcmp(argv[i], "--trace") == 0) {
+        exec = 3;
+      }
     }
 
-    potion_cmd_compile(argv[argc-1], exec, verbose, sp);
+    potion_cmd_compile(argv[argc-1], exec, verbose, showstats, optimize, sp);
     return 0;
   }
 
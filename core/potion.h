@@ -16,6 +16,8 @@
 #define POTION_PPC      1
 #define POTION_TARGETS  2
 
+#define POTION_NAMED_SITES 64
+
 #include <limits.h>
 #include <string.h>
 #include "config.h"
@@ -42,6 +44,9 @@ struct PNError;
 struct PNCont;
 struct PNMemory;
 struct PNVtable;
+struct PNTrace;
+struct PNTraceRec;
+struct PNCodeHeap;
 
 #define PN_TNIL         0x250000
 #define PN_TNUMBER      (1+PN_TNIL)
@@ -85,9 +90,10 @@ struct PNVtable;
 
 #define PN_FNUMBER      1
 #define PN_FBOOLEAN     2
+#define PN_FDECIMAL     4
 #define PN_TEST(v)      ((PN)(v) != PN_FALSE && (PN)(v) != PN_NIL)
 #define PN_BOOL(v)      (PN_TEST(v) ? PN_TRUE : PN_FALSE)
-#define PN_IS_PTR(v)    (!PN_IS_NUM(v) && ((PN)(v) & PN_REF_MASK))
+#define PN_IS_PTR(v)    (!((PN)(v) & PN_PRIMITIVE) && (PN)(v) != PN_NIL)
 #define PN_IS_NIL(v)    ((PN)(v) == PN_NIL)
 #define PN_IS_BOOL(v)   ((PN)(v) & PN_FBOOLEAN)
 #define PN_IS_NUM(v)    ((PN)(v) & PN_FNUMBER)
@@ -95,12 +101,37 @@ struct PNVtable;
 #define PN_IS_STR(v)    (PN_TYPE(v) == PN_TSTRING)
 #define PN_IS_TABLE(v)  (PN_TYPE(v) == PN_TTABLE)
 #define PN_IS_CLOSURE(v) (PN_TYPE(v) == PN_TCLOSURE)
-#define PN_IS_DECIMAL(v) (PN_IS_PTR(v) && PN_TYPE(v) == PN_TNUMBER)
+#define PN_IS_DECIMAL(v) (PN_IS_FLONUM(v) || (PN_IS_PTR(v) && PN_TYPE(v) == PN_TNUMBER))
 #define PN_IS_PROTO(v)   (PN_TYPE(v) == PN_TPROTO)
 #define PN_IS_REF(v)     (PN_TYPE(v) == PN_TWEAK)
+// can local n of proto f be a ref? (past the bits in refs, always.)
+#define PN_LOCAL_REF(f, n) \
+  ((n) >= sizeof((f)->refs) * 8 || (((f)->refs >> (n)) & 1))
+// is upval n of proto f a plain value? (never past the bits in flat.)
+#define PN_UPVAL_FLAT(f, n) \
+  ((n) < sizeof((f)->flat) * 8 && (((f)->flat >> (n)) & 1))
+
+//
+// flonums: on 64-bit, most decimals live right in the PN
+// instead of a PNDecimal. when a double's exponent starts
+// with 0111 or 1000 (magnitudes 2^-127 up to 2^129), its top
+// three exponent bits follow from the fourth, so the double is
+// rotated left by four and those three bits hold the tag.
+// zero, tiny and huge numbers, inf and nan are still boxed.
+// build with -DPN_FLONUM=0 to box every decimal.
+//
+#ifndef PN_FLONUM
+#define PN_FLONUM       (PN_SIZE_T == 8)
+#endif
+#if PN_FLONUM
+#define PN_IS_FLONUM(v) (((PN)(v) & PN_PRIMITIVE) == PN_FDECIMAL)
+#else
+#define PN_IS_FLONUM(v) 0
+#endif
 
 #define PN_NUM(i)       ((PN)((((long)(i))<<1) + PN_FNUMBER))
 #define PN_INT(x)       (((long)(x))>>1)
+#define PN_DBL(x)       (PN_IS_NUM(x) ? (double)PN_INT(x) : potion_dbl((PN)(x)))
 #define PN_PREC 16
 #define PN_RAND()       PN_NUM(potion_rand_int())
 #define PN_STR_PTR(x)   potion_str_ptr(x)
@@ -110,6 +141,8 @@ struct PNVtable;
 #define PN_CLOSURE_F(x) ((struct PNClosure *)(x))->method
 #define PN_PROTO(x)     ((struct PNProto *)(x))
 #define PN_FUNC(f, s)   potion_closure_new(P, (PN_F)f, potion_sig(P, s), 0)
+#define PN_FUNCV(f, s)  potion_closure_argv(P, (PN_FV)f, potion_sig(P, s))
+#define PN_ARGV(n)      ((n) < argc ? argv[n] : PN_NIL)
 #define PN_DEREF(x)     ((struct PNWeakRef *)(x))->data
 #define PN_TOUCH(x)     potion_gc_update(P, (PN)(x))
 
@@ -123,7 +156,7 @@ struct PNVtable;
 #else
 #define PN_NUMHASH(x)   (PNUniq)((x)>>33^(x)^(x)<<11)
 #endif
-#define PN_UNIQ(x)      (PN_IS_PTR(x) ? ((struct PNObject *)(x))->uniq : PN_NUMHASH(x))
+#define PN_UNIQ(x)      (PN_IS_PTR(x) ? potion_uniq((PN)(x)) : PN_NUMHASH(x))
 
 #define PN_IS_EMPTY(T)  (PN_GET_TUPLE(T)->len == 0)
 #define PN_TUP0()       potion_tuple_empty(P)
@@ -231,16 +264,25 @@ struct PNFile {
 };
 
 typedef PN (*PN_F)(Potion *, PN, PN, ...);
+typedef PN (*PN_FV)(Potion *, PN, PN, PN_SIZE, PN * volatile);
 
 //
 // a closure is an anonymous function,
 // non-volatile.
 //
+// its method is a PN_F, taking the args one by one,
+// unless PN_CLOSURE_ARGV is set in its flags. then it's
+// a PN_FV, and gets a count and a pointer to the args
+// (right into the caller's registers, if it can.)
+//
+#define PN_CLOSURE_ARGV 1
+
 struct PNClosure {
   PN_OBJECT_HEADER
   PN_F method;
   PN sig;
   PN_SIZE extra;
+  PN_SIZE flags;
   PN data[0];
 };
 
@@ -268,9 +310,14 @@ struct PNProto {
   PN values; // numbers, strings, etc.
   PN protos; // nested closures
   PN tree; // abstract syntax tree
-  PN_SIZE pathsize, localsize, upvalsize;
+  PN index; // hashed locals, upvals and values, while compiling
+  PN argmap; // the local each argument lands in
+  PN_SIZE pathsize, localsize, upvalsize, arity;
+  unsigned long refs; // locals a nested closure captures, a bit each
+  unsigned long flat; // upvals copied in by value rather than by ref
   PN asmb;   // assembled instructions
   PN_F jit;  // jit function pointer
+  struct PNTrace *traces; // hot loop counters and traces
 };
 
 //
@@ -331,6 +378,7 @@ struct PNCont {
 static inline PNType potion_type(PN obj) {
   if (PN_IS_NUM(obj))  return PN_TNUMBER;
   if (PN_IS_BOOL(obj)) return PN_TBOOLEAN;
+  if (PN_IS_FLONUM(obj)) return PN_TNUMBER;
   if (PN_IS_NIL(obj))  return PN_TNIL;
   while (1) {
     struct PNFwd *o = (struct PNFwd *)obj;
@@ -352,6 +400,32 @@ static inline PN potion_fwd(PN obj) {
   return obj;
 }
 
+#if PN_FLONUM
+// a flonum for `d`, or nil if it has to be boxed.
+static inline PN potion_flonum(double d) {
+  union { _PN n; double d; } u;
+  u.d = d;
+  if (((u.n >> 59) & 0xF) - 7 > 1) return PN_NIL;
+  return (((u.n << 4) | (u.n >> 60)) & PN_REF_MASK) | PN_FDECIMAL;
+}
+
+// the top bit of a flonum says if its tag was 011 or 100.
+static inline double potion_flonum_dbl(PN v) {
+  union { _PN n; double d; } u;
+  u.n = v - (v >> 63);
+  u.n = (u.n >> 4) | (u.n << 60);
+  return u.d;
+}
+#endif
+
+// the value of a decimal, boxed or not
+static inline double potion_dbl(PN v) {
+#if PN_FLONUM
+  if (PN_IS_FLONUM(v)) return potion_flonum_dbl(v);
+#endif
+  return ((struct PNDecimal *)v)->value;
+}
+
 // quick access to either PNString or PNByte pointer
 static inline char *potion_str_ptr(PN s) {
   if (((struct PNString *)s)->vt == PN_TSTRING)
@@ -397,8 +471,17 @@ struct Potion_State {
   int yypos; /* parser buffer position */
   PNAsm * volatile pbuf; /* parser buffer */
   PN unclosed; /* used by parser for named block endings */
+  void *parser; /* the parser at work (its value stack is scanned by the gc) */
   PN call, callset; /* generic call and callset */
   int prec; /* decimal precision */
+  int trace; /* record and compile hot loops in the vm */
+  int optimize; /* fold constants and clean up bytecode as it's compiled */
+  int inlining; /* how many calls deep the compiler is inlining */
+  int verbose; /* print what the compiler decides (-V) */
+  struct {
+    PN sig, name;
+    int x, gcs;
+  } named[POTION_NAMED_SITES]; /* slots of named args, by call site */
   struct PNMemory *mem; /* allocator/gc */
 };
 
@@ -416,6 +499,7 @@ struct PNMemory {
   volatile int collecting, dirty, pass, majors, minors;
   void *cstack; /* machine stack start */
   void *protect; /* end of protected memory */
+  struct PNCodeHeap *code; /* jitted functions */
 };
 
 #define POTION_INIT_STACK(x) \
@@ -437,11 +521,20 @@ static inline void *potion_gc_alloc(Potion *P, PNType vt, int siz) {
     potion_garbagecollect(P, siz + 4 * sizeof(double), 0);
   res = (struct PNObject *)M->birth_cur;
   res->vt = vt;
-  res->uniq = (PNUniq)potion_rand_int();
+  res->uniq = 0;
   M->birth_cur = (char *)res + siz;
   return (void *)res;
 }
 
+// objects are born without a uniq, it's given out the first
+// time one is asked for (which keeps it off the allocation path.)
+static inline PNUniq potion_uniq(PN x) {
+  struct PNObject *obj = (struct PNObject *)potion_fwd(x);
+  while (obj->uniq == 0)
+    obj->uniq = (PNUniq)potion_rand_int();
+  return obj->uniq;
+}
+
 // TODO: mmap already inits to zero?
 static inline void *potion_gc_calloc(Potion *P, PNType vt, int siz) {
   return potion_gc_alloc(P, vt, siz);
@@ -501,15 +594,27 @@ static inline struct PNData *potion_data_alloc(Potion *P, int siz) {
     PN r = (PN)(RCV); \
     PN c = potion_bind(P, r, (MSG)); \
     if (PN_IS_CLOSURE(c)) \
-      c = ((struct PNClosure *)c)->method(P, c, r, ##ARGS); \
+      c = potion_closure_call(c, r, ##ARGS); \
     c; \
   })
 
+// calls a closure from C, either way its method takes args
+#define potion_closure_call(CL, RCV, ARGS...) ({ \
+    PN cl_ = (PN)(CL); \
+    (PN_CLOSURE(cl_)->flags & PN_CLOSURE_ARGV) ? ({ \
+      PN argv_[] = { (PN)(RCV), ##ARGS }; \
+      ((PN_FV)PN_CLOSURE(cl_)->method)(P, cl_, argv_[0], \
+        sizeof(argv_) / sizeof(PN) - 1, argv_ + 1); \
+    }) : PN_CLOSURE(cl_)->method(P, cl_, RCV, ##ARGS); \
+  })
+
 #define potion_method(RCV, MSG, FN, SIG) \
   potion_send(RCV, PN_def, potion_str(P, MSG), PN_FUNC(FN, SIG))
+#define potion_methodv(RCV, MSG, FN, SIG) \
+  potion_send(RCV, PN_def, potion_str(P, MSG), PN_FUNCV(FN, SIG))
 
 extern PN PN_allocate, PN_break, PN_call, PN_class, PN_compile,
-   PN_continue, PN_def, PN_delegated, PN_else, PN_elsif, PN_if,
+   PN_continue, PN_def, PN_delegated, PN_else, PN_elsif, PN_if, PN_join,
    PN_lookup, PN_loop, PN_print, PN_return, PN_self, PN_string,
    PN_while;
 extern PN PN_add, PN_sub, PN_mult, PN_div, PN_rem, PN_bitn, PN_bitl, PN_bitr;
@@ -524,6 +629,7 @@ PNType potion_kind_of(PN);
 void potion_p(Potion *, PN);
 PN potion_str(Potion *, const char *);
 PN potion_str2(Potion *, char *, size_t);
+PN potion_str_join(Potion *, PN, PN_SIZE, PN * volatile);
 PN potion_str_format(Potion *, const char *, ...);
 PN potion_byte_str(Potion *, const char *);
 PN potion_bytes(Potion *, size_t);
@@ -549,11 +655,13 @@ PN potion_lookup(Potion *, PN, PN, PN);
 PN potion_bind(Potion *, PN, PN);
 PN potion_message(Potion *, PN, PN);
 PN potion_closure_new(Potion *, PN_F, PN, PN_SIZE);
+PN potion_closure_argv(Potion *, PN_FV, PN);
 PN potion_callcc(Potion *, PN, PN);
 PN potion_ref(Potion *, PN);
 PN potion_sig(Potion *, char *);
 int potion_sig_find(Potion *, PN, PN);
 PN potion_decimal(Potion *, char *, int);
+PN potion_real(Potion *, double);
 PN potion_pow(Potion *, PN, PN, PN);
 PN potion_srand(Potion *, PN, PN, PN);
 PN potion_rand(Potion *, PN, PN);
@@ -574,6 +682,7 @@ PN potion_tuple_push(Potion *, PN, PN);
 PN_SIZE potion_tuple_push_unless(Potion *, PN, PN);
 PN_SIZE potion_tuple_find(Potion *, PN, PN);
 PN potion_tuple_at(Potion *, PN, PN, PN);
+PN potion_tuple_put(Potion *, PN, PN, PN, PN);
 PN potion_table_empty(Potion *);
 PN potion_table_put(Potion *, PN, PN, PN, PN);
 PN potion_table_set(Potion *, PN, PN, PN);
@@ -605,16 +714,31 @@ void potion_dump_stack(Potion *);
 
 PN potion_any_is_nil(Potion *, PN, PN);
 PN potion_num_string(Potion *, PN, PN);
+PN potion_num_times(Potion *, PN, PN, PN);
+PN potion_num_to(Potion *, PN, PN, PN, PN);
+PN potion_num_step(Potion *, PN, PN, PN, PN, PN);
+PN potion_tuple_each(Potion *, PN, PN, PN_SIZE, PN * volatile);
+PN potion_tuple_join(Potion *, PN, PN, PN_SIZE, PN * volatile);
 PN potion_gc_reserved(Potion *, PN, PN);
 PN potion_gc_actual(Potion *, PN, PN);
 PN potion_gc_fixed(Potion *, PN, PN);
+PN potion_code_used(Potion *, PN, PN);
+PN potion_code_holes(Potion *, PN, PN);
+PN potion_code_reserved(Potion *, PN, PN);
 
 PN potion_parse(Potion *, PN);
 PN potion_vm_proto(Potion *, PN, PN, ...);
 PN potion_vm_class(Potion *, PN, PN);
-PN potion_vm(Potion *, PN, PN, PN, PN_SIZE, PN * volatile);
+PN potion_vm_guard(Potion *, PN, PN, PN_SIZE);
+PN potion_vm_puttable(Potion *, PN, PN, PN);
+int potion_vm_named(Potion *, PN, PN, PN_SIZE);
+PN potion_vm_concat(Potion *, PN, PN_SIZE, PN * volatile);
+PN potion_vm(Potion *, PN, PN, PN_SIZE, PN * volatile, PN_SIZE, PN * volatile);
 PN potion_eval(Potion *, PN);
 PN potion_run(Potion *, PN);
 PN_F potion_jit_proto(Potion *, PN, PN);
+PN_SIZE potion_trace_loop(Potion *, struct PNProto *, struct PNTraceRec **, PN *, PN_SIZE);
+void potion_trace_record(Potion *, struct PNTraceRec **, struct PNProto *, PN *, PN_SIZE);
+void potion_trace_abort(Potion *, struct PNTraceRec **);
 
 #endif
@@ -59,6 +59,59 @@ PN potion_str2(Potion *P, char *str, size_t len) {
   return exist;
 }
 
+// the pieces of ("a", b, "c") join, with sep between them
+// (unless it's nil.) strings and numbers are measured and
+// copied in, so the string's made the once. anything else
+// is sent `string` first, as join would.
+PN potion_str_join(Potion *P, PN sep, PN_SIZE n, PN * volatile argv) {
+  PN v[n + 1], exist;
+  PN_SIZE i, len = 0, seplen = 0;
+  vPN(String) s;
+  char *out;
+
+  v[n] = sep;
+  for (i = 0; i < n; i++) {
+    v[i] = argv[i];
+    if (PN_IS_NUM(v[i])) {
+      long x = PN_INT(v[i]);
+      if (x < 0) len++;
+      do len++; while (x /= 10);
+    } else {
+      if (!PN_IS_STR(v[i])) v[i] = potion_send(v[i], PN_string);
+      len += PN_STR_LEN(v[i]);
+    }
+  }
+  if (v[n] != PN_NIL) {
+    if (!PN_IS_STR(v[n])) v[n] = potion_send(v[n], PN_string);
+    seplen = PN_STR_LEN(v[n]);
+    if (n > 1) len += seplen * (n - 1);
+  }
+
+  s = PN_ALLOC_N(PN_TSTRING, struct PNString, len + 1);
+  s->len = len;
+  out = s->chars;
+  for (i = 0; i < n; i++) {
+    if (i > 0 && seplen > 0) {
+      PN_MEMCPY_N(out, PN_STR_PTR(v[n]), char, seplen);
+      out += seplen;
+    }
+    if (PN_IS_NUM(v[i]))
+      out += sprintf(out, "%ld", PN_INT(v[i]));
+    else {
+      PN_MEMCPY_N(out, PN_STR_PTR(v[i]), char, PN_STR_LEN(v[i]));
+      out += PN_STR_LEN(v[i]);
+    }
+  }
+  *out = '\0';
+
+  exist = potion_lookup_str(P, s->chars);
+  if (exist == PN_NIL) {
+    potion_add_str(P, (PN)s);
+    exist = (PN)s;
+  }
+  return exist;
+}
+
 PN potion_str_format(Potion *P, const char *format, ...) {
   vPN(String) s;
   PN_SIZE len;
@@ -76,15 +129,15 @@ PN potion_str_format(Potion *P, const char *format, ...) {
   return (PN)s;
 }
 
-static PN potion_str_length(Potion *P, PN closure, PN self) {
+static PN potion_str_length(Potion *P, PN closure, PN self, PN_SIZE argc, PN * volatile argv) {
   return PN_NUM(potion_cp_strlen_utf8(PN_STR_PTR(self)));
 }
 
-static PN potion_str_eval(Potion *P, PN closure, PN self) {
+static PN potion_str_eval(Potion *P, PN closure, PN self, PN_SIZE argc, PN * volatile argv) {
   return potion_eval(P, self);
 }
 
-static PN potion_str_number(Potion *P, PN closure, PN self) {
+static PN potion_str_number(Potion *P, PN closure, PN self, PN_SIZE argc, PN * volatile argv) {
   char *str = PN_STR_PTR(self);
   int i = 0, dec = 0, sign = 0, len = PN_STR_LEN(self);
   if (len < 1) return PN_ZERO;
@@ -103,11 +156,11 @@ static PN potion_str_number(Potion *P, PN closure, PN self) {
   return potion_decimal(P, PN_STR_PTR(self), PN_STR_LEN(self));
 }
 
-static PN potion_str_string(Potion *P, PN closure, PN self) {
+static PN potion_str_string(Potion *P, PN closure, PN self, PN_SIZE argc, PN * volatile argv) {
   return self;
 }
 
-static PN potion_str_print(Potion *P, PN closure, PN self) {
+static PN potion_str_print(Potion *P, PN closure, PN self, PN_SIZE argc, PN * volatile argv) {
   printf("%s", PN_STR_PTR(self));
   return PN_NIL;
 }
@@ -139,7 +192,8 @@ inline static PN potion_str_slice_index(PN index, size_t len, int nilvalue) {
   return PN_NUM(corrected);
 }
 
-static PN potion_str_slice(Potion *P, PN closure, PN self, PN start, PN end) {
+static PN potion_str_slice(Potion *P, PN closure, PN self, PN_SIZE argc, PN * volatile argv) {
+  PN start = PN_ARGV(0), end = PN_ARGV(1);
   char *str = PN_STR_PTR(self);
   size_t len = potion_cp_strlen_utf8(str);
   size_t startoffset = potion_utf8char_offset(str, PN_INT(potion_str_slice_index(start, len, 0)));
@@ -147,8 +201,9 @@ static PN potion_str_slice(Potion *P, PN closure, PN self, PN start, PN end) {
   return potion_str2(P, str + startoffset, endoffset - startoffset);
 }
 
-static PN potion_str_at(Potion *P, PN closure, PN self, PN index) {
-  return potion_str_slice(P, closure, self, index, PN_NUM(PN_INT(index) + 1));
+static PN potion_str_at(Potion *P, PN closure, PN self, PN_SIZE argc, PN * volatile argv) {
+  PN range[] = { PN_ARGV(0), PN_NUM(PN_INT(PN_ARGV(0)) + 1) };
+  return potion_str_slice(P, closure, self, 2, range);
 }
 
 PN potion_byte_str(Potion *P, const char *str) {
@@ -211,7 +266,7 @@ PN potion_bytes_append(Potion *P, PN closure, PN self, PN str) {
   return self;
 }
 
-static PN potion_bytes_length(Potion *P, PN closure, PN self) {
+static PN potion_bytes_length(Potion *P, PN closure, PN self, PN_SIZE argc, PN * volatile argv) {
   PN str = potion_fwd(self);
   return PN_NUM(PN_STR_LEN(str));
 }
@@ -230,7 +285,7 @@ PN potion_bytes_string(Potion *P, PN closure, PN self) {
   return exist;
 }
 
-static PN potion_bytes_print(Potion *P, PN closure, PN self) {
+static PN potion_bytes_print(Potion *P, PN closure, PN self, PN_SIZE argc, PN * volatile argv) {
   PN str = potion_fwd(self);
   printf("%s", PN_STR_PTR(str));
   return PN_NIL;
@@ -243,15 +298,15 @@ void potion_str_hash_init(Potion *P) {
 void potion_str_init(Potion *P) {
   PN str_vt = PN_VTABLE(PN_TSTRING);
   PN byt_vt = PN_VTABLE(PN_TBYTES);
-  potion_type_call_is(str_vt, PN_FUNC(potion_str_at, 0));
-  potion_method(str_vt, "eval", potion_str_eval, 0);
-  potion_method(str_vt, "length", potion_str_length, 0);
-  potion_method(str_vt, "number", potion_str_number, 0);
-  potion_method(str_vt, "print", potion_str_print, 0);
-  potion_method(str_vt, "string", potion_str_string, 0);
-  potion_method(str_vt, "slice", potion_str_slice, "start=N,end=N");
+  potion_type_call_is(str_vt, PN_FUNCV(potion_str_at, 0));
+  potion_methodv(str_vt, "eval", potion_str_eval, 0);
+  potion_methodv(str_vt, "length", potion_str_length, 0);
+  potion_methodv(str_vt, "number", potion_str_number, 0);
+  potion_methodv(str_vt, "print", potion_str_print, 0);
+  potion_methodv(str_vt, "string", potion_str_string, 0);
+  potion_methodv(str_vt, "slice", potion_str_slice, "start=N,end=N");
   potion_method(byt_vt, "append", potion_bytes_append, 0);
-  potion_method(byt_vt, "length", potion_bytes_length, 0);
-  potion_method(byt_vt, "print", potion_bytes_print, 0);
+  potion_methodv(byt_vt, "length", potion_bytes_length, 0);
+  potion_methodv(byt_vt, "print", potion_bytes_print, 0);
   potion_method(byt_vt, "string", potion_bytes_string, 0);
 }
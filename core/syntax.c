@@ -0,0 +1,2847 @@
+/* A recursive-descent parser generated by greg 0.3.0 */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+struct _GREG;
+#define YYRULECOUNT 103
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "potion.h"
+#include "internal.h"
+#include "asm.h"
+#include "ast.h"
+#include "gc.h"
+
+#define YY_INPUT(buf, result, max) { \
+  if (P->yypos < PN_STR_LEN(P->input)) { \
+    result = max; \
+    if (P->yypos + max > PN_STR_LEN(P->input)) \
+      result = (PN_STR_LEN(P->input) - P->yypos); \
+    PN_MEMCPY_N(buf, PN_STR_PTR(P->input) + P->yypos, char, result + 1); \
+    P->yypos += max; \
+  } else { \
+    result = 0; \
+  } \
+}
+
+#define YYSTYPE PN
+#define YY_XTYPE Potion *
+#define YY_XVAR P
+#define YY_NAME(N) potion_code_##N
+
+#define YY_TNUM 3
+#define YY_TDEC 13
+
+
+#ifndef YY_ALLOC
+#define YY_ALLOC(N, D) malloc(N)
+#endif
+#ifndef YY_CALLOC
+#define YY_CALLOC(N, S, D) calloc(N, S)
+#endif
+#ifndef YY_REALLOC
+#define YY_REALLOC(B, N, D) realloc(B, N)
+#endif
+#ifndef YY_FREE
+#define YY_FREE free
+#endif
+#ifndef YY_LOCAL
+#define YY_LOCAL(T)	static T
+#endif
+#ifndef YY_ACTION
+#define YY_ACTION(T)	static T
+#endif
+#ifndef YY_RULE
+#define YY_RULE(T)	static T
+#endif
+#ifndef YY_PARSE
+#define YY_PARSE(T)	T
+#endif
+#ifndef YY_NAME
+#define YY_NAME(N) yy##N
+#endif
+#ifndef YY_INPUT
+#define YY_INPUT(buf, result, max_size)			\
+  {							\
+    int yyc= getchar();					\
+    result= (EOF == yyc) ? 0 : (*(buf)= yyc, 1);	\
+    yyprintf((stderr, "<%c>", yyc));			\
+  }
+#endif
+#ifndef YY_BEGIN
+#define YY_BEGIN	( G->begin= G->pos, 1)
+#endif
+#ifndef YY_END
+#define YY_END		( G->end= G->pos, 1)
+#endif
+#ifdef YY_DEBUG
+# define yyprintf(args)	fprintf args
+#else
+# define yyprintf(args)
+#endif
+#ifndef YYSTYPE
+#define YYSTYPE	int
+#endif
+#ifndef YY_XTYPE
+#define YY_XTYPE void *
+#endif
+#ifndef YY_XVAR
+#define YY_XVAR yydata
+#endif
+
+#ifndef YY_PART
+#define yy G->ss
+
+typedef void (*yyaction)(struct _GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR);
+typedef struct _yythunk { int begin, end;  yyaction  action;  struct _yythunk *next; } yythunk;
+
+typedef struct _GREG {
+  char *buf;
+  int buflen;
+  int	pos;
+  int	limit;
+  char *text;
+  int	textlen;
+  int	begin;
+  int	end;
+  yythunk *thunks;
+  int	thunkslen;
+  int thunkpos;
+  YYSTYPE ss;
+  YYSTYPE *val;
+  YYSTYPE *vals;
+  int valslen;
+  YY_XTYPE data;
+} GREG;
+
+YY_LOCAL(int) yyrefill(GREG *G)
+{
+  int yyn;
+  YY_XTYPE YY_XVAR = (YY_XTYPE)G->data;
+  while (G->buflen - G->pos < 512)
+    {
+      G->buflen *= 2;
+      G->buf= YY_REALLOC(G->buf, G->buflen, G->data);
+    }
+  YY_INPUT((G->buf + G->pos), yyn, (G->buflen - G->pos));
+  if (!yyn) return 0;
+  G->limit += yyn;
+  return 1;
+}
+
+YY_LOCAL(int) yymatchDot(GREG *G)
+{
+  if (G->pos >= G->limit && !yyrefill(G)) return 0;
+  ++G->pos;
+  return 1;
+}
+
+YY_LOCAL(int) yymatchChar(GREG *G, int c)
+{
+  if (G->pos >= G->limit && !yyrefill(G)) return 0;
+  if ((unsigned char)G->buf[G->pos] == c)
+    {
+      ++G->pos;
+      yyprintf((stderr, "  ok   yymatchChar(%c) @ %s\n", c, G->buf+G->pos));
+      return 1;
+    }
+  yyprintf((stderr, "  fail yymatchChar(%c) @ %s\n", c, G->buf+G->pos));
+  return 0;
+}
+
+YY_LOCAL(int) yymatchString(GREG *G, char *s)
+{
+  int yysav= G->pos;
+  while (*s)
+    {
+      if (G->pos >= G->limit && !yyrefill(G)) return 0;
+      if (G->buf[G->pos] != *s)
+        {
+          G->pos= yysav;
+          return 0;
+        }
+      ++s;
+      ++G->pos;
+    }
+  return 1;
+}
+
+YY_LOCAL(int) yymatchClass(GREG *G, unsigned char *bits)
+{
+  int c;
+  if (G->pos >= G->limit && !yyrefill(G)) return 0;
+  c= (unsigned char)G->buf[G->pos];
+  if (bits[c >> 3] & (1 << (c & 7)))
+    {
+      ++G->pos;
+      yyprintf((stderr, "  ok   yymatchClass @ %s\n", G->buf+G->pos));
+      return 1;
+    }
+  yyprintf((stderr, "  fail yymatchClass @ %s\n", G->buf+G->pos));
+  return 0;
+}
+
+YY_LOCAL(void) yyDo(GREG *G, yyaction action, int begin, int end)
+{
+  while (G->thunkpos >= G->thunkslen)
+    {
+      G->thunkslen *= 2;
+      G->thunks= YY_REALLOC(G->thunks, sizeof(yythunk) * G->thunkslen, G->data);
+    }
+  G->thunks[G->thunkpos].begin=  begin;
+  G->thunks[G->thunkpos].end=    end;
+  G->thunks[G->thunkpos].action= action;
+  ++G->thunkpos;
+}
+
+YY_LOCAL(int) yyText(GREG *G, int begin, int end)
+{
+  int yyleng= end - begin;
+  if (yyleng <= 0)
+    yyleng= 0;
+  else
+    {
+      while (G->textlen < (yyleng - 1))
+	{
+	  G->textlen *= 2;
+	  G->text= YY_REALLOC(G->text, G->textlen, G->data);
+	}
+      memcpy(G->text, G->buf + begin, yyleng);
+    }
+  G->text[yyleng]= '\0';
+  return yyleng;
+}
+
+YY_LOCAL(void) yyDone(GREG *G)
+{
+  int pos;
+  for (pos= 0;  pos < G->thunkpos;  ++pos)
+    {
+      yythunk *thunk= &G->thunks[pos];
+      int yyleng= thunk->end ? yyText(G, thunk->begin, thunk->end) : thunk->begin;
+      yyprintf((stderr, "DO [%d] %p %s\n", pos, thunk->action, G->text));
+      thunk->action(G, G->text, yyleng, G->data);
+    }
+  G->thunkpos= 0;
+}
+
+YY_LOCAL(void) yyCommit(GREG *G)
+{
+  if ((G->limit -= G->pos))
+    {
+      memmove(G->buf, G->buf + G->pos, G->limit);
+    }
+  G->begin -= G->pos;
+  G->end -= G->pos;
+  G->pos= G->thunkpos= 0;
+}
+
+YY_LOCAL(int) yyAccept(GREG *G, int tp0)
+{
+  if (tp0)
+    {
+      fprintf(stderr, "accept denied at %d\n", tp0);
+      return 0;
+    }
+  else
+    {
+      yyDone(G);
+      yyCommit(G);
+    }
+  return 1;
+}
+
+YY_LOCAL(void) yyPush(GREG *G, char *text, int count, YY_XTYPE YY_XVAR)	{
+  size_t off = (G->val - G->vals) + count;
+  if (off > G->valslen) {
+    while (G->valslen < off + 1)
+      G->valslen *= 2;
+    G->vals= YY_REALLOC((void *)G->vals, sizeof(YYSTYPE) * G->valslen, G->data);
+    G->val= G->vals + off;
+  } else {
+    G->val += count;
+  }
+}
+YY_LOCAL(void) yyPop(GREG *G, char *text, int count, YY_XTYPE YY_XVAR)	{ G->val -= count; }
+YY_LOCAL(void) yySet(GREG *G, char *text, int count, YY_XTYPE YY_XVAR)	{ G->val[count]= G->ss; }
+
+#endif /* YY_PART */
+
+#define	YYACCEPT	yyAccept(G, yythunkpos0)
+
+YY_RULE(int) yy_arg_type(GREG *G); /* 103 */
+YY_RULE(int) yy_arg_name(GREG *G); /* 102 */
+YY_RULE(int) yy_arg(GREG *G); /* 101 */
+YY_RULE(int) yy_optional(GREG *G); /* 100 */
+YY_RULE(int) yy_arg_set(GREG *G); /* 99 */
+YY_RULE(int) yy_arg_sep(GREG *G); /* 98 */
+YY_RULE(int) yy_arg_list(GREG *G); /* 97 */
+YY_RULE(int) yy_args(GREG *G); /* 96 */
+YY_RULE(int) yy_sig(GREG *G); /* 95 */
+YY_RULE(int) yy_end_of_line(GREG *G); /* 94 */
+YY_RULE(int) yy_comment(GREG *G); /* 93 */
+YY_RULE(int) yy_space(GREG *G); /* 92 */
+YY_RULE(int) yy_unq_sep(GREG *G); /* 91 */
+YY_RULE(int) yy_unq_char(GREG *G); /* 90 */
+YY_RULE(int) yy_c2(GREG *G); /* 89 */
+YY_RULE(int) yy_e2(GREG *G); /* 88 */
+YY_RULE(int) yy_q2(GREG *G); /* 87 */
+YY_RULE(int) yy_escc(GREG *G); /* 86 */
+YY_RULE(int) yy_escu(GREG *G); /* 85 */
+YY_RULE(int) yy_esct(GREG *G); /* 84 */
+YY_RULE(int) yy_escr(GREG *G); /* 83 */
+YY_RULE(int) yy_escf(GREG *G); /* 82 */
+YY_RULE(int) yy_escb(GREG *G); /* 81 */
+YY_RULE(int) yy_escn(GREG *G); /* 80 */
+YY_RULE(int) yy_esc(GREG *G); /* 79 */
+YY_RULE(int) yy_c1(GREG *G); /* 78 */
+YY_RULE(int) yy_q1(GREG *G); /* 77 */
+YY_RULE(int) yy_hexl(GREG *G); /* 76 */
+YY_RULE(int) yy_comma(GREG *G); /* 75 */
+YY_RULE(int) yy_utf8(GREG *G); /* 74 */
+YY_RULE(int) yy_str2(GREG *G); /* 73 */
+YY_RULE(int) yy_str1(GREG *G); /* 72 */
+YY_RULE(int) yy_dec(GREG *G); /* 71 */
+YY_RULE(int) yy_hex(GREG *G); /* 70 */
+YY_RULE(int) yy_false(GREG *G); /* 69 */
+YY_RULE(int) yy_true(GREG *G); /* 68 */
+YY_RULE(int) yy_nil(GREG *G); /* 67 */
+YY_RULE(int) yy_immed(GREG *G); /* 66 */
+YY_RULE(int) yy__(GREG *G); /* 65 */
+YY_RULE(int) yy_utfw(GREG *G); /* 64 */
+YY_RULE(int) yy_lick_end(GREG *G); /* 63 */
+YY_RULE(int) yy_lick_start(GREG *G); /* 62 */
+YY_RULE(int) yy_lick(GREG *G); /* 61 */
+YY_RULE(int) yy_block_end(GREG *G); /* 60 */
+YY_RULE(int) yy_block_start(GREG *G); /* 59 */
+YY_RULE(int) yy_table_end(GREG *G); /* 58 */
+YY_RULE(int) yy_table_start(GREG *G); /* 57 */
+YY_RULE(int) yy_unquoted(GREG *G); /* 56 */
+YY_RULE(int) yy_loose(GREG *G); /* 55 */
+YY_RULE(int) yy_lick_item(GREG *G); /* 54 */
+YY_RULE(int) yy_lick_items(GREG *G); /* 53 */
+YY_RULE(int) yy_keyword(GREG *G); /* 52 */
+YY_RULE(int) yy_message(GREG *G); /* 51 */
+YY_RULE(int) yy_quiz(GREG *G); /* 50 */
+YY_RULE(int) yy_path(GREG *G); /* 49 */
+YY_RULE(int) yy_block(GREG *G); /* 48 */
+YY_RULE(int) yy_name(GREG *G); /* 47 */
+YY_RULE(int) yy_table(GREG *G); /* 46 */
+YY_RULE(int) yy_closure(GREG *G); /* 45 */
+YY_RULE(int) yy_value(GREG *G); /* 44 */
+YY_RULE(int) yy_call(GREG *G); /* 43 */
+YY_RULE(int) yy_pplus(GREG *G); /* 42 */
+YY_RULE(int) yy_atom(GREG *G); /* 41 */
+YY_RULE(int) yy_mminus(GREG *G); /* 40 */
+YY_RULE(int) yy_expr(GREG *G); /* 39 */
+YY_RULE(int) yy_wavy(GREG *G); /* 38 */
+YY_RULE(int) yy_not(GREG *G); /* 37 */
+YY_RULE(int) yy_sign(GREG *G); /* 36 */
+YY_RULE(int) yy_product(GREG *G); /* 35 */
+YY_RULE(int) yy_sum(GREG *G); /* 34 */
+YY_RULE(int) yy_bitshift(GREG *G); /* 33 */
+YY_RULE(int) yy_bitand(GREG *G); /* 32 */
+YY_RULE(int) yy_lt(GREG *G); /* 31 */
+YY_RULE(int) yy_lte(GREG *G); /* 30 */
+YY_RULE(int) yy_gt(GREG *G); /* 29 */
+YY_RULE(int) yy_gte(GREG *G); /* 28 */
+YY_RULE(int) yy_bitors(GREG *G); /* 27 */
+YY_RULE(int) yy_neq(GREG *G); /* 26 */
+YY_RULE(int) yy_eq(GREG *G); /* 25 */
+YY_RULE(int) yy_cmp(GREG *G); /* 24 */
+YY_RULE(int) yy_cmps(GREG *G); /* 23 */
+YY_RULE(int) yy_pow(GREG *G); /* 22 */
+YY_RULE(int) yy_rem(GREG *G); /* 21 */
+YY_RULE(int) yy_div(GREG *G); /* 20 */
+YY_RULE(int) yy_times(GREG *G); /* 19 */
+YY_RULE(int) yy_minus(GREG *G); /* 18 */
+YY_RULE(int) yy_plus(GREG *G); /* 17 */
+YY_RULE(int) yy_bitr(GREG *G); /* 16 */
+YY_RULE(int) yy_bitl(GREG *G); /* 15 */
+YY_RULE(int) yy_amp(GREG *G); /* 14 */
+YY_RULE(int) yy_caret(GREG *G); /* 13 */
+YY_RULE(int) yy_pipe(GREG *G); /* 12 */
+YY_RULE(int) yy_assign(GREG *G); /* 11 */
+YY_RULE(int) yy_eqs(GREG *G); /* 10 */
+YY_RULE(int) yy_and(GREG *G); /* 9 */
+YY_RULE(int) yy_or(GREG *G); /* 8 */
+YY_RULE(int) yy_sets(GREG *G); /* 7 */
+YY_RULE(int) yy_sep(GREG *G); /* 6 */
+YY_RULE(int) yy_stmt(GREG *G); /* 5 */
+YY_RULE(int) yy_end_of_file(GREG *G); /* 4 */
+YY_RULE(int) yy_statements(GREG *G); /* 3 */
+YY_RULE(int) yy___(GREG *G); /* 2 */
+YY_RULE(int) yy_potion(GREG *G); /* 1 */
+
+YY_ACTION(void) yy_1_arg_sep(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_arg_sep\n"));
+   P->source = PN_PUSH(P->source, PN_NUM('.')); ;
+}
+YY_ACTION(void) yy_1_optional(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_optional\n"));
+   P->source = PN_PUSH(P->source, PN_NUM('|')); ;
+}
+YY_ACTION(void) yy_2_arg(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define t G->val[-1]
+#define n G->val[-2]
+  yyprintf((stderr, "do yy_2_arg\n"));
+   P->source = PN_PUSH(P->source, t); ;
+#undef t
+#undef n
+}
+YY_ACTION(void) yy_1_arg(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define t G->val[-1]
+#define n G->val[-2]
+  yyprintf((stderr, "do yy_1_arg\n"));
+   P->source = PN_PUSH(PN_PUSH(PN_PUSH(P->source, n), t), PN_NIL); ;
+#undef t
+#undef n
+}
+YY_ACTION(void) yy_1_arg_type(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_arg_type\n"));
+   yy = PN_NUM(yytext[0]); ;
+}
+YY_ACTION(void) yy_1_arg_name(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_arg_name\n"));
+   yy = potion_str2(P, yytext, yyleng); ;
+}
+YY_ACTION(void) yy_1_unquoted(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_unquoted\n"));
+   yy = potion_str2(P, yytext, yyleng); ;
+}
+YY_ACTION(void) yy_2_str2(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_2_str2\n"));
+   yy = potion_bytes_string(P, PN_NIL, (PN)P->pbuf); ;
+}
+YY_ACTION(void) yy_1_str2(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_str2\n"));
+   P->pbuf = potion_asm_clear(P, P->pbuf); ;
+}
+YY_ACTION(void) yy_1_c2(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_c2\n"));
+   P->pbuf = potion_asm_write(P, P->pbuf, yytext, yyleng); ;
+}
+YY_ACTION(void) yy_1_e2(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_e2\n"));
+   P->pbuf = potion_asm_write(P, P->pbuf, "\"", 1); ;
+}
+YY_ACTION(void) yy_1_escc(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_escc\n"));
+   P->pbuf = potion_asm_write(P, P->pbuf, yytext, yyleng); ;
+}
+YY_ACTION(void) yy_1_escu(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_escu\n"));
+  
+  int nbuf = 0;
+  char utfc[4] = {0, 0, 0, 0};
+  unsigned long code = PN_ATOI(yytext, yyleng, 16);
+  if (code < 0x80) {
+    utfc[nbuf++] = code;
+  } else if (code < 0x7ff) {
+    utfc[nbuf++] = (code >> 6) | 0xc0;
+    utfc[nbuf++] = (code & 0x3f) | 0x80;
+  } else {
+    utfc[nbuf++] = (code >> 12) | 0xe0;
+    utfc[nbuf++] = ((code >> 6) & 0x3f) | 0x80;
+    utfc[nbuf++] = (code & 0x3f) | 0x80;
+  }
+  P->pbuf = potion_asm_write(P, P->pbuf, utfc, nbuf);
+;
+}
+YY_ACTION(void) yy_1_esct(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_esct\n"));
+   P->pbuf = potion_asm_write(P, P->pbuf, "\t", 1); ;
+}
+YY_ACTION(void) yy_1_escr(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_escr\n"));
+   P->pbuf = potion_asm_write(P, P->pbuf, "\r", 1); ;
+}
+YY_ACTION(void) yy_1_escf(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_escf\n"));
+   P->pbuf = potion_asm_write(P, P->pbuf, "\f", 1); ;
+}
+YY_ACTION(void) yy_1_escb(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_escb\n"));
+   P->pbuf = potion_asm_write(P, P->pbuf, "\b", 1); ;
+}
+YY_ACTION(void) yy_1_escn(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_escn\n"));
+   P->pbuf = potion_asm_write(P, P->pbuf, "\n", 1); ;
+}
+YY_ACTION(void) yy_3_str1(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_3_str1\n"));
+   yy = potion_bytes_string(P, PN_NIL, (PN)P->pbuf); ;
+}
+YY_ACTION(void) yy_2_str1(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_2_str1\n"));
+   P->pbuf = potion_asm_write(P, P->pbuf, "'", 1); ;
+}
+YY_ACTION(void) yy_1_str1(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_str1\n"));
+   P->pbuf = potion_asm_clear(P, P->pbuf); ;
+}
+YY_ACTION(void) yy_1_c1(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_c1\n"));
+   P->pbuf = potion_asm_write(P, P->pbuf, yytext, yyleng); ;
+}
+YY_ACTION(void) yy_3_dec(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_3_dec\n"));
+   yy = YY_TDEC ;
+}
+YY_ACTION(void) yy_2_dec(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_2_dec\n"));
+   yy = YY_TDEC; ;
+}
+YY_ACTION(void) yy_1_dec(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_dec\n"));
+   yy = YY_TNUM; ;
+}
+YY_ACTION(void) yy_5_immed(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_5_immed\n"));
+   if (yy == YY_TNUM && yyleng < 10) { 
+                  yy = PN_NUM(PN_ATOI(yytext, yyleng, 10));
+                } else {
+                  yy = potion_decimal(P, yytext, yyleng);
+              } ;
+}
+YY_ACTION(void) yy_4_immed(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_4_immed\n"));
+   yy = PN_NUM(PN_ATOI(yytext, yyleng, 16)); ;
+}
+YY_ACTION(void) yy_3_immed(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_3_immed\n"));
+   yy = PN_FALSE; ;
+}
+YY_ACTION(void) yy_2_immed(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_2_immed\n"));
+   yy = PN_TRUE; ;
+}
+YY_ACTION(void) yy_1_immed(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_immed\n"));
+   yy = PN_NIL; ;
+}
+YY_ACTION(void) yy_1_value(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define i G->val[-1]
+  yyprintf((stderr, "do yy_1_value\n"));
+   yy = PN_AST(VALUE, i); ;
+#undef i
+}
+YY_ACTION(void) yy_1_message(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_message\n"));
+   yy = potion_str2(P, yytext, yyleng); ;
+}
+YY_ACTION(void) yy_1_path(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+  yyprintf((stderr, "do yy_1_path\n"));
+   yy = potion_str2(P, yytext, yyleng); ;
+}
+YY_ACTION(void) yy_1_lick(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define i G->val[-1]
+  yyprintf((stderr, "do yy_1_lick\n"));
+   yy = PN_AST(TABLE, i); ;
+#undef i
+}
+YY_ACTION(void) yy_1_block(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s G->val[-1]
+  yyprintf((stderr, "do yy_1_block\n"));
+   yy = PN_AST(BLOCK, s); ;
+#undef s
+}
+YY_ACTION(void) yy_1_table(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s G->val[-1]
+  yyprintf((stderr, "do yy_1_table\n"));
+   yy = PN_AST(TABLE, s); ;
+#undef s
+}
+YY_ACTION(void) yy_1_closure(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define b G->val[-1]
+#define t G->val[-2]
+  yyprintf((stderr, "do yy_1_closure\n"));
+   yy = PN_AST2(PROTO, t, b); ;
+#undef b
+#undef t
+}
+YY_ACTION(void) yy_1_loose(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define v G->val[-1]
+  yyprintf((stderr, "do yy_1_loose\n"));
+   yy = PN_AST(VALUE, v); ;
+#undef v
+}
+YY_ACTION(void) yy_5_lick_item(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define v G->val[-1]
+#define t G->val[-2]
+#define m G->val[-3]
+  yyprintf((stderr, "do yy_5_lick_item\n"));
+   yy = PN_AST(LICK, m); ;
+#undef v
+#undef t
+#undef m
+}
+YY_ACTION(void) yy_4_lick_item(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define v G->val[-1]
+#define t G->val[-2]
+#define m G->val[-3]
+  yyprintf((stderr, "do yy_4_lick_item\n"));
+   yy = PN_AST2(LICK, m, v); ;
+#undef v
+#undef t
+#undef m
+}
+YY_ACTION(void) yy_3_lick_item(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define v G->val[-1]
+#define t G->val[-2]
+#define m G->val[-3]
+  yyprintf((stderr, "do yy_3_lick_item\n"));
+   yy = PN_AST3(LICK, m, v, t); ;
+#undef v
+#undef t
+#undef m
+}
+YY_ACTION(void) yy_2_lick_item(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define v G->val[-1]
+#define t G->val[-2]
+#define m G->val[-3]
+  yyprintf((stderr, "do yy_2_lick_item\n"));
+   yy = PN_AST3(LICK, m, PN_NIL, t); ;
+#undef v
+#undef t
+#undef m
+}
+YY_ACTION(void) yy_1_lick_item(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define v G->val[-1]
+#define t G->val[-2]
+#define m G->val[-3]
+  yyprintf((stderr, "do yy_1_lick_item\n"));
+   yy = PN_AST3(LICK, m, v, t); ;
+#undef v
+#undef t
+#undef m
+}
+YY_ACTION(void) yy_3_lick_items(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define i2 G->val[-1]
+#define i1 G->val[-2]
+  yyprintf((stderr, "do yy_3_lick_items\n"));
+   yy = PN_NIL; ;
+#undef i2
+#undef i1
+}
+YY_ACTION(void) yy_2_lick_items(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define i2 G->val[-1]
+#define i1 G->val[-2]
+  yyprintf((stderr, "do yy_2_lick_items\n"));
+   yy = i1 = PN_PUSH(i1, i2); ;
+#undef i2
+#undef i1
+}
+YY_ACTION(void) yy_1_lick_items(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define i2 G->val[-1]
+#define i1 G->val[-2]
+  yyprintf((stderr, "do yy_1_lick_items\n"));
+   yy = i1 = PN_TUP(i1); ;
+#undef i2
+#undef i1
+}
+YY_ACTION(void) yy_4_name(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define m G->val[-1]
+#define p G->val[-2]
+  yyprintf((stderr, "do yy_4_name\n"));
+   yy = PN_AST(MESSAGE, m); ;
+#undef m
+#undef p
+}
+YY_ACTION(void) yy_3_name(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define m G->val[-1]
+#define p G->val[-2]
+  yyprintf((stderr, "do yy_3_name\n"));
+   yy = PN_AST(PATHQ, p); ;
+#undef m
+#undef p
+}
+YY_ACTION(void) yy_2_name(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define m G->val[-1]
+#define p G->val[-2]
+  yyprintf((stderr, "do yy_2_name\n"));
+   yy = PN_AST(QUERY, m); ;
+#undef m
+#undef p
+}
+YY_ACTION(void) yy_1_name(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define m G->val[-1]
+#define p G->val[-2]
+  yyprintf((stderr, "do yy_1_name\n"));
+   yy = PN_AST(PATH, p); ;
+#undef m
+#undef p
+}
+YY_ACTION(void) yy_3_call(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define b G->val[-1]
+#define v G->val[-2]
+#define n G->val[-3]
+  yyprintf((stderr, "do yy_3_call\n"));
+   yy = n; PN_S(n, 1) = v; PN_S(n, 2) = b; PN_TOUCH(n); ;
+#undef b
+#undef v
+#undef n
+}
+YY_ACTION(void) yy_2_call(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define b G->val[-1]
+#define v G->val[-2]
+#define n G->val[-3]
+  yyprintf((stderr, "do yy_2_call\n"));
+   n = PN_AST(MESSAGE, PN_NIL); b = PN_NIL; ;
+#undef b
+#undef v
+#undef n
+}
+YY_ACTION(void) yy_1_call(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define b G->val[-1]
+#define v G->val[-2]
+#define n G->val[-3]
+  yyprintf((stderr, "do yy_1_call\n"));
+   v = PN_NIL; b = PN_NIL; ;
+#undef b
+#undef v
+#undef n
+}
+YY_ACTION(void) yy_7_expr(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define c G->val[-1]
+#define a G->val[-2]
+  yyprintf((stderr, "do yy_7_expr\n"));
+   yy = PN_AST(EXPR, a); ;
+#undef c
+#undef a
+}
+YY_ACTION(void) yy_6_expr(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define c G->val[-1]
+#define a G->val[-2]
+  yyprintf((stderr, "do yy_6_expr\n"));
+   a = PN_PUSH(a, c) ;
+#undef c
+#undef a
+}
+YY_ACTION(void) yy_5_expr(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define c G->val[-1]
+#define a G->val[-2]
+  yyprintf((stderr, "do yy_5_expr\n"));
+   a = PN_TUP(a); ;
+#undef c
+#undef a
+}
+YY_ACTION(void) yy_4_expr(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define c G->val[-1]
+#define a G->val[-2]
+  yyprintf((stderr, "do yy_4_expr\n"));
+   a = PN_OP(AST_INC, a, PN_NUM(-1)); ;
+#undef c
+#undef a
+}
+YY_ACTION(void) yy_3_expr(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define c G->val[-1]
+#define a G->val[-2]
+  yyprintf((stderr, "do yy_3_expr\n"));
+   a = PN_OP(AST_INC, a, PN_NUM(1)); ;
+#undef c
+#undef a
+}
+YY_ACTION(void) yy_2_expr(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define c G->val[-1]
+#define a G->val[-2]
+  yyprintf((stderr, "do yy_2_expr\n"));
+   a = PN_OP(AST_INC, a, PN_NUM(1) ^ 1); ;
+#undef c
+#undef a
+}
+YY_ACTION(void) yy_1_expr(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define c G->val[-1]
+#define a G->val[-2]
+  yyprintf((stderr, "do yy_1_expr\n"));
+   a = PN_OP(AST_INC, a, PN_NUM(-1) ^ 1); ;
+#undef c
+#undef a
+}
+YY_ACTION(void) yy_5_sign(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define e G->val[-1]
+#define s G->val[-2]
+  yyprintf((stderr, "do yy_5_sign\n"));
+   yy = e; ;
+#undef e
+#undef s
+}
+YY_ACTION(void) yy_4_sign(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define e G->val[-1]
+#define s G->val[-2]
+  yyprintf((stderr, "do yy_4_sign\n"));
+   yy = PN_AST(WAVY, s); ;
+#undef e
+#undef s
+}
+YY_ACTION(void) yy_3_sign(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define e G->val[-1]
+#define s G->val[-2]
+  yyprintf((stderr, "do yy_3_sign\n"));
+   yy = PN_AST(NOT, s); ;
+#undef e
+#undef s
+}
+YY_ACTION(void) yy_2_sign(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define e G->val[-1]
+#define s G->val[-2]
+  yyprintf((stderr, "do yy_2_sign\n"));
+   yy = PN_OP(AST_PLUS, PN_AST(VALUE, PN_ZERO), s); ;
+#undef e
+#undef s
+}
+YY_ACTION(void) yy_1_sign(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define e G->val[-1]
+#define s G->val[-2]
+  yyprintf((stderr, "do yy_1_sign\n"));
+   yy = PN_OP(AST_MINUS, PN_AST(VALUE, PN_ZERO), s); ;
+#undef e
+#undef s
+}
+YY_ACTION(void) yy_5_product(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define s G->val[-2]
+  yyprintf((stderr, "do yy_5_product\n"));
+   yy = s; ;
+#undef x
+#undef s
+}
+YY_ACTION(void) yy_4_product(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define s G->val[-2]
+  yyprintf((stderr, "do yy_4_product\n"));
+   s = PN_OP(AST_POW, s, x); ;
+#undef x
+#undef s
+}
+YY_ACTION(void) yy_3_product(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define s G->val[-2]
+  yyprintf((stderr, "do yy_3_product\n"));
+   s = PN_OP(AST_REM, s, x); ;
+#undef x
+#undef s
+}
+YY_ACTION(void) yy_2_product(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define s G->val[-2]
+  yyprintf((stderr, "do yy_2_product\n"));
+   s = PN_OP(AST_DIV, s, x); ;
+#undef x
+#undef s
+}
+YY_ACTION(void) yy_1_product(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define s G->val[-2]
+  yyprintf((stderr, "do yy_1_product\n"));
+   s = PN_OP(AST_TIMES, s, x); ;
+#undef x
+#undef s
+}
+YY_ACTION(void) yy_3_sum(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define p G->val[-2]
+  yyprintf((stderr, "do yy_3_sum\n"));
+   yy = p; ;
+#undef x
+#undef p
+}
+YY_ACTION(void) yy_2_sum(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define p G->val[-2]
+  yyprintf((stderr, "do yy_2_sum\n"));
+   p = PN_OP(AST_MINUS, p, x); ;
+#undef x
+#undef p
+}
+YY_ACTION(void) yy_1_sum(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define p G->val[-2]
+  yyprintf((stderr, "do yy_1_sum\n"));
+   p = PN_OP(AST_PLUS, p, x); ;
+#undef x
+#undef p
+}
+YY_ACTION(void) yy_3_bitshift(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define s G->val[-2]
+  yyprintf((stderr, "do yy_3_bitshift\n"));
+   yy = s; ;
+#undef x
+#undef s
+}
+YY_ACTION(void) yy_2_bitshift(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define s G->val[-2]
+  yyprintf((stderr, "do yy_2_bitshift\n"));
+   s = PN_OP(AST_BITR, s, x); ;
+#undef x
+#undef s
+}
+YY_ACTION(void) yy_1_bitshift(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define s G->val[-2]
+  yyprintf((stderr, "do yy_1_bitshift\n"));
+   s = PN_OP(AST_BITL, s, x); ;
+#undef x
+#undef s
+}
+YY_ACTION(void) yy_2_bitand(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define b G->val[-2]
+  yyprintf((stderr, "do yy_2_bitand\n"));
+   yy = b; ;
+#undef x
+#undef b
+}
+YY_ACTION(void) yy_1_bitand(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define b G->val[-2]
+  yyprintf((stderr, "do yy_1_bitand\n"));
+   b = PN_OP(AST_AMP, b, x); ;
+#undef x
+#undef b
+}
+YY_ACTION(void) yy_3_bitors(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define a G->val[-2]
+  yyprintf((stderr, "do yy_3_bitors\n"));
+   yy = a; ;
+#undef x
+#undef a
+}
+YY_ACTION(void) yy_2_bitors(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define a G->val[-2]
+  yyprintf((stderr, "do yy_2_bitors\n"));
+   a = PN_OP(AST_CARET, a, x); ;
+#undef x
+#undef a
+}
+YY_ACTION(void) yy_1_bitors(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define a G->val[-2]
+  yyprintf((stderr, "do yy_1_bitors\n"));
+   a = PN_OP(AST_PIPE, a, x); ;
+#undef x
+#undef a
+}
+YY_ACTION(void) yy_5_cmps(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define o G->val[-2]
+  yyprintf((stderr, "do yy_5_cmps\n"));
+   yy = o; ;
+#undef x
+#undef o
+}
+YY_ACTION(void) yy_4_cmps(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define o G->val[-2]
+  yyprintf((stderr, "do yy_4_cmps\n"));
+   o = PN_OP(AST_LT, o, x); ;
+#undef x
+#undef o
+}
+YY_ACTION(void) yy_3_cmps(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define o G->val[-2]
+  yyprintf((stderr, "do yy_3_cmps\n"));
+   o = PN_OP(AST_LTE, o, x); ;
+#undef x
+#undef o
+}
+YY_ACTION(void) yy_2_cmps(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define o G->val[-2]
+  yyprintf((stderr, "do yy_2_cmps\n"));
+   o = PN_OP(AST_GT, o, x); ;
+#undef x
+#undef o
+}
+YY_ACTION(void) yy_1_cmps(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define o G->val[-2]
+  yyprintf((stderr, "do yy_1_cmps\n"));
+   o = PN_OP(AST_GTE, o, x); ;
+#undef x
+#undef o
+}
+YY_ACTION(void) yy_4_eqs(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define c G->val[-2]
+  yyprintf((stderr, "do yy_4_eqs\n"));
+   yy = c; ;
+#undef x
+#undef c
+}
+YY_ACTION(void) yy_3_eqs(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define c G->val[-2]
+  yyprintf((stderr, "do yy_3_eqs\n"));
+   c = PN_OP(AST_NEQ, c, x); ;
+#undef x
+#undef c
+}
+YY_ACTION(void) yy_2_eqs(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define c G->val[-2]
+  yyprintf((stderr, "do yy_2_eqs\n"));
+   c = PN_OP(AST_EQ, c, x); ;
+#undef x
+#undef c
+}
+YY_ACTION(void) yy_1_eqs(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define c G->val[-2]
+  yyprintf((stderr, "do yy_1_eqs\n"));
+   c = PN_OP(AST_CMP, c, x); ;
+#undef x
+#undef c
+}
+YY_ACTION(void) yy_15_sets(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s G->val[-1]
+#define e G->val[-2]
+  yyprintf((stderr, "do yy_15_sets\n"));
+   yy = e; ;
+#undef s
+#undef e
+}
+YY_ACTION(void) yy_14_sets(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s G->val[-1]
+#define e G->val[-2]
+  yyprintf((stderr, "do yy_14_sets\n"));
+   e = PN_AST2(ASSIGN, e, PN_OP(AST_POW, e, s)); ;
+#undef s
+#undef e
+}
+YY_ACTION(void) yy_13_sets(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s G->val[-1]
+#define e G->val[-2]
+  yyprintf((stderr, "do yy_13_sets\n"));
+   e = PN_AST2(ASSIGN, e, PN_OP(AST_REM, e, s)); ;
+#undef s
+#undef e
+}
+YY_ACTION(void) yy_12_sets(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s G->val[-1]
+#define e G->val[-2]
+  yyprintf((stderr, "do yy_12_sets\n"));
+   e = PN_AST2(ASSIGN, e, PN_OP(AST_DIV, e, s)); ;
+#undef s
+#undef e
+}
+YY_ACTION(void) yy_11_sets(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s G->val[-1]
+#define e G->val[-2]
+  yyprintf((stderr, "do yy_11_sets\n"));
+   e = PN_AST2(ASSIGN, e, PN_OP(AST_TIMES, e, s)); ;
+#undef s
+#undef e
+}
+YY_ACTION(void) yy_10_sets(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s G->val[-1]
+#define e G->val[-2]
+  yyprintf((stderr, "do yy_10_sets\n"));
+   e = PN_AST2(ASSIGN, e, PN_OP(AST_MINUS, e, s)); ;
+#undef s
+#undef e
+}
+YY_ACTION(void) yy_9_sets(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s G->val[-1]
+#define e G->val[-2]
+  yyprintf((stderr, "do yy_9_sets\n"));
+   e = PN_AST2(ASSIGN, e, PN_OP(AST_PLUS, e, s)); ;
+#undef s
+#undef e
+}
+YY_ACTION(void) yy_8_sets(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s G->val[-1]
+#define e G->val[-2]
+  yyprintf((stderr, "do yy_8_sets\n"));
+   e = PN_AST2(ASSIGN, e, PN_OP(AST_BITR, e, s)); ;
+#undef s
+#undef e
+}
+YY_ACTION(void) yy_7_sets(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s G->val[-1]
+#define e G->val[-2]
+  yyprintf((stderr, "do yy_7_sets\n"));
+   e = PN_AST2(ASSIGN, e, PN_OP(AST_BITL, e, s)); ;
+#undef s
+#undef e
+}
+YY_ACTION(void) yy_6_sets(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s G->val[-1]
+#define e G->val[-2]
+  yyprintf((stderr, "do yy_6_sets\n"));
+   e = PN_AST2(ASSIGN, e, PN_OP(AST_AMP, e, s)); ;
+#undef s
+#undef e
+}
+YY_ACTION(void) yy_5_sets(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s G->val[-1]
+#define e G->val[-2]
+  yyprintf((stderr, "do yy_5_sets\n"));
+   e = PN_AST2(ASSIGN, e, PN_OP(AST_CARET, e, s)); ;
+#undef s
+#undef e
+}
+YY_ACTION(void) yy_4_sets(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s G->val[-1]
+#define e G->val[-2]
+  yyprintf((stderr, "do yy_4_sets\n"));
+   e = PN_AST2(ASSIGN, e, PN_OP(AST_PIPE, e, s)); ;
+#undef s
+#undef e
+}
+YY_ACTION(void) yy_3_sets(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s G->val[-1]
+#define e G->val[-2]
+  yyprintf((stderr, "do yy_3_sets\n"));
+   e = PN_AST2(ASSIGN, e, PN_OP(AST_OR, e, s)); ;
+#undef s
+#undef e
+}
+YY_ACTION(void) yy_2_sets(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s G->val[-1]
+#define e G->val[-2]
+  yyprintf((stderr, "do yy_2_sets\n"));
+   e = PN_AST2(ASSIGN, e, PN_OP(AST_OR, e, s)); ;
+#undef s
+#undef e
+}
+YY_ACTION(void) yy_1_sets(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s G->val[-1]
+#define e G->val[-2]
+  yyprintf((stderr, "do yy_1_sets\n"));
+   e = PN_AST2(ASSIGN, e, s); ;
+#undef s
+#undef e
+}
+YY_ACTION(void) yy_3_stmt(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define s G->val[-2]
+  yyprintf((stderr, "do yy_3_stmt\n"));
+   yy = s; ;
+#undef x
+#undef s
+}
+YY_ACTION(void) yy_2_stmt(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define s G->val[-2]
+  yyprintf((stderr, "do yy_2_stmt\n"));
+   s = PN_OP(AST_AND, s, x); ;
+#undef x
+#undef s
+}
+YY_ACTION(void) yy_1_stmt(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define x G->val[-1]
+#define s G->val[-2]
+  yyprintf((stderr, "do yy_1_stmt\n"));
+   s = PN_OP(AST_OR, s, x); ;
+#undef x
+#undef s
+}
+YY_ACTION(void) yy_3_statements(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s2 G->val[-1]
+#define s1 G->val[-2]
+  yyprintf((stderr, "do yy_3_statements\n"));
+   yy = PN_NIL; ;
+#undef s2
+#undef s1
+}
+YY_ACTION(void) yy_2_statements(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s2 G->val[-1]
+#define s1 G->val[-2]
+  yyprintf((stderr, "do yy_2_statements\n"));
+   yy = s1 = PN_PUSH(s1, s2); ;
+#undef s2
+#undef s1
+}
+YY_ACTION(void) yy_1_statements(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s2 G->val[-1]
+#define s1 G->val[-2]
+  yyprintf((stderr, "do yy_1_statements\n"));
+   yy = s1 = PN_TUP(s1); ;
+#undef s2
+#undef s1
+}
+YY_ACTION(void) yy_1_potion(GREG *G, char *yytext, int yyleng, YY_XTYPE YY_XVAR)
+{
+#define s G->val[-1]
+  yyprintf((stderr, "do yy_1_potion\n"));
+   yy = P->source = PN_AST(CODE, s); ;
+#undef s
+}
+
+YY_RULE(int) yy_arg_type(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "arg_type"));  yyText(G, G->begin, G->end);  if (!(YY_BEGIN)) goto l1;
+  {  int yypos2= G->pos, yythunkpos2= G->thunkpos;  if (!yymatchChar(G, 's')) goto l3;  goto l2;
+  l3:;	  G->pos= yypos2; G->thunkpos= yythunkpos2;  if (!yymatchChar(G, 'S')) goto l4;  goto l2;
+  l4:;	  G->pos= yypos2; G->thunkpos= yythunkpos2;  if (!yymatchChar(G, 'n')) goto l5;  goto l2;
+  l5:;	  G->pos= yypos2; G->thunkpos= yythunkpos2;  if (!yymatchChar(G, 'N')) goto l6;  goto l2;
+  l6:;	  G->pos= yypos2; G->thunkpos= yythunkpos2;  if (!yymatchChar(G, 'b')) goto l7;  goto l2;
+  l7:;	  G->pos= yypos2; G->thunkpos= yythunkpos2;  if (!yymatchChar(G, 'B')) goto l8;  goto l2;
+  l8:;	  G->pos= yypos2; G->thunkpos= yythunkpos2;  if (!yymatchChar(G, 'k')) goto l9;  goto l2;
+  l9:;	  G->pos= yypos2; G->thunkpos= yythunkpos2;  if (!yymatchChar(G, 't')) goto l10;  goto l2;
+  l10:;	  G->pos= yypos2; G->thunkpos= yythunkpos2;  if (!yymatchChar(G, 'o')) goto l11;  goto l2;
+  l11:;	  G->pos= yypos2; G->thunkpos= yythunkpos2;  if (!yymatchChar(G, 'O')) goto l12;  goto l2;
+  l12:;	  G->pos= yypos2; G->thunkpos= yythunkpos2;  if (!yymatchChar(G, '-')) goto l13;  goto l2;
+  l13:;	  G->pos= yypos2; G->thunkpos= yythunkpos2;  if (!yymatchChar(G, '&')) goto l1;
+  }
+  l2:;	  yyText(G, G->begin, G->end);  if (!(YY_END)) goto l1;  if (!yy__(G)) goto l1;  yyDo(G, yy_1_arg_type, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "arg_type", G->buf+G->pos));
+  return 1;
+  l1:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "arg_type", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_arg_name(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "arg_name"));  yyText(G, G->begin, G->end);  if (!(YY_BEGIN)) goto l14;  if (!yy_utfw(G)) goto l14;
+  l15:;	
+  {  int yypos16= G->pos, yythunkpos16= G->thunkpos;  if (!yy_utfw(G)) goto l16;  goto l15;
+  l16:;	  G->pos= yypos16; G->thunkpos= yythunkpos16;
+  }  yyText(G, G->begin, G->end);  if (!(YY_END)) goto l14;  if (!yy__(G)) goto l14;  yyDo(G, yy_1_arg_name, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "arg_name", G->buf+G->pos));
+  return 1;
+  l14:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "arg_name", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_arg(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "arg"));
+  {  int yypos18= G->pos, yythunkpos18= G->thunkpos;  if (!yy_arg_name(G)) goto l19;  yyDo(G, yySet, -2, 0);  if (!yy_assign(G)) goto l19;  if (!yy_arg_type(G)) goto l19;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_1_arg, G->begin, G->end);  goto l18;
+  l19:;	  G->pos= yypos18; G->thunkpos= yythunkpos18;  if (!yy_arg_type(G)) goto l17;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_2_arg, G->begin, G->end);
+  }
+  l18:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "arg", G->buf+G->pos));  yyDo(G, yyPop, 2, 0);
+  return 1;
+  l17:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "arg", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_optional(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "optional"));  if (!yymatchChar(G, '|')) goto l20;  if (!yy__(G)) goto l20;  yyDo(G, yy_1_optional, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "optional", G->buf+G->pos));
+  return 1;
+  l20:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "optional", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_arg_set(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "arg_set"));  if (!yy_arg(G)) goto l21;
+  l22:;	
+  {  int yypos23= G->pos, yythunkpos23= G->thunkpos;  if (!yy_comma(G)) goto l23;  if (!yy__(G)) goto l23;  if (!yy_arg(G)) goto l23;  goto l22;
+  l23:;	  G->pos= yypos23; G->thunkpos= yythunkpos23;
+  }
+  yyprintf((stderr, "  ok   %s @ %s\n", "arg_set", G->buf+G->pos));
+  return 1;
+  l21:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "arg_set", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_arg_sep(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "arg_sep"));  if (!yymatchChar(G, '.')) goto l24;  if (!yy__(G)) goto l24;  yyDo(G, yy_1_arg_sep, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "arg_sep", G->buf+G->pos));
+  return 1;
+  l24:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "arg_sep", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_arg_list(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "arg_list"));
+  {  int yypos26= G->pos, yythunkpos26= G->thunkpos;  if (!yy_arg_set(G)) goto l27;
+  {  int yypos28= G->pos, yythunkpos28= G->thunkpos;  if (!yy_optional(G)) goto l28;  if (!yy_arg_set(G)) goto l28;  goto l29;
+  l28:;	  G->pos= yypos28; G->thunkpos= yythunkpos28;
+  }
+  l29:;	  goto l26;
+  l27:;	  G->pos= yypos26; G->thunkpos= yythunkpos26;  if (!yy_optional(G)) goto l25;  if (!yy_arg_set(G)) goto l25;
+  }
+  l26:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "arg_list", G->buf+G->pos));
+  return 1;
+  l25:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "arg_list", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_args(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "args"));  if (!yy_arg_list(G)) goto l30;
+  l31:;	
+  {  int yypos32= G->pos, yythunkpos32= G->thunkpos;  if (!yy_arg_sep(G)) goto l32;  if (!yy_arg_list(G)) goto l32;  goto l31;
+  l32:;	  G->pos= yypos32; G->thunkpos= yythunkpos32;
+  }
+  yyprintf((stderr, "  ok   %s @ %s\n", "args", G->buf+G->pos));
+  return 1;
+  l30:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "args", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_sig(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "sig"));  if (!yy_args(G)) goto l33;
+  l34:;	
+  {  int yypos35= G->pos, yythunkpos35= G->thunkpos;  if (!yy_args(G)) goto l35;  goto l34;
+  l35:;	  G->pos= yypos35; G->thunkpos= yythunkpos35;
+  }  if (!yy_end_of_file(G)) goto l33;
+  yyprintf((stderr, "  ok   %s @ %s\n", "sig", G->buf+G->pos));
+  return 1;
+  l33:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "sig", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_end_of_line(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "end_of_line"));
+  {  int yypos37= G->pos, yythunkpos37= G->thunkpos;  if (!yymatchString(G, "\r\n")) goto l38;  goto l37;
+  l38:;	  G->pos= yypos37; G->thunkpos= yythunkpos37;  if (!yymatchChar(G, '\n')) goto l39;  goto l37;
+  l39:;	  G->pos= yypos37; G->thunkpos= yythunkpos37;  if (!yymatchChar(G, '\r')) goto l36;
+  }
+  l37:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "end_of_line", G->buf+G->pos));
+  return 1;
+  l36:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "end_of_line", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_comment(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "comment"));  if (!yymatchChar(G, '#')) goto l40;
+  l41:;	
+  {  int yypos42= G->pos, yythunkpos42= G->thunkpos;
+  {  int yypos43= G->pos, yythunkpos43= G->thunkpos;  if (!yy_end_of_line(G)) goto l43;  goto l42;
+  l43:;	  G->pos= yypos43; G->thunkpos= yythunkpos43;
+  }  if (!yy_utf8(G)) goto l42;  goto l41;
+  l42:;	  G->pos= yypos42; G->thunkpos= yythunkpos42;
+  }
+  yyprintf((stderr, "  ok   %s @ %s\n", "comment", G->buf+G->pos));
+  return 1;
+  l40:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "comment", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_space(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "space"));
+  {  int yypos45= G->pos, yythunkpos45= G->thunkpos;  if (!yymatchChar(G, ' ')) goto l46;  goto l45;
+  l46:;	  G->pos= yypos45; G->thunkpos= yythunkpos45;  if (!yymatchChar(G, '\f')) goto l47;  goto l45;
+  l47:;	  G->pos= yypos45; G->thunkpos= yythunkpos45;  if (!yymatchChar(G, '\v')) goto l48;  goto l45;
+  l48:;	  G->pos= yypos45; G->thunkpos= yythunkpos45;  if (!yymatchChar(G, '\t')) goto l44;
+  }
+  l45:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "space", G->buf+G->pos));
+  return 1;
+  l44:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "space", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_unq_sep(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "unq_sep"));  if (!yy_sep(G)) goto l49;
+  {  int yypos50= G->pos, yythunkpos50= G->thunkpos;  if (!yymatchChar(G, '{')) goto l50;  goto l49;
+  l50:;	  G->pos= yypos50; G->thunkpos= yythunkpos50;
+  }
+  {  int yypos51= G->pos, yythunkpos51= G->thunkpos;  if (!yymatchChar(G, '[')) goto l51;  goto l49;
+  l51:;	  G->pos= yypos51; G->thunkpos= yythunkpos51;
+  }
+  {  int yypos52= G->pos, yythunkpos52= G->thunkpos;  if (!yymatchChar(G, '(')) goto l52;  goto l49;
+  l52:;	  G->pos= yypos52; G->thunkpos= yythunkpos52;
+  }
+  yyprintf((stderr, "  ok   %s @ %s\n", "unq_sep", G->buf+G->pos));
+  return 1;
+  l49:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "unq_sep", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_unq_char(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "unq_char"));
+  {  int yypos54= G->pos, yythunkpos54= G->thunkpos;  if (!yymatchChar(G, '{')) goto l55;  if (!yy_unq_char(G)) goto l55;
+  l56:;	
+  {  int yypos57= G->pos, yythunkpos57= G->thunkpos;  if (!yy_unq_char(G)) goto l57;  goto l56;
+  l57:;	  G->pos= yypos57; G->thunkpos= yythunkpos57;
+  }  if (!yymatchChar(G, '}')) goto l55;  goto l54;
+  l55:;	  G->pos= yypos54; G->thunkpos= yythunkpos54;  if (!yymatchChar(G, '[')) goto l58;  if (!yy_unq_char(G)) goto l58;
+  l59:;	
+  {  int yypos60= G->pos, yythunkpos60= G->thunkpos;  if (!yy_unq_char(G)) goto l60;  goto l59;
+  l60:;	  G->pos= yypos60; G->thunkpos= yythunkpos60;
+  }  if (!yymatchChar(G, ']')) goto l58;  goto l54;
+  l58:;	  G->pos= yypos54; G->thunkpos= yythunkpos54;  if (!yymatchChar(G, '(')) goto l61;  if (!yy_unq_char(G)) goto l61;
+  l62:;	
+  {  int yypos63= G->pos, yythunkpos63= G->thunkpos;  if (!yy_unq_char(G)) goto l63;  goto l62;
+  l63:;	  G->pos= yypos63; G->thunkpos= yythunkpos63;
+  }  if (!yymatchChar(G, ')')) goto l61;  goto l54;
+  l61:;	  G->pos= yypos54; G->thunkpos= yythunkpos54;
+  {  int yypos64= G->pos, yythunkpos64= G->thunkpos;  if (!yymatchChar(G, '{')) goto l64;  goto l53;
+  l64:;	  G->pos= yypos64; G->thunkpos= yythunkpos64;
+  }
+  {  int yypos65= G->pos, yythunkpos65= G->thunkpos;  if (!yymatchChar(G, '[')) goto l65;  goto l53;
+  l65:;	  G->pos= yypos65; G->thunkpos= yythunkpos65;
+  }
+  {  int yypos66= G->pos, yythunkpos66= G->thunkpos;  if (!yymatchChar(G, '(')) goto l66;  goto l53;
+  l66:;	  G->pos= yypos66; G->thunkpos= yythunkpos66;
+  }
+  {  int yypos67= G->pos, yythunkpos67= G->thunkpos;  if (!yymatchChar(G, '}')) goto l67;  goto l53;
+  l67:;	  G->pos= yypos67; G->thunkpos= yythunkpos67;
+  }
+  {  int yypos68= G->pos, yythunkpos68= G->thunkpos;  if (!yymatchChar(G, ']')) goto l68;  goto l53;
+  l68:;	  G->pos= yypos68; G->thunkpos= yythunkpos68;
+  }
+  {  int yypos69= G->pos, yythunkpos69= G->thunkpos;  if (!yymatchChar(G, ')')) goto l69;  goto l53;
+  l69:;	  G->pos= yypos69; G->thunkpos= yythunkpos69;
+  }  if (!yy_utf8(G)) goto l53;
+  }
+  l54:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "unq_char", G->buf+G->pos));
+  return 1;
+  l53:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "unq_char", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_c2(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "c2"));  yyText(G, G->begin, G->end);  if (!(YY_BEGIN)) goto l70;
+  {  int yypos73= G->pos, yythunkpos73= G->thunkpos;  if (!yy_q2(G)) goto l73;  goto l70;
+  l73:;	  G->pos= yypos73; G->thunkpos= yythunkpos73;
+  }
+  {  int yypos74= G->pos, yythunkpos74= G->thunkpos;  if (!yy_esc(G)) goto l74;  goto l70;
+  l74:;	  G->pos= yypos74; G->thunkpos= yythunkpos74;
+  }  if (!yy_utf8(G)) goto l70;
+  l71:;	
+  {  int yypos72= G->pos, yythunkpos72= G->thunkpos;
+  {  int yypos75= G->pos, yythunkpos75= G->thunkpos;  if (!yy_q2(G)) goto l75;  goto l72;
+  l75:;	  G->pos= yypos75; G->thunkpos= yythunkpos75;
+  }
+  {  int yypos76= G->pos, yythunkpos76= G->thunkpos;  if (!yy_esc(G)) goto l76;  goto l72;
+  l76:;	  G->pos= yypos76; G->thunkpos= yythunkpos76;
+  }  if (!yy_utf8(G)) goto l72;  goto l71;
+  l72:;	  G->pos= yypos72; G->thunkpos= yythunkpos72;
+  }  yyText(G, G->begin, G->end);  if (!(YY_END)) goto l70;  yyDo(G, yy_1_c2, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "c2", G->buf+G->pos));
+  return 1;
+  l70:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "c2", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_e2(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "e2"));  if (!yymatchChar(G, '\\')) goto l77;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\004\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000")) goto l77;  yyDo(G, yy_1_e2, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "e2", G->buf+G->pos));
+  return 1;
+  l77:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "e2", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_q2(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "q2"));  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\004\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000")) goto l78;
+  yyprintf((stderr, "  ok   %s @ %s\n", "q2", G->buf+G->pos));
+  return 1;
+  l78:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "q2", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_escc(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "escc"));  if (!yy_esc(G)) goto l79;  yyText(G, G->begin, G->end);  if (!(YY_BEGIN)) goto l79;  if (!yy_utf8(G)) goto l79;  yyText(G, G->begin, G->end);  if (!(YY_END)) goto l79;  yyDo(G, yy_1_escc, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "escc", G->buf+G->pos));
+  return 1;
+  l79:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "escc", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_escu(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "escu"));  if (!yy_esc(G)) goto l80;  if (!yymatchChar(G, 'u')) goto l80;  yyText(G, G->begin, G->end);  if (!(YY_BEGIN)) goto l80;  if (!yy_hexl(G)) goto l80;  if (!yy_hexl(G)) goto l80;  if (!yy_hexl(G)) goto l80;  if (!yy_hexl(G)) goto l80;  yyText(G, G->begin, G->end);  if (!(YY_END)) goto l80;  yyDo(G, yy_1_escu, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "escu", G->buf+G->pos));
+  return 1;
+  l80:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "escu", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_esct(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "esct"));  if (!yy_esc(G)) goto l81;  if (!yymatchChar(G, 't')) goto l81;  yyDo(G, yy_1_esct, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "esct", G->buf+G->pos));
+  return 1;
+  l81:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "esct", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_escr(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "escr"));  if (!yy_esc(G)) goto l82;  if (!yymatchChar(G, 'r')) goto l82;  yyDo(G, yy_1_escr, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "escr", G->buf+G->pos));
+  return 1;
+  l82:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "escr", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_escf(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "escf"));  if (!yy_esc(G)) goto l83;  if (!yymatchChar(G, 'f')) goto l83;  yyDo(G, yy_1_escf, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "escf", G->buf+G->pos));
+  return 1;
+  l83:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "escf", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_escb(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "escb"));  if (!yy_esc(G)) goto l84;  if (!yymatchChar(G, 'b')) goto l84;  yyDo(G, yy_1_escb, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "escb", G->buf+G->pos));
+  return 1;
+  l84:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "escb", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_escn(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "escn"));  if (!yy_esc(G)) goto l85;  if (!yymatchChar(G, 'n')) goto l85;  yyDo(G, yy_1_escn, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "escn", G->buf+G->pos));
+  return 1;
+  l85:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "escn", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_esc(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "esc"));  if (!yymatchChar(G, '\\')) goto l86;
+  yyprintf((stderr, "  ok   %s @ %s\n", "esc", G->buf+G->pos));
+  return 1;
+  l86:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "esc", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_c1(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "c1"));  yyText(G, G->begin, G->end);  if (!(YY_BEGIN)) goto l87;
+  {  int yypos90= G->pos, yythunkpos90= G->thunkpos;  if (!yy_q1(G)) goto l90;  goto l87;
+  l90:;	  G->pos= yypos90; G->thunkpos= yythunkpos90;
+  }  if (!yy_utf8(G)) goto l87;
+  l88:;	
+  {  int yypos89= G->pos, yythunkpos89= G->thunkpos;
+  {  int yypos91= G->pos, yythunkpos91= G->thunkpos;  if (!yy_q1(G)) goto l91;  goto l89;
+  l91:;	  G->pos= yypos91; G->thunkpos= yythunkpos91;
+  }  if (!yy_utf8(G)) goto l89;  goto l88;
+  l89:;	  G->pos= yypos89; G->thunkpos= yythunkpos89;
+  }  yyText(G, G->begin, G->end);  if (!(YY_END)) goto l87;  yyDo(G, yy_1_c1, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "c1", G->buf+G->pos));
+  return 1;
+  l87:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "c1", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_q1(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "q1"));  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\200\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000")) goto l92;
+  yyprintf((stderr, "  ok   %s @ %s\n", "q1", G->buf+G->pos));
+  return 1;
+  l92:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "q1", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_hexl(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "hexl"));  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\377\003\176\000\000\000\176\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000")) goto l93;
+  yyprintf((stderr, "  ok   %s @ %s\n", "hexl", G->buf+G->pos));
+  return 1;
+  l93:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "hexl", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_comma(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "comma"));  if (!yymatchChar(G, ',')) goto l94;
+  yyprintf((stderr, "  ok   %s @ %s\n", "comma", G->buf+G->pos));
+  return 1;
+  l94:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "comma", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_utf8(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "utf8"));
+  {  int yypos96= G->pos, yythunkpos96= G->thunkpos;  if (!yymatchClass(G, (unsigned char *)"\000\046\000\000\377\377\377\377\377\377\377\377\377\377\377\177\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000")) goto l97;  goto l96;
+  l97:;	  G->pos= yypos96; G->thunkpos= yythunkpos96;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\374\377\377\377\000\000\000\000")) goto l98;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\377\377\377\377\377\377\377\377\000\000\000\000\000\000\000\000")) goto l98;  goto l96;
+  l98:;	  G->pos= yypos96; G->thunkpos= yythunkpos96;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\377\377\000\000")) goto l99;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\377\377\377\377\377\377\377\377\000\000\000\000\000\000\000\000")) goto l99;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\377\377\377\377\377\377\377\377\000\000\000\000\000\000\000\000")) goto l99;  goto l96;
+  l99:;	  G->pos= yypos96; G->thunkpos= yythunkpos96;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\037\000")) goto l95;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\377\377\377\377\377\377\377\377\000\000\000\000\000\000\000\000")) goto l95;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\377\377\377\377\377\377\377\377\000\000\000\000\000\000\000\000")) goto l95;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\377\377\377\377\377\377\377\377\000\000\000\000\000\000\000\000")) goto l95;
+  }
+  l96:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "utf8", G->buf+G->pos));
+  return 1;
+  l95:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "utf8", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_str2(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "str2"));  if (!yy_q2(G)) goto l100;  yyDo(G, yy_1_str2, G->begin, G->end);  yyText(G, G->begin, G->end);  if (!(YY_BEGIN)) goto l100;
+  l101:;	
+  {  int yypos102= G->pos, yythunkpos102= G->thunkpos;
+  {  int yypos103= G->pos, yythunkpos103= G->thunkpos;  if (!yy_e2(G)) goto l104;  goto l103;
+  l104:;	  G->pos= yypos103; G->thunkpos= yythunkpos103;  if (!yy_escn(G)) goto l105;  goto l103;
+  l105:;	  G->pos= yypos103; G->thunkpos= yythunkpos103;  if (!yy_escb(G)) goto l106;  goto l103;
+  l106:;	  G->pos= yypos103; G->thunkpos= yythunkpos103;  if (!yy_escf(G)) goto l107;  goto l103;
+  l107:;	  G->pos= yypos103; G->thunkpos= yythunkpos103;  if (!yy_escr(G)) goto l108;  goto l103;
+  l108:;	  G->pos= yypos103; G->thunkpos= yythunkpos103;  if (!yy_esct(G)) goto l109;  goto l103;
+  l109:;	  G->pos= yypos103; G->thunkpos= yythunkpos103;  if (!yy_escu(G)) goto l110;  goto l103;
+  l110:;	  G->pos= yypos103; G->thunkpos= yythunkpos103;  if (!yy_escc(G)) goto l111;  goto l103;
+  l111:;	  G->pos= yypos103; G->thunkpos= yythunkpos103;  if (!yy_c2(G)) goto l102;
+  }
+  l103:;	  goto l101;
+  l102:;	  G->pos= yypos102; G->thunkpos= yythunkpos102;
+  }  yyText(G, G->begin, G->end);  if (!(YY_END)) goto l100;  if (!yy_q2(G)) goto l100;  yyDo(G, yy_2_str2, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "str2", G->buf+G->pos));
+  return 1;
+  l100:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "str2", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_str1(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "str1"));  if (!yy_q1(G)) goto l112;  yyDo(G, yy_1_str1, G->begin, G->end);  yyText(G, G->begin, G->end);  if (!(YY_BEGIN)) goto l112;
+  l113:;	
+  {  int yypos114= G->pos, yythunkpos114= G->thunkpos;
+  {  int yypos115= G->pos, yythunkpos115= G->thunkpos;  if (!yy_q1(G)) goto l116;  if (!yy_q1(G)) goto l116;  yyDo(G, yy_2_str1, G->begin, G->end);  goto l115;
+  l116:;	  G->pos= yypos115; G->thunkpos= yythunkpos115;  if (!yy_c1(G)) goto l114;
+  }
+  l115:;	  goto l113;
+  l114:;	  G->pos= yypos114; G->thunkpos= yythunkpos114;
+  }  yyText(G, G->begin, G->end);  if (!(YY_END)) goto l112;  if (!yy_q1(G)) goto l112;  yyDo(G, yy_3_str1, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "str1", G->buf+G->pos));
+  return 1;
+  l112:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "str1", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_dec(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "dec"));  yyText(G, G->begin, G->end);  if (!(YY_BEGIN)) goto l117;
+  {  int yypos118= G->pos, yythunkpos118= G->thunkpos;  if (!yymatchChar(G, '0')) goto l119;  goto l118;
+  l119:;	  G->pos= yypos118; G->thunkpos= yythunkpos118;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\376\003\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000")) goto l117;
+  l120:;	
+  {  int yypos121= G->pos, yythunkpos121= G->thunkpos;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\377\003\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000")) goto l121;  goto l120;
+  l121:;	  G->pos= yypos121; G->thunkpos= yythunkpos121;
+  }
+  }
+  l118:;	  yyDo(G, yy_1_dec, G->begin, G->end);
+  {  int yypos122= G->pos, yythunkpos122= G->thunkpos;  if (!yymatchChar(G, '.')) goto l122;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\377\003\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000")) goto l122;
+  l124:;	
+  {  int yypos125= G->pos, yythunkpos125= G->thunkpos;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\377\003\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000")) goto l125;  goto l124;
+  l125:;	  G->pos= yypos125; G->thunkpos= yythunkpos125;
+  }  yyDo(G, yy_2_dec, G->begin, G->end);  goto l123;
+  l122:;	  G->pos= yypos122; G->thunkpos= yythunkpos122;
+  }
+  l123:;	
+  {  int yypos126= G->pos, yythunkpos126= G->thunkpos;  if (!yymatchChar(G, 'e')) goto l126;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\050\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000")) goto l126;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\377\003\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000")) goto l126;
+  l128:;	
+  {  int yypos129= G->pos, yythunkpos129= G->thunkpos;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\377\003\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000")) goto l129;  goto l128;
+  l129:;	  G->pos= yypos129; G->thunkpos= yythunkpos129;
+  }  yyDo(G, yy_3_dec, G->begin, G->end);  goto l127;
+  l126:;	  G->pos= yypos126; G->thunkpos= yythunkpos126;
+  }
+  l127:;	  yyText(G, G->begin, G->end);  if (!(YY_END)) goto l117;
+  yyprintf((stderr, "  ok   %s @ %s\n", "dec", G->buf+G->pos));
+  return 1;
+  l117:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "dec", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_hex(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "hex"));  if (!yymatchString(G, "0x")) goto l130;  yyText(G, G->begin, G->end);  if (!(YY_BEGIN)) goto l130;  if (!yy_hexl(G)) goto l130;
+  l131:;	
+  {  int yypos132= G->pos, yythunkpos132= G->thunkpos;  if (!yy_hexl(G)) goto l132;  goto l131;
+  l132:;	  G->pos= yypos132; G->thunkpos= yythunkpos132;
+  }  yyText(G, G->begin, G->end);  if (!(YY_END)) goto l130;
+  yyprintf((stderr, "  ok   %s @ %s\n", "hex", G->buf+G->pos));
+  return 1;
+  l130:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "hex", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_false(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "false"));  if (!yymatchString(G, "false")) goto l133;
+  {  int yypos134= G->pos, yythunkpos134= G->thunkpos;  if (!yy_utfw(G)) goto l134;  goto l133;
+  l134:;	  G->pos= yypos134; G->thunkpos= yythunkpos134;
+  }
+  yyprintf((stderr, "  ok   %s @ %s\n", "false", G->buf+G->pos));
+  return 1;
+  l133:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "false", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_true(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "true"));  if (!yymatchString(G, "true")) goto l135;
+  {  int yypos136= G->pos, yythunkpos136= G->thunkpos;  if (!yy_utfw(G)) goto l136;  goto l135;
+  l136:;	  G->pos= yypos136; G->thunkpos= yythunkpos136;
+  }
+  yyprintf((stderr, "  ok   %s @ %s\n", "true", G->buf+G->pos));
+  return 1;
+  l135:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "true", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_nil(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "nil"));  if (!yymatchString(G, "nil")) goto l137;
+  {  int yypos138= G->pos, yythunkpos138= G->thunkpos;  if (!yy_utfw(G)) goto l138;  goto l137;
+  l138:;	  G->pos= yypos138; G->thunkpos= yythunkpos138;
+  }
+  yyprintf((stderr, "  ok   %s @ %s\n", "nil", G->buf+G->pos));
+  return 1;
+  l137:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "nil", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_immed(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "immed"));
+  {  int yypos140= G->pos, yythunkpos140= G->thunkpos;  if (!yy_nil(G)) goto l141;  yyDo(G, yy_1_immed, G->begin, G->end);  goto l140;
+  l141:;	  G->pos= yypos140; G->thunkpos= yythunkpos140;  if (!yy_true(G)) goto l142;  yyDo(G, yy_2_immed, G->begin, G->end);  goto l140;
+  l142:;	  G->pos= yypos140; G->thunkpos= yythunkpos140;  if (!yy_false(G)) goto l143;  yyDo(G, yy_3_immed, G->begin, G->end);  goto l140;
+  l143:;	  G->pos= yypos140; G->thunkpos= yythunkpos140;  if (!yy_hex(G)) goto l144;  yyDo(G, yy_4_immed, G->begin, G->end);  goto l140;
+  l144:;	  G->pos= yypos140; G->thunkpos= yythunkpos140;  if (!yy_dec(G)) goto l145;  yyDo(G, yy_5_immed, G->begin, G->end);  goto l140;
+  l145:;	  G->pos= yypos140; G->thunkpos= yythunkpos140;  if (!yy_str1(G)) goto l146;  goto l140;
+  l146:;	  G->pos= yypos140; G->thunkpos= yythunkpos140;  if (!yy_str2(G)) goto l139;
+  }
+  l140:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "immed", G->buf+G->pos));
+  return 1;
+  l139:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "immed", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy__(GREG *G)
+{
+  yyprintf((stderr, "%s\n", "_"));
+  l148:;	
+  {  int yypos149= G->pos, yythunkpos149= G->thunkpos;
+  {  int yypos150= G->pos, yythunkpos150= G->thunkpos;  if (!yy_space(G)) goto l151;  goto l150;
+  l151:;	  G->pos= yypos150; G->thunkpos= yythunkpos150;  if (!yy_comment(G)) goto l149;
+  }
+  l150:;	  goto l148;
+  l149:;	  G->pos= yypos149; G->thunkpos= yythunkpos149;
+  }
+  yyprintf((stderr, "  ok   %s @ %s\n", "_", G->buf+G->pos));
+  return 1;
+}
+YY_RULE(int) yy_utfw(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "utfw"));
+  {  int yypos153= G->pos, yythunkpos153= G->thunkpos;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\020\000\377\013\377\377\377\207\377\377\377\057\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000")) goto l154;  goto l153;
+  l154:;	  G->pos= yypos153; G->thunkpos= yythunkpos153;  if (!yymatchString(G, "\304")) goto l155;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\377\377\377\000\000\000\000\000\000\000\000")) goto l155;  goto l153;
+  l155:;	  G->pos= yypos153; G->thunkpos= yythunkpos153;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\340\377\377\377\000\000\000\000")) goto l156;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\377\377\377\377\377\377\377\377\000\000\000\000\000\000\000\000")) goto l156;  goto l153;
+  l156:;	  G->pos= yypos153; G->thunkpos= yythunkpos153;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\377\377\000\000")) goto l157;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\377\377\377\377\377\377\377\377\000\000\000\000\000\000\000\000")) goto l157;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\377\377\377\377\377\377\377\377\000\000\000\000\000\000\000\000")) goto l157;  goto l153;
+  l157:;	  G->pos= yypos153; G->thunkpos= yythunkpos153;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\037\000")) goto l152;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\377\377\377\377\377\377\377\377\000\000\000\000\000\000\000\000")) goto l152;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\377\377\377\377\377\377\377\377\000\000\000\000\000\000\000\000")) goto l152;  if (!yymatchClass(G, (unsigned char *)"\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\377\377\377\377\377\377\377\377\000\000\000\000\000\000\000\000")) goto l152;
+  }
+  l153:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "utfw", G->buf+G->pos));
+  return 1;
+  l152:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "utfw", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_lick_end(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "lick_end"));  if (!yymatchChar(G, ']')) goto l158;  if (!yy__(G)) goto l158;
+  yyprintf((stderr, "  ok   %s @ %s\n", "lick_end", G->buf+G->pos));
+  return 1;
+  l158:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "lick_end", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_lick_start(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "lick_start"));  if (!yymatchChar(G, '[')) goto l159;  if (!yy___(G)) goto l159;
+  yyprintf((stderr, "  ok   %s @ %s\n", "lick_start", G->buf+G->pos));
+  return 1;
+  l159:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "lick_start", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_lick(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 1, 0);
+  yyprintf((stderr, "%s\n", "lick"));  if (!yy_lick_start(G)) goto l160;  if (!yy_lick_items(G)) goto l160;  yyDo(G, yySet, -1, 0);  if (!yy_lick_end(G)) goto l160;  yyDo(G, yy_1_lick, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "lick", G->buf+G->pos));  yyDo(G, yyPop, 1, 0);
+  return 1;
+  l160:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "lick", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_block_end(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "block_end"));  if (!yymatchChar(G, '.')) goto l161;  if (!yy__(G)) goto l161;
+  yyprintf((stderr, "  ok   %s @ %s\n", "block_end", G->buf+G->pos));
+  return 1;
+  l161:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "block_end", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_block_start(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "block_start"));  if (!yymatchChar(G, ':')) goto l162;  if (!yy___(G)) goto l162;
+  yyprintf((stderr, "  ok   %s @ %s\n", "block_start", G->buf+G->pos));
+  return 1;
+  l162:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "block_start", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_table_end(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "table_end"));  if (!yymatchChar(G, ')')) goto l163;  if (!yy__(G)) goto l163;
+  yyprintf((stderr, "  ok   %s @ %s\n", "table_end", G->buf+G->pos));
+  return 1;
+  l163:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "table_end", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_table_start(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "table_start"));  if (!yymatchChar(G, '(')) goto l164;  if (!yy___(G)) goto l164;
+  yyprintf((stderr, "  ok   %s @ %s\n", "table_start", G->buf+G->pos));
+  return 1;
+  l164:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "table_start", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_unquoted(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "unquoted"));  yyText(G, G->begin, G->end);  if (!(YY_BEGIN)) goto l165;
+  {  int yypos168= G->pos, yythunkpos168= G->thunkpos;  if (!yy_unq_sep(G)) goto l168;  goto l165;
+  l168:;	  G->pos= yypos168; G->thunkpos= yythunkpos168;
+  }
+  {  int yypos169= G->pos, yythunkpos169= G->thunkpos;  if (!yy_lick_end(G)) goto l169;  goto l165;
+  l169:;	  G->pos= yypos169; G->thunkpos= yythunkpos169;
+  }  if (!yy_unq_char(G)) goto l165;
+  l166:;	
+  {  int yypos167= G->pos, yythunkpos167= G->thunkpos;
+  {  int yypos170= G->pos, yythunkpos170= G->thunkpos;  if (!yy_unq_sep(G)) goto l170;  goto l167;
+  l170:;	  G->pos= yypos170; G->thunkpos= yythunkpos170;
+  }
+  {  int yypos171= G->pos, yythunkpos171= G->thunkpos;  if (!yy_lick_end(G)) goto l171;  goto l167;
+  l171:;	  G->pos= yypos171; G->thunkpos= yythunkpos171;
+  }  if (!yy_unq_char(G)) goto l167;  goto l166;
+  l167:;	  G->pos= yypos167; G->thunkpos= yythunkpos167;
+  }  yyText(G, G->begin, G->end);  if (!(YY_END)) goto l165;  yyDo(G, yy_1_unquoted, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "unquoted", G->buf+G->pos));
+  return 1;
+  l165:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "unquoted", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_loose(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 1, 0);
+  yyprintf((stderr, "%s\n", "loose"));
+  {  int yypos173= G->pos, yythunkpos173= G->thunkpos;  if (!yy_value(G)) goto l174;  goto l173;
+  l174:;	  G->pos= yypos173; G->thunkpos= yythunkpos173;  if (!yy_unquoted(G)) goto l172;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_1_loose, G->begin, G->end);
+  }
+  l173:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "loose", G->buf+G->pos));  yyDo(G, yyPop, 1, 0);
+  return 1;
+  l172:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "loose", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_lick_item(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 3, 0);
+  yyprintf((stderr, "%s\n", "lick_item"));
+  {  int yypos176= G->pos, yythunkpos176= G->thunkpos;  if (!yy_message(G)) goto l177;  yyDo(G, yySet, -3, 0);  if (!yy_table(G)) goto l177;  yyDo(G, yySet, -2, 0);  if (!yy_loose(G)) goto l177;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_1_lick_item, G->begin, G->end);  goto l176;
+  l177:;	  G->pos= yypos176; G->thunkpos= yythunkpos176;  if (!yy_message(G)) goto l178;  yyDo(G, yySet, -3, 0);  if (!yy_table(G)) goto l178;  yyDo(G, yySet, -2, 0);  yyDo(G, yy_2_lick_item, G->begin, G->end);  goto l176;
+  l178:;	  G->pos= yypos176; G->thunkpos= yythunkpos176;  if (!yy_message(G)) goto l179;  yyDo(G, yySet, -3, 0);  if (!yy_loose(G)) goto l179;  yyDo(G, yySet, -1, 0);  if (!yy_table(G)) goto l179;  yyDo(G, yySet, -2, 0);  yyDo(G, yy_3_lick_item, G->begin, G->end);  goto l176;
+  l179:;	  G->pos= yypos176; G->thunkpos= yythunkpos176;  if (!yy_message(G)) goto l180;  yyDo(G, yySet, -3, 0);  if (!yy_loose(G)) goto l180;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_4_lick_item, G->begin, G->end);  goto l176;
+  l180:;	  G->pos= yypos176; G->thunkpos= yythunkpos176;  if (!yy_message(G)) goto l175;  yyDo(G, yySet, -3, 0);  yyDo(G, yy_5_lick_item, G->begin, G->end);
+  }
+  l176:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "lick_item", G->buf+G->pos));  yyDo(G, yyPop, 3, 0);
+  return 1;
+  l175:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "lick_item", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_lick_items(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "lick_items"));
+  {  int yypos182= G->pos, yythunkpos182= G->thunkpos;  if (!yy_lick_item(G)) goto l183;  yyDo(G, yySet, -2, 0);  yyDo(G, yy_1_lick_items, G->begin, G->end);
+  l184:;	
+  {  int yypos185= G->pos, yythunkpos185= G->thunkpos;  if (!yy_sep(G)) goto l185;  if (!yy_lick_item(G)) goto l185;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_2_lick_items, G->begin, G->end);  goto l184;
+  l185:;	  G->pos= yypos185; G->thunkpos= yythunkpos185;
+  }
+  {  int yypos186= G->pos, yythunkpos186= G->thunkpos;  if (!yy_sep(G)) goto l186;  goto l187;
+  l186:;	  G->pos= yypos186; G->thunkpos= yythunkpos186;
+  }
+  l187:;	  goto l182;
+  l183:;	  G->pos= yypos182; G->thunkpos= yythunkpos182;  if (!yymatchString(G, "")) goto l181;  yyDo(G, yy_3_lick_items, G->begin, G->end);
+  }
+  l182:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "lick_items", G->buf+G->pos));  yyDo(G, yyPop, 2, 0);
+  return 1;
+  l181:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "lick_items", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_keyword(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "keyword"));
+  {  int yypos189= G->pos, yythunkpos189= G->thunkpos;  if (!yymatchString(G, "and")) goto l190;  goto l189;
+  l190:;	  G->pos= yypos189; G->thunkpos= yythunkpos189;  if (!yymatchString(G, "or")) goto l191;  goto l189;
+  l191:;	  G->pos= yypos189; G->thunkpos= yythunkpos189;  if (!yymatchString(G, "not")) goto l188;
+  }
+  l189:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "keyword", G->buf+G->pos));
+  return 1;
+  l188:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "keyword", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_message(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "message"));  yyText(G, G->begin, G->end);  if (!(YY_BEGIN)) goto l192;  if (!yy_utfw(G)) goto l192;
+  l193:;	
+  {  int yypos194= G->pos, yythunkpos194= G->thunkpos;  if (!yy_utfw(G)) goto l194;  goto l193;
+  l194:;	  G->pos= yypos194; G->thunkpos= yythunkpos194;
+  }  yyText(G, G->begin, G->end);  if (!(YY_END)) goto l192;  if (!yy__(G)) goto l192;  yyDo(G, yy_1_message, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "message", G->buf+G->pos));
+  return 1;
+  l192:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "message", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_quiz(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "quiz"));  if (!yymatchChar(G, '?')) goto l195;  if (!yy___(G)) goto l195;
+  yyprintf((stderr, "  ok   %s @ %s\n", "quiz", G->buf+G->pos));
+  return 1;
+  l195:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "quiz", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_path(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "path"));  if (!yymatchChar(G, '/')) goto l196;  if (!yy_message(G)) goto l196;  yyDo(G, yy_1_path, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "path", G->buf+G->pos));
+  return 1;
+  l196:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "path", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_block(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 1, 0);
+  yyprintf((stderr, "%s\n", "block"));  if (!yy_block_start(G)) goto l197;  if (!yy_statements(G)) goto l197;  yyDo(G, yySet, -1, 0);  if (!yy_block_end(G)) goto l197;  yyDo(G, yy_1_block, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "block", G->buf+G->pos));  yyDo(G, yyPop, 1, 0);
+  return 1;
+  l197:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "block", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_name(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "name"));
+  {  int yypos199= G->pos, yythunkpos199= G->thunkpos;  if (!yy_path(G)) goto l200;  yyDo(G, yySet, -2, 0);  yyDo(G, yy_1_name, G->begin, G->end);  goto l199;
+  l200:;	  G->pos= yypos199; G->thunkpos= yythunkpos199;  if (!yy_quiz(G)) goto l201;
+  {  int yypos202= G->pos, yythunkpos202= G->thunkpos;  if (!yy_message(G)) goto l203;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_2_name, G->begin, G->end);  goto l202;
+  l203:;	  G->pos= yypos202; G->thunkpos= yythunkpos202;  if (!yy_path(G)) goto l201;  yyDo(G, yySet, -2, 0);  yyDo(G, yy_3_name, G->begin, G->end);
+  }
+  l202:;	  goto l199;
+  l201:;	  G->pos= yypos199; G->thunkpos= yythunkpos199;
+  {  int yypos204= G->pos, yythunkpos204= G->thunkpos;  if (!yy_keyword(G)) goto l204;  goto l198;
+  l204:;	  G->pos= yypos204; G->thunkpos= yythunkpos204;
+  }  if (!yy_message(G)) goto l198;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_4_name, G->begin, G->end);
+  }
+  l199:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "name", G->buf+G->pos));  yyDo(G, yyPop, 2, 0);
+  return 1;
+  l198:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "name", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_table(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 1, 0);
+  yyprintf((stderr, "%s\n", "table"));  if (!yy_table_start(G)) goto l205;  if (!yy_statements(G)) goto l205;  yyDo(G, yySet, -1, 0);  if (!yy_table_end(G)) goto l205;  yyDo(G, yy_1_table, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "table", G->buf+G->pos));  yyDo(G, yyPop, 1, 0);
+  return 1;
+  l205:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "table", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_closure(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "closure"));
+  {  int yypos207= G->pos, yythunkpos207= G->thunkpos;  if (!yy_table(G)) goto l207;  yyDo(G, yySet, -2, 0);  goto l208;
+  l207:;	  G->pos= yypos207; G->thunkpos= yythunkpos207;
+  }
+  l208:;	  if (!yy_block(G)) goto l206;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_1_closure, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "closure", G->buf+G->pos));  yyDo(G, yyPop, 2, 0);
+  return 1;
+  l206:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "closure", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_value(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 1, 0);
+  yyprintf((stderr, "%s\n", "value"));
+  {  int yypos210= G->pos, yythunkpos210= G->thunkpos;  if (!yy_immed(G)) goto l211;  yyDo(G, yySet, -1, 0);  if (!yy__(G)) goto l211;  yyDo(G, yy_1_value, G->begin, G->end);  goto l210;
+  l211:;	  G->pos= yypos210; G->thunkpos= yythunkpos210;  if (!yy_lick(G)) goto l209;
+  }
+  l210:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "value", G->buf+G->pos));  yyDo(G, yyPop, 1, 0);
+  return 1;
+  l209:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "value", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_call(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 3, 0);
+  yyprintf((stderr, "%s\n", "call"));
+  {  int yypos213= G->pos, yythunkpos213= G->thunkpos;  if (!yy_name(G)) goto l214;  yyDo(G, yySet, -3, 0);  yyDo(G, yy_1_call, G->begin, G->end);
+  {  int yypos215= G->pos, yythunkpos215= G->thunkpos;
+  {  int yypos217= G->pos, yythunkpos217= G->thunkpos;  if (!yy_value(G)) goto l218;  yyDo(G, yySet, -2, 0);  goto l217;
+  l218:;	  G->pos= yypos217; G->thunkpos= yythunkpos217;  if (!yy_table(G)) goto l215;  yyDo(G, yySet, -2, 0);
+  }
+  l217:;	  goto l216;
+  l215:;	  G->pos= yypos215; G->thunkpos= yythunkpos215;
+  }
+  l216:;	  goto l213;
+  l214:;	  G->pos= yypos213; G->thunkpos= yythunkpos213;
+  {  int yypos219= G->pos, yythunkpos219= G->thunkpos;  if (!yy_value(G)) goto l220;  yyDo(G, yySet, -2, 0);  goto l219;
+  l220:;	  G->pos= yypos219; G->thunkpos= yythunkpos219;  if (!yy_table(G)) goto l212;  yyDo(G, yySet, -2, 0);
+  }
+  l219:;	  yyDo(G, yy_2_call, G->begin, G->end);
+  }
+  l213:;	
+  {  int yypos221= G->pos, yythunkpos221= G->thunkpos;  if (!yy_block(G)) goto l221;  yyDo(G, yySet, -1, 0);  goto l222;
+  l221:;	  G->pos= yypos221; G->thunkpos= yythunkpos221;
+  }
+  l222:;	  yyDo(G, yy_3_call, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "call", G->buf+G->pos));  yyDo(G, yyPop, 3, 0);
+  return 1;
+  l212:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "call", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_pplus(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "pplus"));  if (!yymatchString(G, "++")) goto l223;  if (!yy__(G)) goto l223;
+  yyprintf((stderr, "  ok   %s @ %s\n", "pplus", G->buf+G->pos));
+  return 1;
+  l223:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "pplus", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_atom(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 1, 0);
+  yyprintf((stderr, "%s\n", "atom"));
+  {  int yypos225= G->pos, yythunkpos225= G->thunkpos;  if (!yy_value(G)) goto l226;  yyDo(G, yySet, 0, 0);  goto l225;
+  l226:;	  G->pos= yypos225; G->thunkpos= yythunkpos225;  if (!yy_closure(G)) goto l227;  yyDo(G, yySet, 0, 0);  goto l225;
+  l227:;	  G->pos= yypos225; G->thunkpos= yythunkpos225;  if (!yy_table(G)) goto l228;  yyDo(G, yySet, 0, 0);  goto l225;
+  l228:;	  G->pos= yypos225; G->thunkpos= yythunkpos225;  if (!yy_call(G)) goto l224;  yyDo(G, yySet, 0, 0);
+  }
+  l225:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "atom", G->buf+G->pos));  yyDo(G, yyPop, 1, 0);
+  return 1;
+  l224:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "atom", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_mminus(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "mminus"));  if (!yymatchString(G, "--")) goto l229;  if (!yy__(G)) goto l229;
+  yyprintf((stderr, "  ok   %s @ %s\n", "mminus", G->buf+G->pos));
+  return 1;
+  l229:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "mminus", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_expr(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "expr"));
+  {  int yypos231= G->pos, yythunkpos231= G->thunkpos;  if (!yy_mminus(G)) goto l232;  if (!yy_atom(G)) goto l232;  yyDo(G, yySet, -2, 0);  yyDo(G, yy_1_expr, G->begin, G->end);  goto l231;
+  l232:;	  G->pos= yypos231; G->thunkpos= yythunkpos231;  if (!yy_pplus(G)) goto l233;  if (!yy_atom(G)) goto l233;  yyDo(G, yySet, -2, 0);  yyDo(G, yy_2_expr, G->begin, G->end);  goto l231;
+  l233:;	  G->pos= yypos231; G->thunkpos= yythunkpos231;  if (!yy_atom(G)) goto l230;  yyDo(G, yySet, -2, 0);
+  {  int yypos234= G->pos, yythunkpos234= G->thunkpos;
+  {  int yypos236= G->pos, yythunkpos236= G->thunkpos;  if (!yy_pplus(G)) goto l237;  yyDo(G, yy_3_expr, G->begin, G->end);  goto l236;
+  l237:;	  G->pos= yypos236; G->thunkpos= yythunkpos236;  if (!yy_mminus(G)) goto l234;  yyDo(G, yy_4_expr, G->begin, G->end);
+  }
+  l236:;	  goto l235;
+  l234:;	  G->pos= yypos234; G->thunkpos= yythunkpos234;
+  }
+  l235:;	
+  }
+  l231:;	  yyDo(G, yy_5_expr, G->begin, G->end);
+  l238:;	
+  {  int yypos239= G->pos, yythunkpos239= G->thunkpos;  if (!yy_call(G)) goto l239;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_6_expr, G->begin, G->end);  goto l238;
+  l239:;	  G->pos= yypos239; G->thunkpos= yythunkpos239;
+  }  yyDo(G, yy_7_expr, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "expr", G->buf+G->pos));  yyDo(G, yyPop, 2, 0);
+  return 1;
+  l230:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "expr", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_wavy(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "wavy"));  if (!yymatchChar(G, '~')) goto l240;  if (!yy___(G)) goto l240;
+  yyprintf((stderr, "  ok   %s @ %s\n", "wavy", G->buf+G->pos));
+  return 1;
+  l240:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "wavy", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_not(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "not"));
+  {  int yypos242= G->pos, yythunkpos242= G->thunkpos;  if (!yymatchChar(G, '!')) goto l243;  goto l242;
+  l243:;	  G->pos= yypos242; G->thunkpos= yythunkpos242;  if (!yymatchString(G, "not")) goto l241;
+  {  int yypos244= G->pos, yythunkpos244= G->thunkpos;  if (!yy_utfw(G)) goto l244;  goto l241;
+  l244:;	  G->pos= yypos244; G->thunkpos= yythunkpos244;
+  }
+  }
+  l242:;	  if (!yy___(G)) goto l241;
+  yyprintf((stderr, "  ok   %s @ %s\n", "not", G->buf+G->pos));
+  return 1;
+  l241:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "not", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_sign(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "sign"));
+  {  int yypos246= G->pos, yythunkpos246= G->thunkpos;  if (!yy_minus(G)) goto l247;
+  {  int yypos248= G->pos, yythunkpos248= G->thunkpos;  if (!yy_minus(G)) goto l248;  goto l247;
+  l248:;	  G->pos= yypos248; G->thunkpos= yythunkpos248;
+  }  if (!yy_sign(G)) goto l247;  yyDo(G, yySet, -2, 0);  yyDo(G, yy_1_sign, G->begin, G->end);  goto l246;
+  l247:;	  G->pos= yypos246; G->thunkpos= yythunkpos246;  if (!yy_plus(G)) goto l249;
+  {  int yypos250= G->pos, yythunkpos250= G->thunkpos;  if (!yy_plus(G)) goto l250;  goto l249;
+  l250:;	  G->pos= yypos250; G->thunkpos= yythunkpos250;
+  }  if (!yy_sign(G)) goto l249;  yyDo(G, yySet, -2, 0);  yyDo(G, yy_2_sign, G->begin, G->end);  goto l246;
+  l249:;	  G->pos= yypos246; G->thunkpos= yythunkpos246;  if (!yy_not(G)) goto l251;  if (!yy_sign(G)) goto l251;  yyDo(G, yySet, -2, 0);  yyDo(G, yy_3_sign, G->begin, G->end);  goto l246;
+  l251:;	  G->pos= yypos246; G->thunkpos= yythunkpos246;  if (!yy_wavy(G)) goto l252;  if (!yy_sign(G)) goto l252;  yyDo(G, yySet, -2, 0);  yyDo(G, yy_4_sign, G->begin, G->end);  goto l246;
+  l252:;	  G->pos= yypos246; G->thunkpos= yythunkpos246;  if (!yy_expr(G)) goto l245;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_5_sign, G->begin, G->end);
+  }
+  l246:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "sign", G->buf+G->pos));  yyDo(G, yyPop, 2, 0);
+  return 1;
+  l245:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "sign", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_product(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "product"));  if (!yy_sign(G)) goto l253;  yyDo(G, yySet, -2, 0);
+  l254:;	
+  {  int yypos255= G->pos, yythunkpos255= G->thunkpos;
+  {  int yypos256= G->pos, yythunkpos256= G->thunkpos;  if (!yy_times(G)) goto l257;  if (!yy_sign(G)) goto l257;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_1_product, G->begin, G->end);  goto l256;
+  l257:;	  G->pos= yypos256; G->thunkpos= yythunkpos256;  if (!yy_div(G)) goto l258;  if (!yy_sign(G)) goto l258;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_2_product, G->begin, G->end);  goto l256;
+  l258:;	  G->pos= yypos256; G->thunkpos= yythunkpos256;  if (!yy_rem(G)) goto l259;  if (!yy_sign(G)) goto l259;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_3_product, G->begin, G->end);  goto l256;
+  l259:;	  G->pos= yypos256; G->thunkpos= yythunkpos256;  if (!yy_pow(G)) goto l255;  if (!yy_sign(G)) goto l255;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_4_product, G->begin, G->end);
+  }
+  l256:;	  goto l254;
+  l255:;	  G->pos= yypos255; G->thunkpos= yythunkpos255;
+  }  yyDo(G, yy_5_product, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "product", G->buf+G->pos));  yyDo(G, yyPop, 2, 0);
+  return 1;
+  l253:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "product", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_sum(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "sum"));  if (!yy_product(G)) goto l260;  yyDo(G, yySet, -2, 0);
+  l261:;	
+  {  int yypos262= G->pos, yythunkpos262= G->thunkpos;
+  {  int yypos263= G->pos, yythunkpos263= G->thunkpos;  if (!yy_plus(G)) goto l264;  if (!yy_product(G)) goto l264;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_1_sum, G->begin, G->end);  goto l263;
+  l264:;	  G->pos= yypos263; G->thunkpos= yythunkpos263;  if (!yy_minus(G)) goto l262;  if (!yy_product(G)) goto l262;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_2_sum, G->begin, G->end);
+  }
+  l263:;	  goto l261;
+  l262:;	  G->pos= yypos262; G->thunkpos= yythunkpos262;
+  }  yyDo(G, yy_3_sum, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "sum", G->buf+G->pos));  yyDo(G, yyPop, 2, 0);
+  return 1;
+  l260:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "sum", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_bitshift(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "bitshift"));  if (!yy_sum(G)) goto l265;  yyDo(G, yySet, -2, 0);
+  l266:;	
+  {  int yypos267= G->pos, yythunkpos267= G->thunkpos;
+  {  int yypos268= G->pos, yythunkpos268= G->thunkpos;  if (!yy_bitl(G)) goto l269;  if (!yy_sum(G)) goto l269;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_1_bitshift, G->begin, G->end);  goto l268;
+  l269:;	  G->pos= yypos268; G->thunkpos= yythunkpos268;  if (!yy_bitr(G)) goto l267;  if (!yy_sum(G)) goto l267;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_2_bitshift, G->begin, G->end);
+  }
+  l268:;	  goto l266;
+  l267:;	  G->pos= yypos267; G->thunkpos= yythunkpos267;
+  }  yyDo(G, yy_3_bitshift, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "bitshift", G->buf+G->pos));  yyDo(G, yyPop, 2, 0);
+  return 1;
+  l265:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "bitshift", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_bitand(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "bitand"));  if (!yy_bitshift(G)) goto l270;  yyDo(G, yySet, -2, 0);
+  l271:;	
+  {  int yypos272= G->pos, yythunkpos272= G->thunkpos;  if (!yy_amp(G)) goto l272;  if (!yy_bitshift(G)) goto l272;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_1_bitand, G->begin, G->end);  goto l271;
+  l272:;	  G->pos= yypos272; G->thunkpos= yythunkpos272;
+  }  yyDo(G, yy_2_bitand, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "bitand", G->buf+G->pos));  yyDo(G, yyPop, 2, 0);
+  return 1;
+  l270:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "bitand", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_lt(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "lt"));  if (!yymatchChar(G, '<')) goto l273;  if (!yy___(G)) goto l273;
+  yyprintf((stderr, "  ok   %s @ %s\n", "lt", G->buf+G->pos));
+  return 1;
+  l273:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "lt", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_lte(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "lte"));  if (!yymatchString(G, "<=")) goto l274;  if (!yy___(G)) goto l274;
+  yyprintf((stderr, "  ok   %s @ %s\n", "lte", G->buf+G->pos));
+  return 1;
+  l274:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "lte", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_gt(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "gt"));  if (!yymatchChar(G, '>')) goto l275;  if (!yy___(G)) goto l275;
+  yyprintf((stderr, "  ok   %s @ %s\n", "gt", G->buf+G->pos));
+  return 1;
+  l275:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "gt", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_gte(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "gte"));  if (!yymatchString(G, ">=")) goto l276;  if (!yy___(G)) goto l276;
+  yyprintf((stderr, "  ok   %s @ %s\n", "gte", G->buf+G->pos));
+  return 1;
+  l276:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "gte", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_bitors(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "bitors"));  if (!yy_bitand(G)) goto l277;  yyDo(G, yySet, -2, 0);
+  l278:;	
+  {  int yypos279= G->pos, yythunkpos279= G->thunkpos;
+  {  int yypos280= G->pos, yythunkpos280= G->thunkpos;  if (!yy_pipe(G)) goto l281;  if (!yy_bitand(G)) goto l281;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_1_bitors, G->begin, G->end);  goto l280;
+  l281:;	  G->pos= yypos280; G->thunkpos= yythunkpos280;  if (!yy_caret(G)) goto l279;  if (!yy_bitand(G)) goto l279;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_2_bitors, G->begin, G->end);
+  }
+  l280:;	  goto l278;
+  l279:;	  G->pos= yypos279; G->thunkpos= yythunkpos279;
+  }  yyDo(G, yy_3_bitors, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "bitors", G->buf+G->pos));  yyDo(G, yyPop, 2, 0);
+  return 1;
+  l277:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "bitors", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_neq(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "neq"));  if (!yymatchString(G, "!=")) goto l282;  if (!yy___(G)) goto l282;
+  yyprintf((stderr, "  ok   %s @ %s\n", "neq", G->buf+G->pos));
+  return 1;
+  l282:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "neq", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_eq(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "eq"));  if (!yymatchString(G, "==")) goto l283;  if (!yy___(G)) goto l283;
+  yyprintf((stderr, "  ok   %s @ %s\n", "eq", G->buf+G->pos));
+  return 1;
+  l283:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "eq", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_cmp(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "cmp"));  if (!yymatchString(G, "<=>")) goto l284;  if (!yy___(G)) goto l284;
+  yyprintf((stderr, "  ok   %s @ %s\n", "cmp", G->buf+G->pos));
+  return 1;
+  l284:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "cmp", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_cmps(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "cmps"));  if (!yy_bitors(G)) goto l285;  yyDo(G, yySet, -2, 0);
+  l286:;	
+  {  int yypos287= G->pos, yythunkpos287= G->thunkpos;
+  {  int yypos288= G->pos, yythunkpos288= G->thunkpos;  if (!yy_gte(G)) goto l289;  if (!yy_bitors(G)) goto l289;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_1_cmps, G->begin, G->end);  goto l288;
+  l289:;	  G->pos= yypos288; G->thunkpos= yythunkpos288;  if (!yy_gt(G)) goto l290;  if (!yy_bitors(G)) goto l290;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_2_cmps, G->begin, G->end);  goto l288;
+  l290:;	  G->pos= yypos288; G->thunkpos= yythunkpos288;  if (!yy_lte(G)) goto l291;  if (!yy_bitors(G)) goto l291;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_3_cmps, G->begin, G->end);  goto l288;
+  l291:;	  G->pos= yypos288; G->thunkpos= yythunkpos288;  if (!yy_lt(G)) goto l287;  if (!yy_bitors(G)) goto l287;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_4_cmps, G->begin, G->end);
+  }
+  l288:;	  goto l286;
+  l287:;	  G->pos= yypos287; G->thunkpos= yythunkpos287;
+  }  yyDo(G, yy_5_cmps, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "cmps", G->buf+G->pos));  yyDo(G, yyPop, 2, 0);
+  return 1;
+  l285:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "cmps", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_pow(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "pow"));  if (!yymatchString(G, "**")) goto l292;  if (!yy___(G)) goto l292;
+  yyprintf((stderr, "  ok   %s @ %s\n", "pow", G->buf+G->pos));
+  return 1;
+  l292:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "pow", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_rem(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "rem"));  if (!yymatchChar(G, '%')) goto l293;  if (!yy___(G)) goto l293;
+  yyprintf((stderr, "  ok   %s @ %s\n", "rem", G->buf+G->pos));
+  return 1;
+  l293:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "rem", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_div(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "div"));  if (!yymatchChar(G, '/')) goto l294;  if (!yy___(G)) goto l294;
+  yyprintf((stderr, "  ok   %s @ %s\n", "div", G->buf+G->pos));
+  return 1;
+  l294:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "div", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_times(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "times"));  if (!yymatchChar(G, '*')) goto l295;  if (!yy___(G)) goto l295;
+  yyprintf((stderr, "  ok   %s @ %s\n", "times", G->buf+G->pos));
+  return 1;
+  l295:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "times", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_minus(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "minus"));  if (!yymatchChar(G, '-')) goto l296;  if (!yy___(G)) goto l296;
+  yyprintf((stderr, "  ok   %s @ %s\n", "minus", G->buf+G->pos));
+  return 1;
+  l296:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "minus", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_plus(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "plus"));  if (!yymatchChar(G, '+')) goto l297;  if (!yy___(G)) goto l297;
+  yyprintf((stderr, "  ok   %s @ %s\n", "plus", G->buf+G->pos));
+  return 1;
+  l297:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "plus", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_bitr(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "bitr"));  if (!yymatchString(G, ">>")) goto l298;  if (!yy___(G)) goto l298;
+  yyprintf((stderr, "  ok   %s @ %s\n", "bitr", G->buf+G->pos));
+  return 1;
+  l298:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "bitr", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_bitl(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "bitl"));  if (!yymatchString(G, "<<")) goto l299;  if (!yy___(G)) goto l299;
+  yyprintf((stderr, "  ok   %s @ %s\n", "bitl", G->buf+G->pos));
+  return 1;
+  l299:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "bitl", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_amp(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "amp"));  if (!yymatchChar(G, '&')) goto l300;  if (!yy___(G)) goto l300;
+  yyprintf((stderr, "  ok   %s @ %s\n", "amp", G->buf+G->pos));
+  return 1;
+  l300:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "amp", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_caret(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "caret"));  if (!yymatchChar(G, '^')) goto l301;  if (!yy___(G)) goto l301;
+  yyprintf((stderr, "  ok   %s @ %s\n", "caret", G->buf+G->pos));
+  return 1;
+  l301:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "caret", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_pipe(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "pipe"));  if (!yymatchChar(G, '|')) goto l302;  if (!yy___(G)) goto l302;
+  yyprintf((stderr, "  ok   %s @ %s\n", "pipe", G->buf+G->pos));
+  return 1;
+  l302:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "pipe", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_assign(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "assign"));  if (!yymatchChar(G, '=')) goto l303;  if (!yy___(G)) goto l303;
+  yyprintf((stderr, "  ok   %s @ %s\n", "assign", G->buf+G->pos));
+  return 1;
+  l303:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "assign", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_eqs(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "eqs"));  if (!yy_cmps(G)) goto l304;  yyDo(G, yySet, -2, 0);
+  l305:;	
+  {  int yypos306= G->pos, yythunkpos306= G->thunkpos;
+  {  int yypos307= G->pos, yythunkpos307= G->thunkpos;  if (!yy_cmp(G)) goto l308;  if (!yy_cmps(G)) goto l308;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_1_eqs, G->begin, G->end);  goto l307;
+  l308:;	  G->pos= yypos307; G->thunkpos= yythunkpos307;  if (!yy_eq(G)) goto l309;  if (!yy_cmps(G)) goto l309;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_2_eqs, G->begin, G->end);  goto l307;
+  l309:;	  G->pos= yypos307; G->thunkpos= yythunkpos307;  if (!yy_neq(G)) goto l306;  if (!yy_cmps(G)) goto l306;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_3_eqs, G->begin, G->end);
+  }
+  l307:;	  goto l305;
+  l306:;	  G->pos= yypos306; G->thunkpos= yythunkpos306;
+  }  yyDo(G, yy_4_eqs, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "eqs", G->buf+G->pos));  yyDo(G, yyPop, 2, 0);
+  return 1;
+  l304:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "eqs", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_and(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "and"));
+  {  int yypos311= G->pos, yythunkpos311= G->thunkpos;  if (!yymatchString(G, "&&")) goto l312;  goto l311;
+  l312:;	  G->pos= yypos311; G->thunkpos= yythunkpos311;  if (!yymatchString(G, "and")) goto l310;
+  {  int yypos313= G->pos, yythunkpos313= G->thunkpos;  if (!yy_utfw(G)) goto l313;  goto l310;
+  l313:;	  G->pos= yypos313; G->thunkpos= yythunkpos313;
+  }
+  }
+  l311:;	  if (!yy___(G)) goto l310;
+  yyprintf((stderr, "  ok   %s @ %s\n", "and", G->buf+G->pos));
+  return 1;
+  l310:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "and", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_or(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "or"));
+  {  int yypos315= G->pos, yythunkpos315= G->thunkpos;  if (!yymatchString(G, "||")) goto l316;  goto l315;
+  l316:;	  G->pos= yypos315; G->thunkpos= yythunkpos315;  if (!yymatchString(G, "or")) goto l314;
+  {  int yypos317= G->pos, yythunkpos317= G->thunkpos;  if (!yy_utfw(G)) goto l317;  goto l314;
+  l317:;	  G->pos= yypos317; G->thunkpos= yythunkpos317;
+  }
+  }
+  l315:;	  if (!yy___(G)) goto l314;
+  yyprintf((stderr, "  ok   %s @ %s\n", "or", G->buf+G->pos));
+  return 1;
+  l314:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "or", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_sets(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "sets"));  if (!yy_eqs(G)) goto l318;  yyDo(G, yySet, -2, 0);
+  {  int yypos319= G->pos, yythunkpos319= G->thunkpos;
+  {  int yypos321= G->pos, yythunkpos321= G->thunkpos;  if (!yy_assign(G)) goto l322;  if (!yy_sets(G)) goto l322;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_1_sets, G->begin, G->end);  goto l321;
+  l322:;	  G->pos= yypos321; G->thunkpos= yythunkpos321;  if (!yy_or(G)) goto l323;  if (!yy_assign(G)) goto l323;  if (!yy_sets(G)) goto l323;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_2_sets, G->begin, G->end);  goto l321;
+  l323:;	  G->pos= yypos321; G->thunkpos= yythunkpos321;  if (!yy_and(G)) goto l324;  if (!yy_assign(G)) goto l324;  if (!yy_sets(G)) goto l324;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_3_sets, G->begin, G->end);  goto l321;
+  l324:;	  G->pos= yypos321; G->thunkpos= yythunkpos321;  if (!yy_pipe(G)) goto l325;  if (!yy_assign(G)) goto l325;  if (!yy_sets(G)) goto l325;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_4_sets, G->begin, G->end);  goto l321;
+  l325:;	  G->pos= yypos321; G->thunkpos= yythunkpos321;  if (!yy_caret(G)) goto l326;  if (!yy_assign(G)) goto l326;  if (!yy_sets(G)) goto l326;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_5_sets, G->begin, G->end);  goto l321;
+  l326:;	  G->pos= yypos321; G->thunkpos= yythunkpos321;  if (!yy_amp(G)) goto l327;  if (!yy_assign(G)) goto l327;  if (!yy_sets(G)) goto l327;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_6_sets, G->begin, G->end);  goto l321;
+  l327:;	  G->pos= yypos321; G->thunkpos= yythunkpos321;  if (!yy_bitl(G)) goto l328;  if (!yy_assign(G)) goto l328;  if (!yy_sets(G)) goto l328;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_7_sets, G->begin, G->end);  goto l321;
+  l328:;	  G->pos= yypos321; G->thunkpos= yythunkpos321;  if (!yy_bitr(G)) goto l329;  if (!yy_assign(G)) goto l329;  if (!yy_sets(G)) goto l329;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_8_sets, G->begin, G->end);  goto l321;
+  l329:;	  G->pos= yypos321; G->thunkpos= yythunkpos321;  if (!yy_plus(G)) goto l330;  if (!yy_assign(G)) goto l330;  if (!yy_sets(G)) goto l330;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_9_sets, G->begin, G->end);  goto l321;
+  l330:;	  G->pos= yypos321; G->thunkpos= yythunkpos321;  if (!yy_minus(G)) goto l331;  if (!yy_assign(G)) goto l331;  if (!yy_sets(G)) goto l331;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_10_sets, G->begin, G->end);  goto l321;
+  l331:;	  G->pos= yypos321; G->thunkpos= yythunkpos321;  if (!yy_times(G)) goto l332;  if (!yy_assign(G)) goto l332;  if (!yy_sets(G)) goto l332;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_11_sets, G->begin, G->end);  goto l321;
+  l332:;	  G->pos= yypos321; G->thunkpos= yythunkpos321;  if (!yy_div(G)) goto l333;  if (!yy_assign(G)) goto l333;  if (!yy_sets(G)) goto l333;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_12_sets, G->begin, G->end);  goto l321;
+  l333:;	  G->pos= yypos321; G->thunkpos= yythunkpos321;  if (!yy_rem(G)) goto l334;  if (!yy_assign(G)) goto l334;  if (!yy_sets(G)) goto l334;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_13_sets, G->begin, G->end);  goto l321;
+  l334:;	  G->pos= yypos321; G->thunkpos= yythunkpos321;  if (!yy_pow(G)) goto l319;  if (!yy_assign(G)) goto l319;  if (!yy_sets(G)) goto l319;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_14_sets, G->begin, G->end);
+  }
+  l321:;	  goto l320;
+  l319:;	  G->pos= yypos319; G->thunkpos= yythunkpos319;
+  }
+  l320:;	  yyDo(G, yy_15_sets, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "sets", G->buf+G->pos));  yyDo(G, yyPop, 2, 0);
+  return 1;
+  l318:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "sets", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_sep(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "sep"));
+  {  int yypos336= G->pos, yythunkpos336= G->thunkpos;  if (!yy_end_of_line(G)) goto l337;  goto l336;
+  l337:;	  G->pos= yypos336; G->thunkpos= yythunkpos336;  if (!yy_comma(G)) goto l335;
+  }
+  l336:;	
+  l338:;	
+  {  int yypos339= G->pos, yythunkpos339= G->thunkpos;
+  {  int yypos340= G->pos, yythunkpos340= G->thunkpos;  if (!yy_space(G)) goto l341;  goto l340;
+  l341:;	  G->pos= yypos340; G->thunkpos= yythunkpos340;  if (!yy_comment(G)) goto l342;  goto l340;
+  l342:;	  G->pos= yypos340; G->thunkpos= yythunkpos340;  if (!yy_end_of_line(G)) goto l343;  goto l340;
+  l343:;	  G->pos= yypos340; G->thunkpos= yythunkpos340;  if (!yy_comma(G)) goto l339;
+  }
+  l340:;	  goto l338;
+  l339:;	  G->pos= yypos339; G->thunkpos= yythunkpos339;
+  }
+  yyprintf((stderr, "  ok   %s @ %s\n", "sep", G->buf+G->pos));
+  return 1;
+  l335:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "sep", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_stmt(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "stmt"));  if (!yy_sets(G)) goto l344;  yyDo(G, yySet, -2, 0);
+  l345:;	
+  {  int yypos346= G->pos, yythunkpos346= G->thunkpos;
+  {  int yypos347= G->pos, yythunkpos347= G->thunkpos;  if (!yy_or(G)) goto l348;  if (!yy_sets(G)) goto l348;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_1_stmt, G->begin, G->end);  goto l347;
+  l348:;	  G->pos= yypos347; G->thunkpos= yythunkpos347;  if (!yy_and(G)) goto l346;  if (!yy_sets(G)) goto l346;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_2_stmt, G->begin, G->end);
+  }
+  l347:;	  goto l345;
+  l346:;	  G->pos= yypos346; G->thunkpos= yythunkpos346;
+  }  yyDo(G, yy_3_stmt, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "stmt", G->buf+G->pos));  yyDo(G, yyPop, 2, 0);
+  return 1;
+  l344:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "stmt", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_end_of_file(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;
+  yyprintf((stderr, "%s\n", "end_of_file"));
+  {  int yypos350= G->pos, yythunkpos350= G->thunkpos;  if (!yymatchDot(G)) goto l350;  goto l349;
+  l350:;	  G->pos= yypos350; G->thunkpos= yythunkpos350;
+  }
+  yyprintf((stderr, "  ok   %s @ %s\n", "end_of_file", G->buf+G->pos));
+  return 1;
+  l349:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "end_of_file", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy_statements(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 2, 0);
+  yyprintf((stderr, "%s\n", "statements"));
+  {  int yypos352= G->pos, yythunkpos352= G->thunkpos;  if (!yy_stmt(G)) goto l353;  yyDo(G, yySet, -2, 0);  yyDo(G, yy_1_statements, G->begin, G->end);
+  l354:;	
+  {  int yypos355= G->pos, yythunkpos355= G->thunkpos;  if (!yy_sep(G)) goto l355;  if (!yy_stmt(G)) goto l355;  yyDo(G, yySet, -1, 0);  yyDo(G, yy_2_statements, G->begin, G->end);  goto l354;
+  l355:;	  G->pos= yypos355; G->thunkpos= yythunkpos355;
+  }
+  {  int yypos356= G->pos, yythunkpos356= G->thunkpos;  if (!yy_sep(G)) goto l356;  goto l357;
+  l356:;	  G->pos= yypos356; G->thunkpos= yythunkpos356;
+  }
+  l357:;	  goto l352;
+  l353:;	  G->pos= yypos352; G->thunkpos= yythunkpos352;  if (!yymatchString(G, "")) goto l351;  yyDo(G, yy_3_statements, G->begin, G->end);
+  }
+  l352:;	
+  yyprintf((stderr, "  ok   %s @ %s\n", "statements", G->buf+G->pos));  yyDo(G, yyPop, 2, 0);
+  return 1;
+  l351:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "statements", G->buf+G->pos));
+  return 0;
+}
+YY_RULE(int) yy___(GREG *G)
+{
+  yyprintf((stderr, "%s\n", "__"));
+  l359:;	
+  {  int yypos360= G->pos, yythunkpos360= G->thunkpos;
+  {  int yypos361= G->pos, yythunkpos361= G->thunkpos;  if (!yy_space(G)) goto l362;  goto l361;
+  l362:;	  G->pos= yypos361; G->thunkpos= yythunkpos361;  if (!yy_comment(G)) goto l363;  goto l361;
+  l363:;	  G->pos= yypos361; G->thunkpos= yythunkpos361;  if (!yy_end_of_line(G)) goto l360;
+  }
+  l361:;	  goto l359;
+  l360:;	  G->pos= yypos360; G->thunkpos= yythunkpos360;
+  }
+  yyprintf((stderr, "  ok   %s @ %s\n", "__", G->buf+G->pos));
+  return 1;
+}
+YY_RULE(int) yy_potion(GREG *G)
+{  int yypos0= G->pos, yythunkpos0= G->thunkpos;  yyDo(G, yyPush, 1, 0);
+  yyprintf((stderr, "%s\n", "potion"));  if (!yy___(G)) goto l364;  if (!yy_statements(G)) goto l364;  yyDo(G, yySet, -1, 0);  if (!yy_end_of_file(G)) goto l364;  yyDo(G, yy_1_potion, G->begin, G->end);
+  yyprintf((stderr, "  ok   %s @ %s\n", "potion", G->buf+G->pos));  yyDo(G, yyPop, 1, 0);
+  return 1;
+  l364:;	  G->pos= yypos0; G->thunkpos= yythunkpos0;
+  yyprintf((stderr, "  fail %s @ %s\n", "potion", G->buf+G->pos));
+  return 0;
+}
+
+#ifndef YY_PART
+
+typedef int (*yyrule)(GREG *G);
+
+YY_PARSE(int) YY_NAME(parse_from)(GREG *G, yyrule yystart)
+{
+  int yyok;
+  if (!G->buflen)
+    {
+      G->buflen= 1024;
+      G->buf= YY_ALLOC(G->buflen, G->data);
+      G->textlen= 1024;
+      G->text= YY_ALLOC(G->textlen, G->data);
+      G->thunkslen= 32;
+      G->thunks= YY_ALLOC(sizeof(yythunk) * G->thunkslen, G->data);
+      G->valslen= 32;
+      G->vals= YY_ALLOC(sizeof(YYSTYPE) * G->valslen, G->data);
+      G->begin= G->end= G->pos= G->limit= G->thunkpos= 0;
+    }
+  G->begin= G->end= G->pos;
+  G->thunkpos= 0;
+  G->val= G->vals;
+  yyok= yystart(G);
+  if (yyok) yyDone(G);
+  yyCommit(G);
+  return yyok;
+  (void)yyrefill;
+  (void)yymatchDot;
+  (void)yymatchChar;
+  (void)yymatchString;
+  (void)yymatchClass;
+  (void)yyDo;
+  (void)yyText;
+  (void)yyDone;
+  (void)yyCommit;
+  (void)yyAccept;
+  (void)yyPush;
+  (void)yyPop;
+  (void)yySet;
+}
+
+YY_PARSE(int) YY_NAME(parse)(GREG *G)
+{
+  return YY_NAME(parse_from)(G, yy_potion);
+}
+
+YY_PARSE(GREG *) YY_NAME(parse_new)(YY_XTYPE data)
+{
+  GREG *G = (GREG *)YY_CALLOC(1, sizeof(GREG), G->data);
+  G->data = data;
+  return G;
+}
+
+YY_PARSE(void) YY_NAME(parse_free)(GREG *G)
+{
+  YY_FREE(G);
+}
+
+#endif
+
+
+//
+// actions run once the whole input has been matched, with
+// their values sitting in malloc'd memory: the frames still
+// open need to be seen by the gc if the actions allocate
+// enough to collect.
+//
+PN_SIZE potion_code_mark(Potion *P, int forward) {
+  GREG *G = (GREG *)P->parser;
+  PN_SIZE n = pngc_mark_array(P, (_PN *)&G->ss, 1, forward);
+  if (G->vals != NULL && G->val > G->vals)
+    n += pngc_mark_array(P, (_PN *)G->vals, G->val - G->vals, forward);
+  return n;
+}
+
+PN potion_parse(Potion *P, PN code) {
+  GREG *G = potion_code_parse_new(P);
+  void *outer = P->parser;
+  P->parser = G;
+  P->yypos = 0;
+  P->input = code;
+  P->source = PN_NIL;
+  P->pbuf = potion_asm_new(P);
+
+  G->pos = G->limit = 0;
+  if (!potion_code_parse(G))
+    printf("** Syntax error!\n");
+  P->parser = outer;
+  potion_code_parse_free(G);
+
+  code = P->source;
+  P->source = PN_NIL;
+  return code;
+}
+
+PN potion_sig(Potion *P, char *fmt) {
+  PN out = PN_NIL;
+  if (fmt == NULL) return PN_NIL; // no signature, arg check off
+  if (fmt[0] == '\0') return PN_FALSE; // empty signature, no args
+
+  GREG *G = potion_code_parse_new(P);
+  void *outer = P->parser;
+  P->parser = G;
+  P->yypos = 0;
+  P->input = potion_byte_str(P, fmt);
+  P->source = out = PN_TUP0();
+  P->pbuf = NULL;
+
+  G->pos = G->limit = 0;
+  if (!potion_code_parse_from(G, yy_sig))
+    printf("** Syntax error!\n");
+  P->parser = outer;
+  potion_code_parse_free(G);
+
+  out = P->source;
+  P->source = PN_NIL;
+  return out;
+}
+
+int potion_sig_find(Potion *P, PN cl, PN name)
+{
+  PN_SIZE idx = 0;
+  PN sig;
+  if (!PN_IS_CLOSURE(cl))
+    cl = potion_obj_get_call(P, cl);
+
+  if (!PN_IS_CLOSURE(cl))
+    return -1;
+
+  sig = PN_CLOSURE(cl)->sig;
+
+  if (!PN_IS_TUPLE(sig))
+    return -1;
+
+  // only the names count: the types and separators between
+  // them don't take up an arg.
+  PN_TUPLE_EACH(sig, i, v, {
+    if (PN_IS_STR(v)) {
+      if (v == name || name == PN_NUM(idx))
+        return idx;
+      idx++;
+    }
+  });
+
+  return -1;
+}
+
@@ -12,6 +12,7 @@
 #include "internal.h"
 #include "asm.h"
 #include "ast.h"
+#include "gc.h"
 
 #define YY_INPUT(buf, result, max) { \
   if (P->yypos < PN_STR_LEN(P->input)) { \
@@ -120,7 +121,7 @@ atom = e:value | e:closure | e:table | e:call
 
 call = (n:name { v = PN_NIL; b = PN_NIL; } (v:value | v:table)? |
        (v:value | v:table) { n = PN_AST(MESSAGE, PN_NIL); b = PN_NIL; })
-         b:block? { $$ = n; PN_S(n, 1) = v; PN_S(n, 2) = b; }
+         b:block? { $$ = n; PN_S(n, 1) = v; PN_S(n, 2) = b; PN_TOUCH(n); }
 
 name = p:path           { $$ = PN_AST(PATH, p); }
      | quiz ( m:message { $$ = PN_AST(QUERY, m); }
@@ -287,8 +288,24 @@ arg-sep = '.' -        { P->source = PN_PUSH(P->source, PN_NUM('.')); }
 
 %%
 
+//
+// actions run once the whole input has been matched, with
+// their values sitting in malloc'd memory: the frames still
+// open need to be seen by the gc if the actions allocate
+// enough to collect.
+//
+PN_SIZE potion_code_mark(Potion *P, int forward) {
+  GREG *G = (GREG *)P->parser;
+  PN_SIZE n = pngc_mark_array(P, (_PN *)&G->ss, 1, forward);
+  if (G->vals != NULL && G->val > G->vals)
+    n += pngc_mark_array(P, (_PN *)G->vals, G->val - G->vals, forward);
+  return n;
+}
+
 PN potion_parse(Potion *P, PN code) {
   GREG *G = potion_code_parse_new(P);
+  void *outer = P->parser;
+  P->parser = G;
   P->yypos = 0;
   P->input = code;
   P->source = PN_NIL;
@@ -297,6 +314,7 @@ PN potion_parse(Potion *P, PN code) {
   G->pos = G->limit = 0;
   if (!potion_code_parse(G))
     printf("** Syntax error!\n");
+  P->parser = outer;
   potion_code_parse_free(G);
 
   code = P->source;
@@ -310,6 +328,8 @@ PN potion_sig(Potion *P, char *fmt) {
   if (fmt[0] == '\0') return PN_FALSE; // empty signature, no args
 
   GREG *G = potion_code_parse_new(P);
+  void *outer = P->parser;
+  P->parser = G;
   P->yypos = 0;
   P->input = potion_byte_str(P, fmt);
   P->source = out = PN_TUP0();
@@ -318,6 +338,7 @@ PN potion_sig(Potion *P, char *fmt) {
   G->pos = G->limit = 0;
   if (!potion_code_parse_from(G, yy_sig))
     printf("** Syntax error!\n");
+  P->parser = outer;
   potion_code_parse_free(G);
 
   out = P->source;
@@ -340,11 +361,14 @@ int potion_sig_find(Potion *P, PN cl, PN name)
   if (!PN_IS_TUPLE(sig))
     return -1;
 
+  // only the names count: the types and separators between
+  // them don't take up an arg.
   PN_TUPLE_EACH(sig, i, v, {
-    if (v == PN_NUM(idx) || v == name)
-      return idx;
-    if (PN_IS_NUM(v))
+    if (PN_IS_STR(v)) {
+      if (v == name || name == PN_NUM(idx))
+        return idx;
       idx++;
+    }
   });
 
   return -1;
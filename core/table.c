@@ -11,7 +11,7 @@
 #include "khash.h"
 #include "table.h"
 
-PN potion_table_string(Potion *P, PN cl, PN self) {
+PN potion_table_string(Potion *P, PN cl, PN self, PN_SIZE argc, PN * volatile argv) {
   vPN(Table) t = (struct PNTable *)potion_fwd(self);
   PN out = potion_byte_str(P, "(");
   unsigned k, i = 0;
@@ -55,12 +55,13 @@ PN potion_table_at(Potion *P, PN cl, PN self, PN key) {
   return PN_NIL;
 }
 
-PN potion_table_each(Potion *P, PN cl, PN self, PN block) {
+PN potion_table_each(Potion *P, PN cl, PN self, PN_SIZE argc, PN * volatile argv) {
   vPN(Table) t = (struct PNTable *)potion_fwd(self);
+  PN block = PN_ARGV(0);
   unsigned k;
   for (k = kh_begin(t); k != kh_end(t); ++k)
     if (kh_exist(PN, t, k)) {
-      PN_CLOSURE(block)->method(P, block, self, kh_key(PN, t, k), kh_val(PN, t, k));
+      potion_closure_call(block, self, kh_key(PN, t, k), kh_val(PN, t, k));
     }
   return self;
 }
@@ -75,9 +76,9 @@ PN potion_table_put(Potion *P, PN cl, PN self, PN key, PN value) {
   return self;
 }
 
-PN potion_table_remove(Potion *P, PN cl, PN self, PN key) {
+PN potion_table_remove(Potion *P, PN cl, PN self, PN_SIZE argc, PN * volatile argv) {
   vPN(Table) t = (struct PNTable *)potion_fwd(self);
-  unsigned k = kh_get(PN, t, key);
+  unsigned k = kh_get(PN, t, PN_ARGV(0));
 	if (k != kh_end(t)) kh_del(PN, t, k);
   return self;
 }
@@ -87,7 +88,7 @@ PN potion_table_set(Potion *P, PN self, PN key, PN value) {
   return potion_table_put(P, PN_NIL, potion_table_cast(P, self), key, value);
 }
 
-PN potion_table_length(Potion *P, PN cl, PN self) {
+PN potion_table_length(Potion *P, PN cl, PN self, PN_SIZE argc, PN * volatile argv) {
   vPN(Table) t = (struct PNTable *)potion_fwd(self);
   return PN_NUM(kh_size(t));
 }
@@ -121,8 +122,8 @@ PN potion_tuple_push(Potion *P, PN tuple, PN value) {
   return tuple;
 }
 
-PN potion_tuple_append(Potion *P, PN cl, PN self, PN value) {
-  return potion_tuple_push(P, self, value);
+PN potion_tuple_append(Potion *P, PN cl, PN self, PN_SIZE argc, PN * volatile argv) {
+  return potion_tuple_push(P, self, PN_ARGV(0));
 }
 
 PN_SIZE potion_tuple_find(Potion *P, PN tuple, PN value) {
@@ -143,31 +144,32 @@ PN_SIZE potion_tuple_push_unless(Potion *P, PN tuple, PN value) {
 PN potion_tuple_at(Potion *P, PN cl, PN self, PN index) {
   long i = PN_INT(index), len = PN_TUPLE_LEN(self);
   if (i < 0) i += len;
-  if (i >= len) return PN_NIL;
+  if (i < 0 || i >= len) return PN_NIL;
   return PN_TUPLE_AT(self, i);
 }
 
-PN potion_tuple_clone(Potion *P, PN cl, PN self) {
+PN potion_tuple_clone(Potion *P, PN cl, PN self, PN_SIZE argc, PN * volatile argv) {
   vPN(Tuple) t1 = PN_GET_TUPLE(self);
   NEW_TUPLE(t2, t1->len);
   PN_MEMCPY_N(t2->set, t1->set, PN, t1->len);
   return (PN)t2;
 }
 
-PN potion_tuple_each(Potion *P, PN cl, PN self, PN block) {
+PN potion_tuple_each(Potion *P, PN cl, PN self, PN_SIZE argc, PN * volatile argv) {
+  PN block = PN_ARGV(0);
   PN_TUPLE_EACH(self, i, v, {
-    PN_CLOSURE(block)->method(P, block, self, v);
+    potion_closure_call(block, self, v);
   });
   return self;
 }
 
-PN potion_tuple_first(Potion *P, PN cl, PN self) {
+PN potion_tuple_first(Potion *P, PN cl, PN self, PN_SIZE argc, PN * volatile argv) {
   if (PN_TUPLE_LEN(self) < 1) return PN_NIL;
   return PN_TUPLE_AT(self, 0);
 }
 
-PN potion_tuple_join(Potion *P, PN cl, PN self, PN sep) {
-  PN out = potion_byte_str(P, "");
+PN potion_tuple_join(Potion *P, PN cl, PN self, PN_SIZE argc, PN * volatile argv) {
+  PN sep = PN_ARGV(0), out = potion_byte_str(P, "");
   PN_TUPLE_EACH(self, i, v, {
     if (i > 0 && sep != PN_NIL) potion_bytes_obj_string(P, out, sep);
     potion_bytes_obj_string(P, out, v);
@@ -175,13 +177,13 @@ PN potion_tuple_join(Potion *P, PN cl, PN self, PN sep) {
   return PN_STR_B(out);
 }
 
-PN potion_tuple_last(Potion *P, PN cl, PN self) {
+PN potion_tuple_last(Potion *P, PN cl, PN self, PN_SIZE argc, PN * volatile argv) {
   long len = PN_TUPLE_LEN(self);
   if (len < 1) return PN_NIL;
   return PN_TUPLE_AT(self, len - 1);
 }
 
-PN potion_tuple_string(Potion *P, PN cl, PN self) {
+PN potion_tuple_string(Potion *P, PN cl, PN self, PN_SIZE argc, PN * volatile argv) {
   int licks = 0;
   PN out = potion_byte_str(P, "(");
   PN_TUPLE_EACH(self, i, v, {
@@ -196,7 +198,7 @@ PN potion_tuple_string(Potion *P, PN cl, PN self) {
   return PN_STR_B(out);
 }
 
-PN potion_tuple_pop(Potion *P, PN cl, PN self, PN key) {
+PN potion_tuple_pop(Potion *P, PN cl, PN self, PN_SIZE argc, PN * volatile argv) {
   vPN(Tuple) t = PN_GET_TUPLE(self);
   PN obj = t->set[t->len - 1];
   PN_REALLOC(t, PN_TTUPLE, struct PNTuple, sizeof(PN) * (t->len - 1));
@@ -209,7 +211,7 @@ PN potion_tuple_put(Potion *P, PN cl, PN self, PN key, PN value) {
   if (PN_IS_NUM(key)) {
     long i = PN_INT(key), len = PN_TUPLE_LEN(self);
     if (i < 0) i += len;
-    if (i < len) {
+    if (i >= 0 && i < len) {
       PN_TUPLE_AT(self, i) = value;
       PN_TOUCH(self);
       return self;
@@ -219,14 +221,14 @@ PN potion_tuple_put(Potion *P, PN cl, PN self, PN key, PN value) {
   return potion_table_put(P, PN_NIL, potion_table_cast(P, self), key, value);
 }
 
-PN potion_tuple_print(Potion *P, PN cl, PN self) {
+PN potion_tuple_print(Potion *P, PN cl, PN self, PN_SIZE argc, PN * volatile argv) {
   PN_TUPLE_EACH(self, i, v, {
     potion_send(v, PN_print);
   });
   return PN_NIL;
 }
 
-PN potion_tuple_length(Potion *P, PN cl, PN self) {
+PN potion_tuple_length(Potion *P, PN cl, PN self, PN_SIZE argc, PN * volatile argv) {
   return PN_NUM(PN_TUPLE_LEN(self));
 }
 
@@ -261,8 +263,8 @@ void potion_tuple_ins_sort(PN self) {
   }
 }
 
-PN potion_lobby_list(Potion *P, PN cl, PN self, PN size) {
-  return potion_tuple_with_size(P, PN_INT(size));
+PN potion_lobby_list(Potion *P, PN cl, PN self, PN_SIZE argc, PN * volatile argv) {
+  return potion_tuple_with_size(P, PN_INT(PN_ARGV(0)));
 }
 
 void potion_table_init(Potion *P) {
@@ -271,26 +273,26 @@ void potion_table_init(Potion *P) {
   potion_type_call_is(tbl_vt, PN_FUNC(potion_table_at, "key=o"));
   potion_type_callset_is(tbl_vt, PN_FUNC(potion_table_put, "key=o,value=o"));
   potion_method(tbl_vt, "at", potion_table_at, "key=o");
-  potion_method(tbl_vt, "each", potion_table_each, "block=&");
-  potion_method(tbl_vt, "length", potion_table_length, 0);
+  potion_methodv(tbl_vt, "each", potion_table_each, "block=&");
+  potion_methodv(tbl_vt, "length", potion_table_length, 0);
   potion_method(tbl_vt, "put", potion_table_put, "key=o,value=o");
-  potion_method(tbl_vt, "remove", potion_table_remove, "index=o");
-  potion_method(tbl_vt, "string", potion_table_string, 0);
+  potion_methodv(tbl_vt, "remove", potion_table_remove, "index=o");
+  potion_methodv(tbl_vt, "string", potion_table_string, 0);
   potion_type_call_is(tpl_vt, PN_FUNC(potion_tuple_at, "index=N"));
   potion_type_callset_is(tpl_vt, PN_FUNC(potion_tuple_put, "index=N,value=o"));
-  potion_method(tpl_vt, "append", potion_tuple_append, "value=o");
+  potion_methodv(tpl_vt, "append", potion_tuple_append, "value=o");
   potion_method(tpl_vt, "at", potion_tuple_at, "index=N");
-  potion_method(tpl_vt, "each", potion_tuple_each, "block=&");
-  potion_method(tpl_vt, "clone", potion_tuple_clone, 0);
-  potion_method(tpl_vt, "first", potion_tuple_first, 0);
-  potion_method(tpl_vt, "join", potion_tuple_join, "|sep=S");
-  potion_method(tpl_vt, "last", potion_tuple_last, 0);
-  potion_method(tpl_vt, "length", potion_tuple_length, 0);
-  potion_method(tpl_vt, "print", potion_tuple_print, 0);
-  potion_method(tpl_vt, "pop", potion_tuple_pop, 0);
-  potion_method(tpl_vt, "push", potion_tuple_append, "value=o");
+  potion_methodv(tpl_vt, "each", potion_tuple_each, "block=&");
+  potion_methodv(tpl_vt, "clone", potion_tuple_clone, 0);
+  potion_methodv(tpl_vt, "first", potion_tuple_first, 0);
+  potion_methodv(tpl_vt, "join", potion_tuple_join, "|sep=S");
+  potion_methodv(tpl_vt, "last", potion_tuple_last, 0);
+  potion_methodv(tpl_vt, "length", potion_tuple_length, 0);
+  potion_methodv(tpl_vt, "print", potion_tuple_print, 0);
+  potion_methodv(tpl_vt, "pop", potion_tuple_pop, 0);
+  potion_methodv(tpl_vt, "push", potion_tuple_append, "value=o");
   potion_method(tpl_vt, "put", potion_tuple_put, "index=N,value=o");
   // TODO: add Tuple remove
-  potion_method(tpl_vt, "string", potion_tuple_string, 0);
-  potion_method(P->lobby, "list", potion_lobby_list, "length=N");
+  potion_methodv(tpl_vt, "string", potion_tuple_string, 0);
+  potion_methodv(P->lobby, "list", potion_lobby_list, "length=N");
 }
@@ -0,0 +1,624 @@
+//
+// trace.c
+// the tracing tier: records hot loops as they run
+// in the bytecode vm and compiles them to x86-64
+//
+// (c) 2008 why the lucky stiff, the freelance professor
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "potion.h"
+#include "internal.h"
+#include "opcodes.h"
+#include "asm.h"
+#include "khash.h"
+#include "table.h"
+
+//
+// a loop header becomes hot after TRACE_HOT backward
+// jumps to it. the vm then records one trip around the
+// loop (only the ops in the loop's own frame, calls are
+// recorded as a single op) and, when the recording
+// makes it back to the header, it's compiled.
+//
+// the compiled trace works on the vm's registers and
+// locals in place, so a guard that fails can just hand
+// a bytecode position back to the vm and it picks up
+// from there. (a side exit.)
+//
+#define TRACE_HOT    56
+#define TRACE_MAX    512
+#define TRACE_ABORTS 4
+
+typedef PN_SIZE (*PN_TRACE_F)(Potion *, PN *, PN *, PN *, PN);
+
+struct PNTrace {
+  PN_SIZE len;
+  struct {
+    PN_TRACE_F fn;
+    unsigned short hits, aborts;
+  } at[0];
+};
+
+struct PNTraceRec {
+  struct PNTrace *trace;
+  PN *frame;
+  PN_SIZE head, len;
+  PN_SIZE pos[TRACE_MAX];
+  u8 num[TRACE_MAX]; // operands were fixnums when recorded
+};
+
+#if POTION_JIT == 1 && POTION_X86 == POTION_JIT_TARGET && __WORDSIZE == 64
+#define POTION_TRACE_X64 1
+#endif
+
+static struct PNTrace *potion_trace_of(struct PNProto *f) {
+  if (f->traces == NULL) {
+    PN_SIZE len = PN_OP_LEN(f->asmb);
+    f->traces = calloc(1, sizeof(struct PNTrace) + len * sizeof(f->traces->at[0]));
+    f->traces->len = len;
+  }
+  return f->traces;
+}
+
+void potion_trace_abort(Potion *P, struct PNTraceRec **rec) {
+  free(*rec);
+  *rec = NULL;
+}
+
+//
+// the helpers called from traces. potion_trace_op
+// runs any op the trace can't inline, exactly as the
+// vm would (without switching frames for a call.)
+//
+#ifdef POTION_TRACE_X64
+static PN potion_trace_loadk(Potion *P, PN proto, PN_SIZE n) {
+  return PN_TUPLE_AT(PN_PROTO(proto)->values, n);
+}
+
+static void potion_trace_setref(Potion *P, PN ref, PN val) {
+  PN_DEREF(ref) = val;
+  PN_TOUCH(ref);
+}
+
+static void potion_trace_op(Potion *P, PN *reg, unsigned long opw) {
+  PN_OP op;
+  memcpy(&op, &opw, sizeof(PN_OP));
+  switch (op.code) {
+    case OP_NEWTUPLE:
+      reg[op.a] = PN_TUP0();
+    break;
+    case OP_SETTUPLE:
+      reg[op.a] = PN_PUSH(reg[op.a], reg[op.b]);
+    break;
+    case OP_SETTABLE:
+      potion_table_set(P, reg[op.a], reg[op.a + 1], reg[op.b]);
+    break;
+    case OP_NEWLICK: {
+      PN attr = op.b > op.a ? reg[op.a + 1] : PN_NIL;
+      PN inner = op.b > op.a + 1 ? reg[op.b] : PN_NIL;
+      reg[op.a] = potion_lick(P, reg[op.a], attr, inner);
+    }
+    break;
+    case OP_GETPATH:
+      reg[op.a] = potion_obj_get(P, PN_NIL, reg[op.a], reg[op.b]);
+    break;
+    case OP_SETPATH:
+      potion_obj_set(P, PN_NIL, reg[op.a], reg[op.a + 1], reg[op.b]);
+    break;
+    case OP_ADD: reg[op.a] = potion_obj_add(P, reg[op.a], reg[op.b]); break;
+    case OP_SUB: reg[op.a] = potion_obj_sub(P, reg[op.a], reg[op.b]); break;
+    case OP_MULT: reg[op.a] = potion_obj_mult(P, reg[op.a], reg[op.b]); break;
+    case OP_DIV: reg[op.a] = potion_obj_div(P, reg[op.a], reg[op.b]); break;
+    case OP_REM: reg[op.a] = potion_obj_rem(P, reg[op.a], reg[op.b]); break;
+    case OP_BITL: reg[op.a] = potion_obj_bitl(P, reg[op.a], reg[op.b]); break;
+    case OP_BITR: reg[op.a] = potion_obj_bitr(P, reg[op.a], reg[op.b]); break;
+    case OP_BITN: reg[op.a] = potion_obj_bitn(P, reg[op.b]); break;
+    case OP_POW:
+      reg[op.a] = PN_NUM((int)pow((double)PN_INT(reg[op.a]),
+        (double)PN_INT(reg[op.b])));
+    break;
+    case OP_DEF:
+      reg[op.a] = potion_def_method(P, PN_NIL, reg[op.a], reg[op.a + 1], reg[op.b]);
+    break;
+    case OP_BIND:
+      reg[op.a] = potion_bind(P, reg[op.b], reg[op.a]);
+    break;
+    case OP_MESSAGE:
+      reg[op.a] = potion_message(P, reg[op.b], reg[op.a]);
+    break;
+    case OP_NAMED: {
+      int x = potion_vm_named(P, reg[op.a], reg[op.b - 1], (PN_SIZE)opw);
+      if (x >= 0 && x < op.b - op.a - 3) reg[op.a + x + 2] = reg[op.b];
+    }
+    break;
+    case OP_GETTABLE:
+      if (PN_IS_TUPLE(reg[op.a]) && PN_IS_NUM(reg[op.b])) {
+        reg[op.a] = potion_tuple_at(P, PN_NIL, reg[op.a], reg[op.b]);
+        break;
+      }
+      if (PN_IS_TABLE(reg[op.a])) {
+        reg[op.a] = potion_table_at(P, PN_NIL, reg[op.a], reg[op.b]);
+        break;
+      }
+    case OP_CALL:
+      switch (PN_TYPE(reg[op.a])) {
+        case PN_TVTABLE:
+          reg[op.a + 1] = potion_object_new(P, PN_NIL, reg[op.a]);
+          reg[op.a] = ((struct PNVtable *)reg[op.a])->ctor;
+        case PN_TCLOSURE:
+          reg[op.a] = potion_call(P, reg[op.a], op.b - op.a, reg + op.a + 1);
+        break;
+        default:
+          reg[op.a + 1] = reg[op.a];
+          reg[op.a] = potion_obj_get_call(P, reg[op.a]);
+          if (PN_IS_CLOSURE(reg[op.a]))
+            reg[op.a] = potion_call(P, reg[op.a], op.b - op.a, &reg[op.a + 1]);
+        break;
+      }
+    break;
+    case OP_CALLSET:
+      reg[op.a] = potion_obj_get_callset(P, reg[op.b]);
+    break;
+    case OP_PUTTABLE:
+      reg[op.a] = potion_vm_puttable(P, reg[op.a], reg[op.a + 1], reg[op.b]);
+    break;
+    case OP_CONCAT:
+      reg[op.a] = potion_vm_concat(P, reg[op.a], op.b - op.a, &reg[op.a + 1]);
+    break;
+    case OP_CLASS:
+      reg[op.a] = potion_vm_class(P, reg[op.b], reg[op.a]);
+    break;
+  }
+}
+
+//
+// x86-64 emitter. inside a trace:
+//   %rbx = registers, %r12 = locals, %r13 = upvals,
+//   %r14 = Potion, -40(%rbp) = proto (where the gc can
+//   see it and move it.)
+// the exit stub sits at the very start of the code, so
+// every side exit is a backwards jump with a known offset.
+//
+#define RAX 0
+#define RCX 1
+#define RDX 2
+#define RBX 3
+#define RBP 5
+#define RSI 6
+#define R12 12
+#define R13 13
+
+#define TRACE_ENTRY 15
+
+#define TR_LOAD(r, base, n)  potion_trace_mem(P, asmp, 0x8B, r, base, (n) * sizeof(PN))
+#define TR_STORE(r, base, n) potion_trace_mem(P, asmp, 0x89, r, base, (n) * sizeof(PN))
+#define TR_TAG() ASM(0x48); ASM(0x8D); ASM(0x44); ASM(0x00); ASM(0x01) /* lea 1(%rax,%rax) %rax */
+#define TR_UNTAG(r) ASM(0x48); ASM(0xD1); ASM(0xF8 | (r)) /* sar %r */
+#define TR_FALSY() ASM(0x48); ASM(0x83); ASM(0xE0); ASM(0xFD) /* and ~PN_FALSE %rax */
+#define TR_BOOL(cc) \
+        ASM(0x0F); ASM(cc); ASM(0xC0); /* setcc %al */ \
+        ASM(0x0F); ASM(0xB6); ASM(0xC0); /* movzbl %al %eax */ \
+        ASM(0x48); ASM(0x8D); ASM(0x04); ASM(0x85); ASMI(PN_FALSE) /* lea 2(,%rax,4) %rax */
+#define TR_CALL(fn) \
+        ASM(0x4C); ASM(0x89); ASM(0xF7); /* mov %r14 %rdi */ \
+        ASM(0x48); ASM(0xB8); ASMN(fn); /* mov &fn %rax */ \
+        ASM(0xFF); ASM(0xD0) /* callq %rax */
+#define TR_LABEL(at) (*asmp)->ptr[at] = (u8)((*asmp)->len - ((at) + 1))
+
+static void potion_trace_mem(Potion *P, PNAsm * volatile *asmp, u8 opc, int r, int base, long disp) {
+  ASM(0x48 | (r >= 8 ? 4 : 0) | (base >= 8 ? 1 : 0));
+  ASM(opc);
+  ASM(0x80 | ((r & 7) << 3) | (base & 7));
+  if ((base & 7) == 4) ASM(0x24);
+  ASMI(disp);
+}
+
+// leave the trace at `pos` unless the flags say `stay`
+static void potion_trace_exit(Potion *P, PNAsm * volatile *asmp, u8 stay, PN_SIZE pos) {
+  ASM(stay); ASM(10);
+  ASM(0xB8); ASMI(pos); /* mov pos %eax */
+  ASM(0xE9); ASMI(0 - ((long)(*asmp)->len + 4)); /* jmp exit */
+}
+
+static void potion_trace_guard(Potion *P, PNAsm * volatile *asmp, u8 *known, int r, PN_SIZE pos) {
+  if (known[r]) return;
+  ASM(0xF6); ASM(0x83); ASMI(r * sizeof(PN)); ASM(0x01); /* testb 0x1 r(%rbx) */
+  potion_trace_exit(P, asmp, 0x75, pos); /* jne stay */
+  known[r] = 1;
+}
+
+static void potion_trace_slow(Potion *P, PNAsm * volatile *asmp, PN_OP op) {
+  unsigned long opw;
+  memcpy(&opw, &op, sizeof(PN_OP));
+  ASM(0x48); ASM(0x89); ASM(0xDE); /* mov %rbx %rsi */
+  ASM(0x48); ASM(0xBA); ASMN(opw); /* mov op %rdx */
+  TR_CALL(potion_trace_op);
+}
+
+// does `op` read register `r`?
+static int potion_trace_reads(PN_OP op, int r) {
+  switch (op.code) {
+    case OP_LOADK: case OP_LOADPN: case OP_SELF: case OP_NEWTUPLE:
+    case OP_GETLOCAL: case OP_GETUPVAL: case OP_JMP:
+    return 0;
+    case OP_MOVE: case OP_BITN: case OP_CALLSET:
+    return r == op.b;
+    case OP_SETLOCAL: case OP_SETUPVAL: case OP_TEST: case OP_NOT:
+    case OP_TESTJMP: case OP_NOTJMP: case OP_GUARD:
+    return r == op.a;
+  }
+  return r == op.a || r == op.a + 1 || r == op.b || (r > op.a && r <= op.b + 1);
+}
+
+// does `op` write register `r`? (-1 means it might write anything.)
+static int potion_trace_writes(PN_OP op, int r) {
+  switch (op.code) {
+    case OP_SETLOCAL: case OP_SETUPVAL: case OP_SETTABLE: case OP_SETPATH:
+    case OP_JMP: case OP_TESTJMP: case OP_NOTJMP:
+    return 0;
+    case OP_CALL: case OP_TAILCALL: case OP_GETTABLE:
+    return r == op.a || r == op.a + 1;
+    case OP_NAMED:
+    return -1;
+  }
+  return r == op.a;
+}
+
+//
+// loop-invariant constants: a LOADK or LOADPN whose
+// register is never written any other way in the trace
+// and isn't read before it's loaded can be done once,
+// before the loop.
+//
+static int potion_trace_invariant(struct PNProto *f, struct PNTraceRec *rec, PN_SIZE k) {
+  PN_SIZE i;
+  PN_OP op = PN_OP_AT(f->asmb, rec->pos[k]);
+  if (op.code != OP_LOADK && op.code != OP_LOADPN) return 0;
+  for (i = 0; i < rec->len; i++) {
+    PN_OP op2 = PN_OP_AT(f->asmb, rec->pos[i]);
+    if (op2.code == op.code && op2.a == op.a && op2.b == op.b) continue;
+    if (potion_trace_writes(op2, op.a)) return 0;
+    if (i < k && potion_trace_reads(op2, op.a)) return 0;
+  }
+  return 1;
+}
+
+static PN_TRACE_F potion_trace_compile(Potion *P, struct PNProto * volatile f, struct PNTraceRec *rec) {
+  PNAsm * volatile asmb = potion_asm_new(P);
+  PNAsm * volatile *asmp = &asmb;
+  PN_SIZE i, loop;
+  long nreg = PN_INT(f->stack) + 1;
+  u8 *known = calloc(nreg + f->localsize + 1, 1), *lknown = known + nreg;
+  u8 *hoist = calloc(rec->len, 1), *inv = calloc(nreg, 1);
+  u8 *fn;
+
+  // exit: (%eax = bytecode position)
+  ASM(0x48); ASM(0x8D); ASM(0x65); ASM(0xE0); /* lea -32(%rbp) %rsp */
+  ASM(0x41); ASM(0x5E); ASM(0x41); ASM(0x5D); /* pop %r14, %r13 */
+  ASM(0x41); ASM(0x5C); ASM(0x5B); ASM(0x5D); /* pop %r12, %rbx, %rbp */
+  ASM(0xC3); /* ret */
+  ASM(0x90); ASM(0x90); /* nop */
+
+  // entry: (P, reg, locals, upvals, proto)
+  ASM(0x55); /* push %rbp */
+  ASM(0x48); ASM(0x89); ASM(0xE5); /* mov %rsp %rbp */
+  ASM(0x53); ASM(0x41); ASM(0x54); /* push %rbx, %r12 */
+  ASM(0x41); ASM(0x55); ASM(0x41); ASM(0x56); /* push %r13, %r14 */
+  ASM(0x48); ASM(0x83); ASM(0xEC); ASM(0x10); /* sub 0x10 %rsp */
+  ASM(0x49); ASM(0x89); ASM(0xFE); /* mov %rdi %r14 */
+  ASM(0x48); ASM(0x89); ASM(0xF3); /* mov %rsi %rbx */
+  ASM(0x49); ASM(0x89); ASM(0xD4); /* mov %rdx %r12 */
+  ASM(0x49); ASM(0x89); ASM(0xCD); /* mov %rcx %r13 */
+  ASM(0x4C); ASM(0x89); ASM(0x45); ASM(0xD8); /* mov %r8 -40(%rbp) */
+  ASM(0x48); ASM(0xC7); ASM(0x45); ASM(0xD0); ASMI(0); /* movq 0 -48(%rbp) (no junk for the gc) */
+
+  // hoist invariant constants
+  if (rec->len > 1) {
+    int named = 0;
+    for (i = 0; i < rec->len; i++)
+      if (PN_OP_AT(f->asmb, rec->pos[i]).code == OP_NAMED) named = 1;
+    for (i = 0; i < rec->len && !named; i++) {
+      PN_OP op = PN_OP_AT(f->asmb, rec->pos[i]);
+      PN v = op.code == OP_LOADPN ? (PN)op.b :
+        (op.code == OP_LOADK ? PN_TUPLE_AT(f->values, op.b) : PN_NIL);
+      if (!potion_trace_invariant(f, rec, i)) continue;
+      hoist[i] = 1;
+      if (inv[op.a]) continue;
+      inv[op.a] = 1;
+      if (PN_IS_PTR(v)) {
+        ASM(0x48); ASM(0x8B); ASM(0x75); ASM(0xD8); /* mov -40(%rbp) %rsi */
+        ASM(0xBA); ASMI(op.b); /* mov b %edx */
+        TR_CALL(potion_trace_loadk);
+      } else {
+        ASM(0x48); ASM(0xB8); ASMN(v); /* mov v %rax */
+        known[op.a] = PN_IS_NUM(v);
+      }
+      TR_STORE(RAX, RBX, op.a);
+    }
+  }
+
+#define TR_FORGET() \
+  for (i2 = 0; i2 < nreg; i2++) if (!inv[i2]) known[i2] = 0; \
+  PN_MEMZERO_N(lknown, u8, f->localsize)
+
+  loop = asmb->len;
+  for (i = 0; i < rec->len; i++) {
+    PN_SIZE pos = rec->pos[i], i2;
+    PN_OP op = PN_OP_AT(f->asmb, pos);
+    int at, at2;
+    if (hoist[i]) continue;
+    switch (op.code) {
+      case OP_MOVE:
+        TR_LOAD(RAX, RBX, op.b);
+        TR_STORE(RAX, RBX, op.a);
+        known[op.a] = known[op.b];
+      break;
+      case OP_LOADPN:
+        ASM(0x48); ASM(0xC7); ASM(0x83); ASMI(op.a * sizeof(PN)); ASMI(op.b); /* movq b -a(%rbx) */
+        known[op.a] = PN_IS_NUM(op.b);
+      break;
+      case OP_LOADK: {
+        PN v = PN_TUPLE_AT(f->values, op.b);
+        if (PN_IS_PTR(v)) {
+          ASM(0x48); ASM(0x8B); ASM(0x75); ASM(0xD8); /* mov -40(%rbp) %rsi */
+          ASM(0xBA); ASMI(op.b); /* mov b %edx */
+          TR_CALL(potion_trace_loadk);
+        } else {
+          ASM(0x48); ASM(0xB8); ASMN(v); /* mov v %rax */
+        }
+        TR_STORE(RAX, RBX, op.a);
+        known[op.a] = PN_IS_NUM(v);
+      }
+      break;
+      case OP_SELF:
+        TR_LOAD(RAX, RBX, -1);
+        TR_STORE(RAX, RBX, op.a);
+        known[op.a] = 0;
+      break;
+      case OP_GETLOCAL:
+        TR_LOAD(RAX, R12, op.b);
+        if (!PN_LOCAL_REF(f, op.b)) {
+          TR_STORE(RAX, RBX, op.a);
+          known[op.a] = lknown[op.b];
+          break;
+        }
+        ASM(0xA8); ASM(PN_PRIMITIVE); /* test PRIMITIVE %al */
+        ASM(0x75); at = asmb->len; ASM(0); /* jne [a] */
+        ASM(0x48); ASM(0xA9); ASMI(-8); /* test ~7 %rax */
+        ASM(0x74); ASM(0); /* je [a] */
+        ASM(0x81); ASM(0x38); ASMI(PN_TWEAK); /* cmpl PN_TWEAK (%rax) */
+        ASM(0x75); ASM(0); /* jne [a] */
+        ASM(0x48); ASM(0x8B); ASM(0x40); ASM(sizeof(struct PNObject)); /* mov data(%rax) %rax */
+        TR_LABEL(at); TR_LABEL(at + 8); TR_LABEL(at + 16); /* [a] */
+        TR_STORE(RAX, RBX, op.a);
+        known[op.a] = lknown[op.b];
+      break;
+      case OP_SETLOCAL:
+        if (!PN_LOCAL_REF(f, op.b)) {
+          TR_LOAD(RAX, RBX, op.a);
+          TR_STORE(RAX, R12, op.b);
+          lknown[op.b] = known[op.a];
+          break;
+        }
+        TR_LOAD(RAX, R12, op.b);
+        ASM(0xA8); ASM(PN_PRIMITIVE); /* test PRIMITIVE %al */
+        ASM(0x75); at = asmb->len; ASM(0); /* jne [a] */
+        ASM(0x48); ASM(0xA9); ASMI(-8); /* test ~7 %rax */
+        ASM(0x74); ASM(0); /* je [a] */
+        ASM(0x81); ASM(0x38); ASMI(PN_TWEAK); /* cmpl PN_TWEAK (%rax) */
+        ASM(0x75); ASM(0); /* jne [a] */
+        ASM(0x48); ASM(0x89); ASM(0xC6); /* mov %rax %rsi */
+        TR_LOAD(RDX, RBX, op.a);
+        TR_CALL(potion_trace_setref);
+        ASM(0xEB); at2 = asmb->len; ASM(0); /* jmp [b] */
+        TR_LABEL(at); TR_LABEL(at + 8); TR_LABEL(at + 16); /* [a] */
+        TR_LOAD(RAX, RBX, op.a);
+        TR_STORE(RAX, R12, op.b);
+        TR_LABEL(at2); /* [b] */
+        lknown[op.b] = known[op.a];
+      break;
+      case OP_GETUPVAL:
+        TR_LOAD(RAX, R13, op.b);
+        if (!PN_UPVAL_FLAT(f, op.b)) {
+          ASM(0x48); ASM(0x8B); ASM(0x40); ASM(sizeof(struct PNObject)); /* mov data(%rax) %rax */
+        }
+        TR_STORE(RAX, RBX, op.a);
+        known[op.a] = 0;
+      break;
+      case OP_SETUPVAL:
+        TR_LOAD(RSI, R13, op.b);
+        TR_LOAD(RDX, RBX, op.a);
+        TR_CALL(potion_trace_setref);
+      break;
+      case OP_ADD: case OP_SUB: case OP_MULT: case OP_DIV:
+      case OP_REM: case OP_BITL: case OP_BITR:
+        if (!rec->num[i]) goto slow;
+        potion_trace_guard(P, asmp, known, op.a, pos);
+        potion_trace_guard(P, asmp, known, op.b, pos);
+        TR_LOAD(RAX, RBX, op.a);
+        switch (op.code) {
+          case OP_ADD:
+            TR_LOAD(RDX, RBX, op.b);
+            ASM(0x48); ASM(0x8D); ASM(0x44); ASM(0x10); ASM(0xFF); /* lea -1(%rax,%rdx) %rax */
+          break;
+          case OP_SUB:
+            TR_LOAD(RDX, RBX, op.b);
+            ASM(0x48); ASM(0x29); ASM(0xD0); /* sub %rdx %rax */
+            ASM(0x48); ASM(0x83); ASM(0xC8); ASM(0x01); /* or 0x1 %rax */
+          break;
+          case OP_MULT:
+            TR_LOAD(RDX, RBX, op.b);
+            TR_UNTAG(RAX);
+            ASM(0x48); ASM(0x83); ASM(0xE2); ASM(0xFE); /* and ~1 %rdx */
+            ASM(0x48); ASM(0x0F); ASM(0xAF); ASM(0xC2); /* imul %rdx %rax */
+            ASM(0x48); ASM(0x83); ASM(0xC8); ASM(0x01); /* or 0x1 %rax */
+          break;
+          case OP_DIV: case OP_REM:
+            TR_LOAD(RCX, RBX, op.b);
+            TR_UNTAG(RCX);
+            potion_trace_exit(P, asmp, 0x75, pos); /* jne stay (if %rcx != 0) */
+            TR_UNTAG(RAX);
+            ASM(0x48); ASM(0x99); /* cqo */
+            ASM(0x48); ASM(0xF7); ASM(0xF9); /* idiv %rcx */
+            if (op.code == OP_REM) { ASM(0x48); ASM(0x89); ASM(0xD0); } /* mov %rdx %rax */
+            TR_TAG();
+          break;
+          case OP_BITL: case OP_BITR:
+            TR_LOAD(RCX, RBX, op.b);
+            TR_UNTAG(RCX);
+            TR_UNTAG(RAX);
+            ASM(0x48); ASM(0xD3); ASM(op.code == OP_BITL ? 0xE0 : 0xF8); /* shl/sar %cl %rax */
+            TR_TAG();
+          break;
+        }
+        TR_STORE(RAX, RBX, op.a);
+        known[op.a] = 1;
+      break;
+      case OP_BITN:
+        if (!rec->num[i]) goto slow;
+        potion_trace_guard(P, asmp, known, op.b, pos);
+        TR_LOAD(RAX, RBX, op.b);
+        ASM(0x48); ASM(0xF7); ASM(0xD0); /* not %rax */
+        ASM(0x48); ASM(0x83); ASM(0xC8); ASM(0x01); /* or 0x1 %rax */
+        TR_STORE(RAX, RBX, op.a);
+        known[op.a] = 1;
+      break;
+      case OP_NOT: case OP_TEST:
+        TR_LOAD(RAX, RBX, op.a);
+        TR_FALSY();
+        ASM(0x48); ASM(0x85); ASM(0xC0); /* test %rax %rax */
+        TR_BOOL(op.code == OP_NOT ? 0x94 : 0x95); /* sete/setne */
+        TR_STORE(RAX, RBX, op.a);
+        known[op.a] = 0;
+      break;
+      case OP_GUARD:
+        ASM(0x48); ASM(0x8B); ASM(0x75); ASM(0xD8); /* mov -40(%rbp) %rsi */
+        TR_LOAD(RDX, RBX, op.a);
+        ASM(0xB9); ASMI(op.b); /* mov b %ecx */
+        TR_CALL(potion_vm_guard);
+        TR_STORE(RAX, RBX, op.a);
+        known[op.a] = 0;
+      break;
+      case OP_CMP:
+        TR_LOAD(RAX, RBX, op.b);
+        TR_LOAD(RDX, RBX, op.a);
+        TR_UNTAG(RAX);
+        TR_UNTAG(RDX);
+        ASM(0x48); ASM(0x29); ASM(0xD0); /* sub %rdx %rax */
+        TR_TAG();
+        TR_STORE(RAX, RBX, op.a);
+        known[op.a] = 1;
+      break;
+      case OP_EQ: case OP_NEQ: case OP_LT:
+      case OP_LTE: case OP_GT: case OP_GTE: {
+        static const u8 cc[] = { 0x94, 0x95, 0x9C, 0x9E, 0x9F, 0x9D };
+        TR_LOAD(RAX, RBX, op.a);
+        TR_LOAD(RDX, RBX, op.b);
+        ASM(0x48); ASM(0x39); ASM(0xD0); /* cmp %rdx %rax */
+        TR_BOOL(cc[op.code - OP_EQ]);
+        TR_STORE(RAX, RBX, op.a);
+        known[op.a] = 0;
+      }
+      break;
+      case OP_TESTJMP: case OP_NOTJMP: {
+        int taken = rec->pos[i + 1] != pos + 1;
+        int truthy = (op.code == OP_TESTJMP) == taken;
+        TR_LOAD(RAX, RBX, op.a);
+        TR_FALSY();
+        ASM(0x48); ASM(0x85); ASM(0xC0); /* test %rax %rax */
+        potion_trace_exit(P, asmp, truthy ? 0x75 : 0x74, /* jne/je stay */
+          taken ? pos + 1 : pos + op.b + 1);
+      }
+      break;
+      case OP_JMP:
+        if (i == rec->len - 1) {
+          ASM(0xE9); ASMI(loop - ((long)asmb->len + 4)); /* jmp loop */
+        }
+      break;
+      default:
+      slow:
+        potion_trace_slow(P, asmp, op);
+        TR_FORGET();
+      break;
+    }
+  }
+
+  fn = potion_code_new(P, (PN)f, asmb->ptr, asmb->len);
+  free(known);
+  free(hoist);
+  free(inv);
+  return (PN_TRACE_F)(fn + TRACE_ENTRY);
+}
+#endif
+
+//
+// called by the vm before each op while a recording is
+// going. callee frames are skipped (their CALL is one
+// op in the trace) and anything the trace can't express
+// abandons the recording.
+//
+void potion_trace_record(Potion *P, struct PNTraceRec **recp, struct PNProto *f, PN *current, PN_SIZE pos) {
+  struct PNTraceRec *rec = *recp;
+  PN_OP op;
+  PN *reg;
+  if (current != rec->frame) {
+    if (current < rec->frame) goto abort;
+    return;
+  }
+
+  op = PN_OP_AT(f->asmb, pos);
+  switch (op.code) {
+    case OP_RETURN: case OP_PROTO: case OP_TAILCALL:
+    goto abort;
+    case OP_JMP:
+      if (op.a < 0 && pos + op.a + 1 != rec->head) goto abort;
+    break;
+  }
+  if (rec->len >= TRACE_MAX) goto abort;
+
+  reg = current + f->upvalsize + f->localsize + 1;
+  rec->num[rec->len] = op.code >= OP_ADD && op.code <= OP_BITR &&
+    PN_IS_NUM(reg[op.a]) && PN_IS_NUM(reg[op.b]);
+  rec->pos[rec->len++] = pos;
+  return;
+
+abort:
+  rec->trace->at[rec->head].aborts++;
+  potion_trace_abort(P, recp);
+}
+
+//
+// called by the vm on every backward jump (when tracing
+// is on.) counts loop trips, starts and finishes
+// recordings and runs compiled traces. returns the
+// position the vm should continue at.
+//
+PN_SIZE potion_trace_loop(Potion *P, struct PNProto * volatile f, struct PNTraceRec **recp, PN *current, PN_SIZE head) {
+#ifdef POTION_TRACE_X64
+  struct PNTrace *t = potion_trace_of(f);
+  struct PNTraceRec *rec = *recp;
+  PN *locals = current + f->upvalsize;
+
+  if (rec != NULL && rec->frame == current && rec->head == head) {
+    t->at[head].fn = potion_trace_compile(P, f, rec);
+    potion_trace_abort(P, recp);
+    rec = NULL;
+  }
+
+  if (t->at[head].fn != NULL)
+    return t->at[head].fn(P, locals + f->localsize + 1, locals, current, (PN)f);
+
+  if (rec == NULL && t->at[head].aborts < TRACE_ABORTS && ++t->at[head].hits >= TRACE_HOT) {
+    t->at[head].hits = 0;
+    rec = *recp = malloc(sizeof(struct PNTraceRec));
+    rec->trace = t;
+    rec->frame = current;
+    rec->head = head;
+    rec->len = 0;
+  }
+#endif
+  return head;
+}
@@ -0,0 +1,4 @@
+#define POTION_DATE   "2026-10-18"
+#define POTION_COMMIT "7cf279a"
+#define POTION_REV    1
+
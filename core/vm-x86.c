@@ -6,6 +6,7 @@
 //
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <math.h>
 #include "potion.h"
 #include "internal.h"
@@ -16,6 +17,7 @@
 
 #define RBP(x)  (0x100 - ((x + 1) * sizeof(PN)))
 #define RBPI(x) (0x100 - ((x + 1) * sizeof(int)))
+#define RBP_NEAR(x) (((x) + 1) * sizeof(PN) <= 0x80)
 
 #if __WORDSIZE != 64
 #define X86_PRE_T 0
@@ -29,42 +31,65 @@
 #define X86C(op32, op64) op64
 #endif
 
+// a frame slot: the ModRM byte and the displacement off %rbp.
+// a disp8 covers the first few slots, bigger frames get a disp32.
+#define X86_RBP(modrm, x) ({ \
+        if (RBP_NEAR(x)) { ASM(modrm); ASM(RBP(x)); } \
+        else { ASM((modrm) + 0x40); ASMI(-(int)(((x) + 1) * sizeof(PN))); } \
+})
+#define X86_RBP_SIB(modrm, sib, x) ({ \
+        if (RBP_NEAR(x)) { ASM(modrm); ASM(sib); ASM(RBP(x)); } \
+        else { ASM((modrm) + 0x40); ASM(sib); ASMI(-(int)(((x) + 1) * sizeof(PN))); } \
+})
+// jumps are patched once their target is known
+#define X86_JCC(op) ({ ASM(op); ASM(0); asmp[0]->len - 1; })
+#define X86_JCC32(op) ({ ASM(0x0F); ASM(op); ASMI(0); asmp[0]->len - 4; })
+#define X86_JMP_HERE(at) \
+  asmp[0]->ptr[at] = (u8)(asmp[0]->len - (at + 1))
+#define X86_JMP32_HERE(at) \
+  *((int *)(asmp[0]->ptr + at)) = asmp[0]->len - (at + 4)
 #define X86_MOV_RBP(reg, x) \
-        X86_PRE(); ASM(reg); ASM(0x45); ASM(RBP(x))
+        X86_PRE(); ASM(reg); X86_RBP(0x45, x)
 #define X86_MOVQ(reg, x) \
         X86_PRE(); ASM(0xC7); /* movl */ \
-        ASM(0x45); ASM(RBP(reg)); /* -A(%rbp) */ \
+        X86_RBP(0x45, reg); /* -A(%rbp) */ \
         ASMI((PN)(x))
-#define X86_MATH(two, func, ops) ({ \
-        int asmpos = 0; \
+#define X86_MATH(two, func, sse, ops) ({ \
+        int asmpos = 0, fpos = -1; \
         X86_MOV_RBP(0x8B, op.a); /* mov -A(%rbp) %eax */ \
-        if (two) { X86_PRE(); ASM(0x8B); ASM(0x55); ASM(RBP(op.b)); } /* mov -B(%rbp) %edx */ \
+        if (two) { X86_PRE(); ASM(0x8B); X86_RBP(0x55, op.b); } /* mov -B(%rbp) %edx */ \
         ASM(0xF6); ASM(0xC0); ASM(0x01); /* test 0x1 %al */ \
         asmpos = (*asmp)->len; \
         ASM(0x74); ASM(0); /* je [a] */ \
         if (two) { ASM(0xF6); ASM(0xC2); ASM(0x01); /* test 0x1 %dl */ } \
         if (two) { ASM(0x74); ASM(0); /* je [a] */ } \
         ops; /* add, sub, ... */ \
-        (*asmp)->ptr[asmpos + 1] = ((*asmp)->len - asmpos); \
-        if (two) { (*asmp)->ptr[asmpos + 6] = ((*asmp)->len - asmpos) - 5; } \
+        (*asmp)->ptr[asmpos + 1] = ((*asmp)->len - asmpos) + 3; \
+        if (two) { (*asmp)->ptr[asmpos + 6] = ((*asmp)->len - asmpos) - 2; } \
         asmpos = (*asmp)->len; \
-        ASM(0xEB); ASM(0); /*  jmp [b] */ \
-        X86_ARGO(start - 3, 0); /* [a] */ \
+        ASM(0xE9); ASMI(0); /*  jmp [b] */ \
+        if (sse) fpos = potion_x86_sse(P, asmp, op, start, sse); /* [a] */ \
+        X86_ARGO(start - 3, 0); \
         X86_ARGO(op.a, 1); \
         X86_ARGO(op.b, 2); \
         X86_PRE(); ASM(0xB8); ASMN(func); /* mov &func %rax */ \
         ASM(0xFF); ASM(0xD0); /* callq %rax */ \
-        (*asmp)->ptr[asmpos + 1] = ((*asmp)->len - asmpos) - 2; \
+        *((int *)((*asmp)->ptr + asmpos + 1)) = ((*asmp)->len - asmpos) - 5; \
+        if (fpos >= 0) *((int *)((*asmp)->ptr + fpos)) = (*asmp)->len - (fpos + 4); \
         X86_MOV_RBP(0x89, op.a); /* mov -B(%rbp) %eax */ \
 })
-#define X86_CMP(ops) \
-        X86_PRE(); ASM(0x8B); ASM(0x55); ASM(RBP(op.a)); /* mov -A(%rbp) %edx */ \
+#define X86_CMP(ops) ({ \
+        int jcc, jmp; \
+        X86_PRE(); ASM(0x8B); X86_RBP(0x55, op.a); /* mov -A(%rbp) %edx */ \
         X86_MOV_RBP(0x8B, op.b); /* mov -B(%rbp) %eax */ \
         ASM(0x39); ASM(0xC2); /*  cmp %eax %edx */ \
-        ASM(ops); ASM(0x9 + X86_PRE_T); /*  jle +10 */ \
+        jcc = X86_JCC(ops); /*  jle [a] */ \
         X86_MOVQ(op.a, PN_TRUE); /*  -A(%rbp) = TRUE */ \
-        ASM(0xEB); ASM(0x7 + X86_PRE_T); /*  jmp +7 */ \
-        X86_MOVQ(op.a, PN_FALSE) /*  -A(%rbp) = FALSE */
+        jmp = X86_JCC(0xEB); /*  jmp [b] */ \
+        X86_JMP_HERE(jcc); \
+        X86_MOVQ(op.a, PN_FALSE); /*  [a] -A(%rbp) = FALSE */ \
+        X86_JMP_HERE(jmp); /* [b] */ \
+})
 #define X86_ARGO(regn, argn) potion_x86_c_arg(P, asmp, 1, regn, argn)
 #define X86_ARGI(regn, argn) potion_x86_c_arg(P, asmp, 0, regn, argn)
 #define TAG_JMP(jpos) \
@@ -136,7 +161,7 @@ static void potion_x86_c_arg(Potion *P, PNAsm * volatile *asmp, int out, int reg
     }
   } else {
     if (out) {
-      ASM(0x8b); ASM(0x55); ASM(RBP(regn));
+      ASM(0x8b); X86_RBP(0x55, regn);
     }
     if (!out) argn += 2;
     if (out) {
@@ -145,46 +170,200 @@ static void potion_x86_c_arg(Potion *P, PNAsm * volatile *asmp, int out, int reg
       ASM(0x8b); ASM(0x55); ASM(argn * sizeof(PN));
     }
     if (!out) {
-      ASM(0x89); ASM(0x55); ASM(RBP(regn));
+      ASM(0x89); X86_RBP(0x55, regn);
     }
   }
 #else
   switch (argn) {
     case 0:
-      X86_PRE(); ASM(out ? 0x8b : 0x89); ASM(0x7d); ASM(RBP(regn));
+      X86_PRE(); ASM(out ? 0x8b : 0x89); X86_RBP(0x7d, regn);
     break;
     case 1:
-      X86_PRE(); ASM(out ? 0x8b : 0x89); ASM(0x75); ASM(RBP(regn));
+      X86_PRE(); ASM(out ? 0x8b : 0x89); X86_RBP(0x75, regn);
     break;
     case 2:
-      X86_PRE(); ASM(out ? 0x8b : 0x89); ASM(0x55); ASM(RBP(regn));
+      X86_PRE(); ASM(out ? 0x8b : 0x89); X86_RBP(0x55, regn);
     break;
     case 3:
-      X86_PRE(); ASM(out ? 0x8b : 0x89); ASM(0x4d); ASM(RBP(regn));
+      X86_PRE(); ASM(out ? 0x8b : 0x89); X86_RBP(0x4d, regn);
     break;
     case 4:
-      ASM(0x4c); ASM(out ? 0x8b : 0x89); ASM(0x45); ASM(RBP(regn));
+      ASM(0x4c); ASM(out ? 0x8b : 0x89); X86_RBP(0x45, regn);
     break;
     case 5:
-      ASM(0x4c); ASM(out ? 0x8b : 0x89); ASM(0x4d); ASM(RBP(regn));
+      ASM(0x4c); ASM(out ? 0x8b : 0x89); X86_RBP(0x4d, regn);
     break;
-    default:
+    default: // %r11 is scratch (%rbx belongs to the caller)
       if (out) {
-        X86_PRE(); ASM(0x8B); ASM(0x5d); ASM(RBP(regn)); // mov %rbp(A) %rbx
+        ASM(0x4c); ASM(0x8B); X86_RBP(0x5d, regn); // mov %rbp(A) %r11
         if (argn == 6) {
-          X86_PRE(); ASM(0x89); ASM(0x1c); ASM(0x24);    // mov %rbx (%rsp)
+          ASM(0x4c); ASM(0x89); ASM(0x1c); ASM(0x24);    // mov %r11 (%rsp)
+        } else if ((argn - 6) * sizeof(PN) < 0x80) {
+          ASM(0x4c); ASM(0x89); ASM(0x5c); ASM(0x24); ASM((argn - 6) * sizeof(PN)); // mov %r11 N(%rsp)
         } else {
-          X86_PRE(); ASM(0x89); ASM(0x5c); ASM(0x24); ASM((argn - 6) * sizeof(PN)); // mov %rbx N(%rsp)
+          ASM(0x4c); ASM(0x89); ASM(0x9c); ASM(0x24); ASMI((argn - 6) * sizeof(PN)); // mov %r11 N(%rsp)
         }
       } else {
-        X86_PRE(); ASM(0x8b); ASM(0x5d); ASM((argn - 4) * sizeof(PN));
-        X86_PRE(); ASM(0x89); ASM(0x5d); ASM(RBP(regn)); // mov %rbp(A) %rbx
+        if ((argn - 4) * sizeof(PN) < 0x80) {
+          ASM(0x4c); ASM(0x8b); ASM(0x5d); ASM((argn - 4) * sizeof(PN));
+        } else {
+          ASM(0x4c); ASM(0x8b); ASM(0x9d); ASMI((argn - 4) * sizeof(PN));
+        }
+        ASM(0x4c); ASM(0x89); X86_RBP(0x5d, regn); // mov %rbp(A) %r11
       }
     break;
   }
 #endif
 }
 
+#if __WORDSIZE == 64
+void *potion_x86_gc_alloc(Potion *P, PNType vt, int siz) {
+  return potion_gc_alloc(P, vt, siz);
+}
+
+//
+// the inline version of potion_gc_alloc: bump birth_cur and
+// write the header, leaving the new object in %rax. the uniq
+// is left at zero (it's handed out lazily, see PN_UNIQ) and
+// the collector is only called when the birth region is full.
+// clobbers %rcx, %rdx and %rsi.
+//
+static void potion_x86_alloc(Potion *P, PNAsm * volatile *asmp, long start, PNType vt, int siz) {
+  int full, dirty, done;
+  if (siz < sizeof(struct PNFwd))
+    siz = sizeof(struct PNFwd);
+  siz = PN_ALIGN(siz, 8);
+  ASM(0x48); ASM(0xB9); ASMN(P->mem); // mov M %rcx
+  ASM(0x83); ASM(0x79); ASM(offsetof(struct PNMemory, dirty)); ASM(0); // cmpl 0 dirty(%rcx)
+  dirty = X86_JCC(0x75); // jne slow
+  ASM(0x48); ASM(0x8B); ASM(0x41); ASM(offsetof(struct PNMemory, birth_cur)); // mov cur(%rcx) %rax
+  ASM(0x48); ASM(0x8D); ASM(0x90); ASMI(siz); // lea siz(%rax) %rdx
+  ASM(0x48); ASM(0x8B); ASM(0x71); ASM(offsetof(struct PNMemory, birth_storeptr)); // mov storeptr(%rcx) %rsi
+  ASM(0x48); ASM(0x83); ASM(0xEE); ASM(2); // sub 2 %rsi
+  ASM(0x48); ASM(0x39); ASM(0xF2); // cmp %rsi %rdx
+  full = X86_JCC(0x73); // jae slow
+  ASM(0x48); ASM(0x89); ASM(0x51); ASM(offsetof(struct PNMemory, birth_cur)); // mov %rdx cur(%rcx)
+  ASM(0x48); ASM(0xC7); ASM(0x00); ASMI(vt); // movq vt (%rax)
+  done = X86_JCC(0xEB); // jmp done
+  X86_JMP_HERE(dirty);
+  X86_JMP_HERE(full);
+  X86_ARGO(start - 3, 0);
+  ASM(0xBE); ASMI(vt); // mov vt %esi
+  ASM(0xBA); ASMI(siz); // mov siz %edx
+  X86_PRE(); ASM(0xB8); ASMN(potion_x86_gc_alloc); // mov &potion_x86_gc_alloc %rax
+  ASM(0xFF); ASM(0xD0); // callq %rax
+  X86_JMP_HERE(done);
+}
+
+// test BITS %al (or %dl)
+static void potion_x86_test_low(Potion *P, PNAsm * volatile *asmp, int r, u8 bits) {
+  if (r == 0) { ASM(0xA8); ASM(bits); } // test BITS %al
+  else { ASM(0xF6); ASM(0xC2); ASM(bits); } // test BITS %dl
+}
+
+// loads the number in %rax (or %rdx) into %xmm0 (or %xmm1),
+// clobbering %rcx.
+static void potion_x86_sse_load(Potion *P, PNAsm * volatile *asmp, int r) {
+  int ptr, done, flo = -1;
+  potion_x86_test_low(P, asmp, r, PN_FNUMBER);
+  ptr = X86_JCC(0x74); // je [ptr]
+  ASM(0x48); ASM(0x89); ASM(0xC1 | (r << 3)); // mov %rax %rcx
+  ASM(0x48); ASM(0xD1); ASM(0xF9); // sar %rcx
+  ASM(0xF2); ASM(0x48); ASM(0x0F); ASM(0x2A); ASM(0xC1 | (r << 2)); // cvtsi2sd %rcx %xmm0
+  done = X86_JCC(0xEB); // jmp [done]
+  X86_JMP_HERE(ptr);
+#if PN_FLONUM
+  // see potion_flonum_dbl
+  potion_x86_test_low(P, asmp, r, PN_FDECIMAL);
+  ptr = X86_JCC(0x74); // je [ptr]
+  ASM(0x48); ASM(0x89); ASM(0xC1 | (r << 3)); // mov %rax %rcx
+  ASM(0x48); ASM(0xC1); ASM(0xE9); ASM(63); // shr 63 %rcx
+  ASM(0x48); ASM(0x29); ASM(0xC8 | r); // sub %rcx %rax
+  ASM(0x48); ASM(0xC1); ASM(0xC8 | r); ASM(4); // ror 4 %rax
+  ASM(0x66); ASM(0x48); ASM(0x0F); ASM(0x6E); ASM(0xC0 | (r << 2) | r); // movq %rax %xmm0
+  flo = X86_JCC(0xEB); // jmp [done]
+  X86_JMP_HERE(ptr);
+#endif
+  ASM(0xF2); ASM(0x0F); ASM(0x10); ASM(0x40 | (r << 2) | r); // movsd value(%rax) %xmm0
+    ASM(offsetof(struct PNDecimal, value));
+  X86_JMP_HERE(done);
+  if (flo >= 0) X86_JMP_HERE(flo);
+}
+
+//
+// the decimal path of X86_MATH: with %rax and %rdx holding
+// any mix of ints and decimals, does the math in SSE2. the
+// result goes out as a flonum when it fits and is boxed
+// otherwise. anything else jumps past the end, to the generic
+// call. returns the jump to [b] for patching.
+//
+static int potion_x86_sse(Potion *P, PNAsm * volatile *asmp, PN_OP op, long start, u8 sse) {
+  int ok, notnum[6], done, r, n = 0;
+#if PN_FLONUM
+  int isflo, box, flo;
+#endif
+  for (r = 0; r <= 2; r += 2) {
+    potion_x86_test_low(P, asmp, r, PN_FNUMBER);
+    ok = X86_JCC(0x75); // jne [ok]
+#if PN_FLONUM
+    potion_x86_test_low(P, asmp, r, PN_FBOOLEAN);
+    notnum[n++] = X86_JCC32(0x85); // jne [call]
+    potion_x86_test_low(P, asmp, r, PN_FDECIMAL);
+    isflo = X86_JCC(0x75); // jne [ok]
+#endif
+    ASM(0x48); ASM(0x83); ASM(0xF8 | r); ASM(7); // cmp 7 %rax
+    notnum[n++] = X86_JCC32(0x86); // jbe [call]
+    ASM(0x81); ASM(0x38 | r); ASMI(PN_TNUMBER); // cmpl NUMBER (%rax)
+    notnum[n++] = X86_JCC32(0x85); // jne [call]
+    X86_JMP_HERE(ok);
+#if PN_FLONUM
+    X86_JMP_HERE(isflo);
+#endif
+  }
+#if PN_FLONUM
+  potion_x86_sse_load(P, asmp, 0);
+  potion_x86_sse_load(P, asmp, 2);
+  ASM(0xF2); ASM(0x0F); ASM(sse); ASM(0xC1); // addsd %xmm1 %xmm0
+  // see potion_flonum
+  ASM(0x66); ASM(0x48); ASM(0x0F); ASM(0x7E); ASM(0xC0); // movq %xmm0 %rax
+  ASM(0x48); ASM(0x89); ASM(0xC1); // mov %rax %rcx
+  ASM(0x48); ASM(0xC1); ASM(0xE9); ASM(59); // shr 59 %rcx
+  ASM(0x83); ASM(0xE1); ASM(0x0F); // and 0xf %ecx
+  ASM(0x83); ASM(0xE9); ASM(7); // sub 7 %ecx
+  ASM(0x83); ASM(0xF9); ASM(1); // cmp 1 %ecx
+  box = X86_JCC(0x77); // ja [box]
+  ASM(0x48); ASM(0xC1); ASM(0xC0); ASM(4); // rol 4 %rax
+  ASM(0x48); ASM(0x83); ASM(0xE0); ASM(PN_REF_MASK); // and REFMASK %rax
+  ASM(0x48); ASM(0x83); ASM(0xC8); ASM(PN_FDECIMAL); // or FDECIMAL %rax
+  flo = X86_JCC(0xEB); // jmp [done]
+  // the rest are boxed by potion_real, which takes %xmm0 as is
+  X86_JMP_HERE(box); // [box]
+  X86_ARGO(start - 3, 0);
+  X86_PRE(); ASM(0xB8); ASMN(potion_real); // mov &potion_real %rax
+  ASM(0xFF); ASM(0xD0); // callq %rax
+  X86_JMP_HERE(flo); // [done]
+#else
+  // the box goes first, so a collection can't clobber the xmm regs
+  potion_x86_alloc(P, asmp, start, PN_TNUMBER, sizeof(struct PNDecimal));
+  ASM(0x49); ASM(0x89); ASM(0xC0); // mov %rax %r8
+  X86_MOV_RBP(0x8B, op.a); // mov -A(%rbp) %rax
+  X86_PRE(); ASM(0x8B); X86_RBP(0x55, op.b); // mov -B(%rbp) %rdx
+  potion_x86_sse_load(P, asmp, 0);
+  potion_x86_sse_load(P, asmp, 2);
+  ASM(0xF2); ASM(0x0F); ASM(sse); ASM(0xC1); // addsd %xmm1 %xmm0
+  ASM(0xF2); ASM(0x41); ASM(0x0F); ASM(0x11); ASM(0x40); // movsd %xmm0 value(%r8)
+    ASM(offsetof(struct PNDecimal, value));
+  ASM(0x4C); ASM(0x89); ASM(0xC0); // mov %r8 %rax
+#endif
+  ASM(0xE9); ASMI(0); // jmp [b]
+  done = asmp[0]->len - 4;
+  for (r = 0; r < n; r++) X86_JMP32_HERE(notnum[r]);
+  return done;
+}
+#else
+#define potion_x86_sse(P, asmp, op, start, sse) -1
+#endif
+
 void potion_x86_setup(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp) {
   ASM(0x55); // push %rbp
   X86_PRE(); ASM(0x89); ASM(0xE5); // mov %rsp,%rbp
@@ -204,18 +383,16 @@ void potion_x86_stack(Potion *P, struct PNProto * volatile f, PNAsm * volatile *
 }
 
 void potion_x86_registers(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, long start) {
-  PN_HAS_UPVALS(up);
+  int argx = 0, regs = PN_INT(f->stack);
   // (Potion *, self) in the first argument slot, self in the first register 
   X86_ARGI(start - 3, 0);
   X86_ARGI(start - 2, 1);
   X86_ARGI(start - 1, 2);
   X86_ARGI(0, 2);
-  // empty locals, since use of setlocal requires something there
-  if (up) {
-    int argx = 0, regs = PN_INT(f->stack);
-    for (argx = 0; argx < PN_TUPLE_LEN(f->locals); argx++) {
+  // empty the locals that may become refs, since setlocal looks at what's there
+  for (argx = 0; argx < PN_TUPLE_LEN(f->locals); argx++) {
+    if (PN_LOCAL_REF(f, argx))
       X86_MOVQ(regs + argx, PN_NIL);
-    }
   }
 }
 
@@ -273,10 +450,9 @@ void potion_x86_self(Potion *P, struct PNProto * volatile f, PNAsm * volatile *a
 
 void potion_x86_getlocal(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long regs) {
   PN_OP op = PN_OP_AT(f->asmb, pos);
-  PN_HAS_UPVALS(up);
   X86_MOV_RBP(0x8B, regs + op.b); // mov %rsp(B) %rax
-  if (up) {
-    ASM(0xF6); ASM(0xC0); ASM(0x01); // test 0x1 %al
+  if (PN_LOCAL_REF(f, op.b)) {
+    ASM(0xA8); ASM(PN_PRIMITIVE); // test PRIMITIVE %al
     ASM(0x75); ASM(X86C(19, 20)); // jne [a]
     ASM(0xF7); ASM(0xC0); ASMI(PN_REF_MASK); // test REFMASK %eax
     ASM(0x74); ASM(X86C(11, 12)); // je [a]
@@ -289,41 +465,53 @@ void potion_x86_getlocal(Potion *P, struct PNProto * volatile f, PNAsm * volatil
 
 void potion_x86_setlocal(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long regs) {
   PN_OP op = PN_OP_AT(f->asmb, pos);
-  PN_HAS_UPVALS(up);
-  X86_PRE(); ASM(0x8B); ASM(0x55); ASM(RBP(op.a)); // mov %rsp(A) %rdx
-  if (up) {
+  int num = -1, small = -1, notref = -1, done = -1;
+  X86_PRE(); ASM(0x8B); X86_RBP(0x55, op.a); // mov %rsp(A) %rdx
+  if (PN_LOCAL_REF(f, op.b)) {
     X86_MOV_RBP(0x8B, regs + op.b); // mov %rsp(B) %rax
-    ASM(0xF6); ASM(0xC0); ASM(0x01); // test 0x1 %al
-    ASM(0x75); ASM(X86C(19, 20)); // jne [a]
+    ASM(0xA8); ASM(PN_PRIMITIVE); // test PRIMITIVE %al
+    num = X86_JCC(0x75); // jne [a]
     ASM(0xF7); ASM(0xC0); ASMI(PN_REF_MASK); // test REFMASK %eax
-    ASM(0x74); ASM(X86C(11, 12)); // je [a]
+    small = X86_JCC(0x74); // je [a]
     ASM(0x81); ASM(0x38); ASMI(PN_TWEAK); // cmpq WEAK (%rax)
-    ASM(0x75); ASM(X86C(3, 4)); // jne [a]
-    X86_PRE(); ASM(0x89); ASM(0x50); ASM(sizeof(struct PNObject)); // mov N(%rax) %rax
+    notref = X86_JCC(0x75); // jne [a]
+    X86_PRE(); ASM(0x89); ASM(0x50); ASM(sizeof(struct PNObject)); // mov %rdx N(%rax)
+    done = X86_JCC(0xEB); // jmp [b], the ref stays in the slot
+    X86_JMP_HERE(num);
+    X86_JMP_HERE(small);
+    X86_JMP_HERE(notref);
   }
-  X86_PRE(); ASM(0x89); ASM(0x55); ASM(RBP(regs + op.b)); // mov %rdx %rsp(B)
+  X86_PRE(); ASM(0x89); X86_RBP(0x55, regs + op.b); // [a] mov %rdx %rsp(B)
+  if (done >= 0) X86_JMP_HERE(done); // [b]
 }
 
 void potion_x86_getupval(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long lregs) {
   PN_OP op = PN_OP_AT(f->asmb, pos);
   X86_MOV_RBP(0x8B, lregs + op.b);
-  X86_PRE(); ASM(0x8B); ASM(0x40); ASM(sizeof(struct PNObject));
+  if (!PN_UPVAL_FLAT(f, op.b)) {
+    X86_PRE(); ASM(0x8B); ASM(0x40); ASM(sizeof(struct PNObject));
+  }
   X86_MOV_RBP(0x89, op.a);
 }
 
 // TODO: place the upval in the write barrier (or have stack scanning handle weak refs)
 void potion_x86_setupval(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long lregs) {
   PN_OP op = PN_OP_AT(f->asmb, pos);
-  X86_PRE(); ASM(0x8B); ASM(0x55); ASM(RBP(op.a)); /*  mov -A(%rbp) %edx */
+  X86_PRE(); ASM(0x8B); X86_RBP(0x55, op.a); /*  mov -A(%rbp) %edx */
   X86_MOV_RBP(0x8B, lregs + op.b); // mov %rsp(B) %rax
   X86_PRE(); ASM(0x89); ASM(0x50); ASM(sizeof(struct PNObject)); // mov %rdx %rax.data
 }
 
 void potion_x86_newtuple(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long start) {
   PN_OP op = PN_OP_AT(f->asmb, pos);
+#if __WORDSIZE != 64
   X86_ARGO(start - 3, 0);
   X86_PRE(); ASM(0xB8); ASMN(potion_tuple_empty); // mov &potion_tuple_empty %rax
   ASM(0xFF); ASM(0xD0); // callq %rax
+#else
+  potion_x86_alloc(P, asmp, start, PN_TTUPLE, sizeof(struct PNTuple));
+  ASM(0x48); ASM(0xC7); ASM(0x40); ASM(offsetof(struct PNTuple, len)); ASMI(0); // movq 0 len(%rax)
+#endif
   X86_MOV_RBP(0x89, op.a); // mov %rax local
 }
 
@@ -393,14 +581,14 @@ void potion_x86_setpath(Potion *P, struct PNProto * volatile f, PNAsm * volatile
 
 void potion_x86_add(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long start) {
   PN_OP op = PN_OP_AT(f->asmb, pos);
-  X86_MATH(1, potion_obj_add, {
+  X86_MATH(1, potion_obj_add, 0x58, {
     X86_PRE(); ASM(0x8D); ASM(0x44); ASM(0x10); ASM(0xFF); // lea -1(%eax,%edx,1),%eax
   });
 }
 
 void potion_x86_sub(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long start) {
   PN_OP op = PN_OP_AT(f->asmb, pos);
-  X86_MATH(1, potion_obj_sub, {
+  X86_MATH(1, potion_obj_sub, 0x5C, {
     X86_PRE(); ASM(0x29); ASM(0xD0); // sub %edx %eax
     X86_PRE(); ASM(0xFF); ASM(0xC0); // inc %eax
   });
@@ -408,7 +596,7 @@ void potion_x86_sub(Potion *P, struct PNProto * volatile f, PNAsm * volatile *as
 
 void potion_x86_mult(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long start) {
   PN_OP op = PN_OP_AT(f->asmb, pos);
-  X86_MATH(1, potion_obj_mult, {
+  X86_MATH(1, potion_obj_mult, 0x59, {
     X86_PRE(); ASM(0xD1); ASM(0xFA); // sar %rdx
     X86_PRE(); ASM(0xFF); ASM(0xC8); // dec %rax
     X86_PRE(); ASM(0x0F); ASM(0xAF); ASM(0xC2); // imul %rdx %rax
@@ -418,7 +606,7 @@ void potion_x86_mult(Potion *P, struct PNProto * volatile f, PNAsm * volatile *a
 
 void potion_x86_div(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long start) {
   PN_OP op = PN_OP_AT(f->asmb, pos);
-  X86_MATH(1, potion_obj_div, {
+  X86_MATH(1, potion_obj_div, 0x5E, {
     ASM(0xD1); ASM(0xF8); // sar %rax
     ASM(0xD1); ASM(0xFA); // sar %edx
     ASM(0x89); ASM(0xD1); // mov %edx %ecx
@@ -431,7 +619,7 @@ void potion_x86_div(Potion *P, struct PNProto * volatile f, PNAsm * volatile *as
 
 void potion_x86_rem(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long start) {
   PN_OP op = PN_OP_AT(f->asmb, pos);
-  X86_MATH(1, potion_obj_rem, {
+  X86_MATH(1, potion_obj_rem, 0, {
     ASM(0xD1); ASM(0xF8); // sar %rax
     ASM(0xD1); ASM(0xFA); // sar %edx
     ASM(0x89); ASM(0xD1); // mov %edx %ecx
@@ -484,7 +672,7 @@ void potion_x86_gte(Potion *P, struct PNProto * volatile f, PNAsm * volatile *as
 
 void potion_x86_bitn(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long start) {
   PN_OP op = PN_OP_AT(f->asmb, pos);
-  X86_MATH(0, potion_obj_bitn, {
+  X86_MATH(0, potion_obj_bitn, 0, {
     X86_PRE(); ASM(0xF7); ASM(0xD0); // not %eax
     X86_PRE(); ASM(0xFF); ASM(0xC0); // inc %rax
   });
@@ -492,7 +680,7 @@ void potion_x86_bitn(Potion *P, struct PNProto * volatile f, PNAsm * volatile *a
 
 void potion_x86_bitl(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long start) {
   PN_OP op = PN_OP_AT(f->asmb, pos);
-  X86_MATH(1, potion_obj_bitl, {
+  X86_MATH(1, potion_obj_bitl, 0, {
     ASM(0xD1); ASM(0xF8); // sar %eax
     ASM(0xD1); ASM(0xFA); // sar %edx
     ASM(0x89); ASM(0xD1); // mov %edx %ecx
@@ -504,7 +692,7 @@ void potion_x86_bitl(Potion *P, struct PNProto * volatile f, PNAsm * volatile *a
 
 void potion_x86_bitr(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long start) {
   PN_OP op = PN_OP_AT(f->asmb, pos);
-  X86_MATH(1, potion_obj_bitr, {
+  X86_MATH(1, potion_obj_bitr, 0, {
     ASM(0xD1); ASM(0xF8); // sar %rax
     ASM(0xD1); ASM(0xFA); // sar %edx
     ASM(0x89); ASM(0xD1); // mov %edx %ecx
@@ -552,14 +740,18 @@ void potion_x86_jmp(Potion *P, struct PNProto * volatile f, PNAsm * volatile *as
 
 void potion_x86_test_asm(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, int test) {
   PN_OP op = PN_OP_AT(f->asmb, pos);
+  int fals, nil, done;
   X86_MOV_RBP(0x8B, op.a); // mov -A(%rbp) %rax
   X86_PRE(); ASM(0x83); ASM(0xF8); ASM(PN_FALSE); // cmp FALSE %rax
-  ASM(0x74); ASM(X86C(13, 15)); // je +10
+  fals = X86_JCC(0x74); // je [a]
   X86_PRE(); ASM(0x85); ASM(0xC0); // test %rax %rax
-  ASM(0x74); ASM(X86C(9, 10)); // je +5
+  nil = X86_JCC(0x74); // je [a]
   X86_MOVQ(op.a, test ? PN_FALSE : PN_TRUE); // -A(%rbp) = TRUE
-  ASM(0xEB); ASM(X86C(7, 8)); // jmp +7
-  X86_MOVQ(op.a, test ? PN_TRUE : PN_FALSE); // -A(%rbp) = FALSE
+  done = X86_JCC(0xEB); // jmp [b]
+  X86_JMP_HERE(fals);
+  X86_JMP_HERE(nil);
+  X86_MOVQ(op.a, test ? PN_TRUE : PN_FALSE); // [a] -A(%rbp) = FALSE
+  X86_JMP_HERE(done); // [b]
 }
 
 void potion_x86_test(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos) {
@@ -596,71 +788,181 @@ void potion_x86_notjmp(Potion *P, struct PNProto * volatile f, PNAsm * volatile
 
 void potion_x86_named(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long start) {
   PN_OP op = PN_OP_AT(f->asmb, pos);
+  PN_SIZE site = ((PN)f >> 4) ^ pos;
+  int miss;
   X86_ARGO(start - 3, 0);
   X86_ARGO(op.a, 1);
   X86_ARGO(op.b - 1, 2);
-  X86_PRE(); ASM(0xB8); ASMN(potion_sig_find); // mov &potion_sig_find %rax
+#if __WORDSIZE != 64
+  ASM(0xC7); ASM(0x44); ASM(0x24); ASM(3 * sizeof(PN)); ASMI(site); // movl site 0xc(%esp)
+#else
+  ASM(0xB9); ASMI(site); // mov site %ecx
+#endif
+  X86_PRE(); ASM(0xB8); ASMN(potion_vm_named); // mov &potion_vm_named %rax
   ASM(0xFF); ASM(0xD0); // callq %eax
-  ASM(0x85); ASM(0xC0); // test %eax %eax
-  ASM(0x78); ASM(X86C(9, 12)); // js +12
+  ASM(0x3D); ASMI(op.b - op.a - 3); // cmp W %eax
+  miss = X86_JCC(0x73); // jae [a] (which a miss, -1, is too)
   X86_PRE(); ASM(0xF7); ASM(0xD8); // neg %rax
-  X86_PRE(); ASM(0x8B); ASM(0x55); ASM(RBP(op.b)); // mov -B(%rbp) %rdx
+  X86_PRE(); ASM(0x8B); X86_RBP(0x55, op.b); // mov -B(%rbp) %rdx
 #if __WORDSIZE != 64
-  ASM(0x89); ASM(0x54); ASM(0x85); ASM(RBP(op.a + 2)); // mov %edx -A(%ebp,%eax,4)
+  ASM(0x89); X86_RBP_SIB(0x54, 0x85, op.a + 2); // mov %edx -A(%ebp,%eax,4)
 #else
-  X86_PRE(); ASM(0x89); ASM(0x54); ASM(0xC5); ASM(RBP(op.a + 2)); // mov %rdx -A(%rbp,%rax,8)
+  X86_PRE(); ASM(0x89); X86_RBP_SIB(0x54, 0xC5, op.a + 2); // mov %rdx -A(%rbp,%rax,8)
 #endif
+  X86_JMP_HERE(miss); // [a]
 }
 
 // TODO: check for bytecode nodes and jit them as well?
-void potion_x86_call(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long start) {
+static void potion_x86_call_to(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long start, int tail) {
   PN_OP op = PN_OP_AT(f->asmb, pos);
   int argc = op.b - op.a;
+  int num, prim, nocls, iscl, got, vargs, done = 0, i;
 
   // check type of the closure
-  X86_PRE(); ASM(0x8B); ASM(0x45); ASM(RBP(op.a)); // mov %rbp(A) %rax
-  ASM(0xF6); ASM(0xC0); ASM(0x01); // test 0x1 %al
-  ASM(0x75); ASM(X86C(56, 68)); // jne [a]
+  X86_PRE(); ASM(0x8B); X86_RBP(0x45, op.a); // mov %rbp(A) %rax
+  ASM(0xA8); ASM(PN_PRIMITIVE); // test PRIMITIVE %al
+  num = X86_JCC(0x75); // jne [a]
   ASM(0xF7); ASM(0xC0); ASMI(PN_REF_MASK); // test REFMASK %eax
-  ASM(0x74); ASM(X86C(48, 60)); // je [a]
+  prim = X86_JCC(0x74); // je [a]
   X86_PRE(); ASM(0x83); ASM(0xE0); ASM(0xF8); // and ~PRIMITIVE %rax
 
   // if a class, pull out the constructor
   ASM(0x81); ASM(0x38); ASMI(PN_TVTABLE); // cmpq VTABLE (%eax)
-  ASM(0x75); ASM(X86C(26, 36)); // jne [c]
+  nocls = X86_JCC(0x75); // jne [c]
   X86_ARGO(start - 3, 0);
   X86_ARGO(op.a, 2);
   X86_PRE(); ASM(0xB8); ASMN(potion_object_new); // mov &potion_object_new %rax
   ASM(0xFF); ASM(0xD0); // callq %rax
   X86_MOV_RBP(0x89, op.a + 1); // mov %rax local
-  X86_PRE(); ASM(0x8B); ASM(0x45); ASM(RBP(op.a)); // mov %rbp(A) %rax
+  X86_PRE(); ASM(0x8B); X86_RBP(0x45, op.a); // mov %rbp(A) %rax
   X86_PRE(); ASM(0x8B); ASM(0x40);
     ASM((char *)&((struct PNVtable *)P->lobby)->ctor - (char *)P->lobby); // mov N(%rax) %rax
-  X86_PRE(); ASM(0x89); ASM(0x45); ASM(RBP(op.a)); // mov %rax %rbp(A)
+  X86_PRE(); ASM(0x89); X86_RBP(0x45, op.a); // mov %rax %rbp(A)
 
   // check type of the closure
+  X86_JMP_HERE(nocls); // [c]
   ASM(0x81); ASM(0x38); ASMI(PN_TCLOSURE); // cmpq CLOSURE (%eax)
-  ASM(0x74); ASM(X86C(22, 30)); // je [a]
+  iscl = X86_JCC(0x74); // je [d]
 
   // if not a closure, get the type's closure
   X86_MOV_RBP(0x8B, op.a);
+  X86_JMP_HERE(num); // [a]
+  X86_JMP_HERE(prim);
   X86_MOV_RBP(0x89, op.a + 1);
   X86_ARGO(start - 3, 0);
   X86_ARGO(op.a, 1);
   X86_PRE(); ASM(0xB8); ASMN(potion_obj_get_call); // mov &potion_obj_get_call %rax
-  ASM(0xFF); ASM(0xD0); // [b] callq *%rax
-  ASM(0xEB); ASM(X86C(3, 4)); // jmp [b]
+  ASM(0xFF); ASM(0xD0); // callq *%rax
+  got = X86_JCC(0xEB); // jmp [b]
 
   // get the closure's function
-  X86_PRE(); ASM(0x8B); ASM(0x45); ASM(RBP(op.a)); // mov %rbp(A) %rax
+  X86_JMP_HERE(iscl); // [d]
+  X86_PRE(); ASM(0x8B); X86_RBP(0x45, op.a); // mov %rbp(A) %rax
+  X86_JMP_HERE(got); // [b]
+  ASM(0xF6); ASM(0x40); ASM(offsetof(struct PNClosure, flags)); ASM(PN_CLOSURE_ARGV); // testb ARGV flags(%rax)
+  vargs = X86_JCC32(0x84); // je [e]
+  X86_PRE(); ASM(0x8B); ASM(0x40); ASM(sizeof(struct PNObject)); // mov N(%rax) %rax
+
+  // an argv native: (Potion *, CL, self, argc, argv), the args
+  // laid out in order at the bottom of the frame
+  X86_ARGO(start - 3, 0);
+  X86_ARGO(op.a, 1);
+  X86_ARGO(op.a + 1, 2);
+#if __WORDSIZE != 64
+  for (i = 0; i < argc - 1; i++) X86_ARGO(op.a + i + 2, i + 5);
+  ASM(0xC7); ASM(0x44); ASM(0x24); ASM(3 * sizeof(PN)); ASMI(argc - 1); // movl argc 0xc(%esp)
+  ASM(0x8D); ASM(0x54); ASM(0x24); ASM(5 * sizeof(PN)); // lea 0x14(%esp) %edx
+  ASM(0x89); ASM(0x54); ASM(0x24); ASM(4 * sizeof(PN)); // mov %edx 0x10(%esp)
+#else
+  for (i = 0; i < argc - 1; i++) X86_ARGO(op.a + i + 2, i + 6);
+  ASM(0xB9); ASMI(argc - 1); // mov argc %ecx
+  ASM(0x49); ASM(0x89); ASM(0xE0); // mov %rsp %r8
+#endif
+  ASM(0xFF); ASM(0xD0); // callq *%rax
+  X86_PRE(); ASM(0x89); X86_RBP(0x45, op.a); /* mov %rbp(A) %rax */
+  if (tail) {
+    ASM(0xC9); ASM(0xC3); // leave; ret
+  } else {
+    ASM(0xE9); done = asmp[0]->len; ASMI(0); // jmp [f]
+  }
+
+  X86_JMP32_HERE(vargs); // [e]
   X86_PRE(); ASM(0x8B); ASM(0x40); ASM(sizeof(struct PNObject)); // mov N(%rax) %rax
 
   // (Potion *, CL) as the first argument
   X86_ARGO(start - 3, 0);
   X86_ARGO(op.a, 1);
   while (--argc >= 0) X86_ARGO(op.a + argc + 1, argc + 2);
+  if (tail) {
+    ASM(0xC9); // leave
+    ASM(0xFF); ASM(0xE0); // jmp *%rax
+    return;
+  }
   ASM(0xFF); ASM(0xD0); // [b] callq *%rax
-  X86_PRE(); ASM(0x89); ASM(0x45); ASM(RBP(op.a)); /* mov %rbp(A) %rax */
+  X86_PRE(); ASM(0x89); X86_RBP(0x45, op.a); /* mov %rbp(A) %rax */
+  X86_JMP32_HERE(done); // [f]
+}
+
+void potion_x86_call(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long start) {
+  potion_x86_call_to(P, f, asmp, pos, start, 0);
+}
+
+// leaves this frame and jumps, when all the args go in registers.
+// (past that, it's a call and the RETURN after it.)
+void potion_x86_tailcall(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long start) {
+  PN_OP op = PN_OP_AT(f->asmb, pos);
+  potion_x86_call_to(P, f, asmp, pos, start, X86C(0, op.b - op.a + 2 <= 6));
+}
+
+// l (i): a tuple slot is loaded right here and a table is
+// probed, anything else goes on to the ordinary call.
+void potion_x86_gettable(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long start) {
+  PN_OP op = PN_OP_AT(f->asmb, pos);
+  int num, prim, notup, idx, neg, oob, load, tdone, notbl, done;
+  X86_PRE(); ASM(0x8B); X86_RBP(0x45, op.a); // mov %rbp(A) %rax
+  ASM(0xA8); ASM(PN_PRIMITIVE); // test PRIMITIVE %al
+  num = X86_JCC32(0x85); // jne [c]
+  ASM(0xF7); ASM(0xC0); ASMI(PN_REF_MASK); // test REFMASK %eax
+  prim = X86_JCC32(0x84); // je [c]
+  ASM(0x81); ASM(0x38); ASMI(PN_TTUPLE); // cmpl TUPLE (%rax)
+  notup = X86_JCC32(0x85); // jne [b]
+  X86_PRE(); ASM(0x8B); X86_RBP(0x55, op.b); // mov %rbp(B) %rdx
+  ASM(0xF6); ASM(0xC2); ASM(0x01); // test 0x1 %dl
+  idx = X86_JCC32(0x84); // je [c]
+  X86_PRE(); ASM(0xD1); ASM(0xFA); // sar %rdx
+  X86_PRE(); ASM(0x8B); ASM(0x48); ASM(offsetof(struct PNTuple, len)); // mov len(%rax) %rcx
+  X86_PRE(); ASM(0x85); ASM(0xD2); // test %rdx %rdx
+  neg = X86_JCC(0x79); // jns +3
+  X86_PRE(); ASM(0x01); ASM(0xCA); // add %rcx %rdx
+  X86_JMP_HERE(neg);
+  X86_PRE(); ASM(0x39); ASM(0xCA); // cmp %rcx %rdx
+  oob = X86_JCC(0x73); // jae [a]
+  X86_PRE(); ASM(0x8B); ASM(0x44); ASM(X86C(0x90, 0xD0)); // mov set(%rax,%rdx,N) %rax
+    ASM(offsetof(struct PNTuple, set));
+  load = X86_JCC(0xEB); // jmp +5
+  X86_JMP_HERE(oob); // [a]
+  ASM(0xB8); ASMI(PN_NIL); // mov NIL %eax
+  X86_JMP_HERE(load);
+  X86_MOV_RBP(0x89, op.a); // mov %rax %rbp(A)
+  ASM(0xE9); tdone = asmp[0]->len; ASMI(0); // jmp [d]
+  X86_JMP32_HERE(notup); // [b]
+  ASM(0x81); ASM(0x38); ASMI(PN_TTABLE); // cmpl TABLE (%rax)
+  notbl = X86_JCC32(0x85); // jne [c]
+  X86_ARGO(start - 3, 0);
+  X86_ARGO(op.a, 2);
+  X86_ARGO(op.b, 3);
+  X86_PRE(); ASM(0x31); ASM(0xF6); // xor %rsi %rsi
+  X86_PRE(); ASM(0xB8); ASMN(potion_table_at); // mov &potion_table_at %rax
+  ASM(0xFF); ASM(0xD0); // callq %rax
+  X86_MOV_RBP(0x89, op.a); // mov %rax %rbp(A)
+  ASM(0xE9); done = asmp[0]->len; ASMI(0); // jmp [d]
+  X86_JMP32_HERE(num); // [c]
+  X86_JMP32_HERE(prim);
+  X86_JMP32_HERE(idx);
+  X86_JMP32_HERE(notbl);
+  potion_x86_call_to(P, f, asmp, pos, start, 0);
+  X86_JMP32_HERE(tdone); // [d]
+  X86_JMP32_HERE(done);
 }
 
 void potion_x86_callset(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long start) {
@@ -672,8 +974,44 @@ void potion_x86_callset(Potion *P, struct PNProto * volatile f, PNAsm * volatile
   X86_MOV_RBP(0x89, op.a); // mov %rax local
 }
 
+// l (i) = x, which only ever calls out to C (so the tuple
+// and table cases are left to potion_vm_puttable.)
+void potion_x86_puttable(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long start) {
+  PN_OP op = PN_OP_AT(f->asmb, pos);
+  X86_ARGO(start - 3, 0);
+  X86_ARGO(op.a, 1);
+  X86_ARGO(op.a + 1, 2);
+  X86_ARGO(op.b, 3);
+  X86_PRE(); ASM(0xB8); ASMN(potion_vm_puttable); // mov &potion_vm_puttable %rax
+  ASM(0xFF); ASM(0xD0); // callq %rax
+  X86_MOV_RBP(0x89, op.a); // mov %rax local
+}
+
+// ("a", b, "c") join. the pieces go out in order at the
+// bottom of the frame, as an argv for potion_vm_concat.
+void potion_x86_concat(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long start) {
+  PN_OP op = PN_OP_AT(f->asmb, pos);
+  int n = op.b - op.a, i;
+  X86_ARGO(start - 3, 0);
+  X86_ARGO(op.a, 1);
+#if __WORDSIZE != 64
+  for (i = 0; i < n; i++) X86_ARGO(op.a + i + 1, i + 4);
+  ASM(0xC7); ASM(0x44); ASM(0x24); ASM(2 * sizeof(PN)); ASMI(n); // movl n 0x8(%esp)
+  ASM(0x8D); ASM(0x54); ASM(0x24); ASM(4 * sizeof(PN)); // lea 0x10(%esp) %edx
+  ASM(0x89); ASM(0x54); ASM(0x24); ASM(3 * sizeof(PN)); // mov %edx 0xc(%esp)
+#else
+  for (i = 0; i < n; i++) X86_ARGO(op.a + i + 1, i + 6);
+  ASM(0xBA); ASMI(n); // mov n %edx
+  ASM(0x48); ASM(0x89); ASM(0xE1); // mov %rsp %rcx
+#endif
+  X86_PRE(); ASM(0xB8); ASMN(potion_vm_concat); // mov &potion_vm_concat %rax
+  ASM(0xFF); ASM(0xD0); // callq %rax
+  X86_MOV_RBP(0x89, op.a); // mov %rax local
+}
+
 void potion_x86_return(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos) {
-  X86_MOV_RBP(0x8B, 0); // mov -0(%rbp) %eax
+  PN_OP op = PN_OP_AT(f->asmb, pos);
+  X86_MOV_RBP(0x8B, op.a); // mov -A(%rbp) %eax
   ASM(0xC9); ASM(0xC3); // leave; ret
 }
 
@@ -690,25 +1028,89 @@ PN potion_f_protos(Potion *P, PN cl, PN i) {
 void potion_x86_method(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE *pos, long lregs, long start, long regs) {
   PN_OP op = PN_OP_AT(f->asmb, *pos);
   PN proto = PN_TUPLE_AT(f->protos, op.b);
+#if __WORDSIZE == 64
+  int num, small, isref;
+#endif
+#if __WORDSIZE != 64
   X86_ARGO(start - 3, 0);
   X86_ARGO(start - 2, 1);
   X86_MOVQ(op.a, op.b);
   X86_ARGO(op.a, 2);
   X86_PRE(); ASM(0xB8); ASMN(potion_f_protos); // mov &potion_f_values %rax
   ASM(0xFF); ASM(0xD0); // callq %rax
+#else
+  {
+    // same as potion_f_protos, but the closure is allocated inline
+    // and the proto is found through the running closure
+    PN sig = PN_PROTO(proto)->sig;
+    PN_SIZE extra = PN_TUPLE_LEN(PN_PROTO(proto)->upvals) + 1, n;
+    // potion_ref, inline. the refs are all made up front, so the
+    // closure can't be moved (or promoted) while it's filled in.
+    for (n = 1; n < extra; n++) {
+      PN_OP opp = PN_OP_AT(f->asmb, *pos + n);
+      if (opp.code != OP_GETLOCAL || PN_UPVAL_FLAT(PN_PROTO(proto), n - 1)) continue;
+      X86_PRE(); ASM(0x8B); X86_RBP(0x55, regs + opp.b); // mov local %rdx
+      ASM(0xF6); ASM(0xC2); ASM(PN_PRIMITIVE); // test PRIMITIVE %dl
+      num = X86_JCC32(0x85); // jne alloc
+      ASM(0x48); ASM(0x83); ASM(0xFA); ASM(7); // cmp 7 %rdx
+      small = X86_JCC32(0x86); // jbe alloc
+      ASM(0x81); ASM(0x3A); ASMI(PN_TWEAK); // cmpl WEAK (%rdx)
+      isref = X86_JCC32(0x84); // je done
+      X86_JMP32_HERE(num);
+      X86_JMP32_HERE(small);
+      potion_x86_alloc(P, asmp, start, PN_TWEAK, sizeof(struct PNWeakRef));
+      X86_PRE(); ASM(0x8B); X86_RBP(0x55, regs + opp.b); // mov local %rdx
+      ASM(0x48); ASM(0x89); ASM(0x50); ASM(offsetof(struct PNWeakRef, data)); // mov %rdx data(%rax)
+      X86_MOV_RBP(0x89, regs + opp.b); // mov %rax local
+      X86_JMP32_HERE(isref);
+    }
+    potion_x86_alloc(P, asmp, start, PN_TCLOSURE,
+      sizeof(struct PNClosure) + extra * sizeof(PN));
+    ASM(0x48); ASM(0xBA); ASMN(PN_PROTO(proto)->jit); // mov jit %rdx
+    ASM(0x48); ASM(0x89); ASM(0x50); ASM(offsetof(struct PNClosure, method)); // mov %rdx method(%rax)
+    ASM(0xC7); ASM(0x40); ASM(offsetof(struct PNClosure, extra)); ASMI(extra); // movl extra extra(%rax)
+    ASM(0xC7); ASM(0x40); ASM(offsetof(struct PNClosure, flags)); ASMI(0); // movl 0 flags(%rax)
+    for (n = 1; n < extra; n++) {
+      ASM(0x48); ASM(0xC7); ASM(0x80); // movq NIL data[n](%rax)
+        ASMI(sizeof(struct PNClosure) + n * sizeof(PN)); ASMI(PN_NIL);
+    }
+    ASM(0x48); ASM(0x8B); X86_RBP(0x4D, start - 2); // mov cl %rcx
+    ASM(0x48); ASM(0x8B); ASM(0x49); ASM(sizeof(struct PNClosure)); // mov data[0](%rcx) %rcx
+    ASM(0x48); ASM(0x8B); ASM(0x89); ASMI(offsetof(struct PNProto, protos)); // mov protos(%rcx) %rcx
+    ASM(0x81); ASM(0x39); ASMI(POTION_FWD); // cmpl FWD (%rcx)
+    ASM(0x75); ASM(6); // jne +6
+    ASM(0x48); ASM(0x8B); ASM(0x49); ASM(offsetof(struct PNFwd, ptr)); // mov ptr(%rcx) %rcx
+    ASM(0xEB); ASM(0xF2); // jmp -14
+    ASM(0x48); ASM(0x8B); ASM(0x89); // mov set[B](%rcx) %rcx
+      ASMI(sizeof(struct PNTuple) + op.b * sizeof(PN));
+    ASM(0x48); ASM(0x89); ASM(0x48); ASM(sizeof(struct PNClosure)); // mov %rcx data[0](%rax)
+    if (PN_IS_TUPLE(sig) && PN_TUPLE_LEN(sig) > 0) {
+      ASM(0x48); ASM(0x8B); ASM(0x91); ASMI(offsetof(struct PNProto, sig)); // mov sig(%rcx) %rdx
+      ASM(0x48); ASM(0x89); ASM(0x50); ASM(offsetof(struct PNClosure, sig)); // mov %rdx sig(%rax)
+    } else {
+      ASM(0x48); ASM(0xC7); ASM(0x40); ASM(offsetof(struct PNClosure, sig)); ASMI(PN_NIL); // movq NIL sig(%rax)
+    }
+  }
+#endif
   X86_MOV_RBP(0x89, op.a);
   PN_TUPLE_COUNT(PN_PROTO(proto)->upvals, i, {
     (*pos)++;
     PN_OP opp = PN_OP_AT(f->asmb, *pos);
     if (opp.code == OP_GETUPVAL) {
-      X86_PRE(); ASM(0x8B); ASM(0x55); ASM(RBP(lregs + opp.b)); // mov upval %rdx
+      X86_PRE(); ASM(0x8B); X86_RBP(0x55, lregs + opp.b); // mov upval %rdx
+    } else if (opp.code == OP_GETLOCAL && PN_UPVAL_FLAT(PN_PROTO(proto), i)) {
+      X86_PRE(); ASM(0x8B); X86_RBP(0x55, regs + opp.b); // mov local %rdx
     } else if (opp.code == OP_GETLOCAL) {
+#if __WORDSIZE != 64
       X86_ARGO(start - 3, 0);
       X86_ARGO(regs + opp.b, 1);
       X86_PRE(); ASM(0xB8); ASMN(potion_ref); // mov &potion_ref %rax
       ASM(0xFF); ASM(0xD0); // callq %rax
       X86_PRE(); ASM(0x89); ASM(0xC2); // mov %rax %rdx
       X86_MOV_RBP(0x89, regs + opp.b); // mov %rax local
+#else
+      X86_PRE(); ASM(0x8B); X86_RBP(0x55, regs + opp.b); // mov ref %rdx
+#endif
     } else {
       fprintf(stderr, "** missing an upval to proto %p\n", (void *)proto);
     }
@@ -728,6 +1130,22 @@ void potion_x86_class(Potion *P, struct PNProto * volatile f, PNAsm * volatile *
   X86_MOV_RBP(0x89, op.a); // mov %rax local
 }
 
+PN potion_f_guard(Potion *P, PN cl, PN obj, PN_SIZE n) {
+  return potion_vm_guard(P, PN_CLOSURE(cl)->data[0], obj, n);
+}
+
+void potion_x86_guard(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp, PN_SIZE pos, long start) {
+  PN_OP op = PN_OP_AT(f->asmb, pos);
+  X86_ARGO(start - 3, 0);
+  X86_ARGO(start - 2, 1);
+  X86_ARGO(op.a, 2);
+  X86_MOVQ(op.a, op.b);
+  X86_ARGO(op.a, 3);
+  X86_PRE(); ASM(0xB8); ASMN(potion_f_guard); // mov &potion_f_guard %rax
+  ASM(0xFF); ASM(0xD0); // callq %rax
+  X86_MOV_RBP(0x89, op.a); // mov %rax local
+}
+
 void potion_x86_finish(Potion *P, struct PNProto * volatile f, PNAsm * volatile *asmp) {
 }
 
@@ -18,19 +18,17 @@
 extern PNTarget potion_target_x86, potion_target_ppc;
 
 PN potion_vm_proto(Potion *P, PN cl, PN self, ...) {
-  PN ary = PN_NIL;
   vPN(Proto) f = (struct PNProto *)PN_CLOSURE(cl)->data[0];
-  if (PN_IS_TUPLE(f->sig)) {
+  PN_SIZE i, argc = f->arity;
+  PN argv[argc + 1];
+  if (argc > 0) {
     va_list args;
     va_start(args, self);
-    ary = PN_TUP0();
-    PN_TUPLE_EACH(f->sig, i, v, {
-      if (PN_IS_STR(v))
-        ary = PN_PUSH(ary, va_arg(args, PN));
-    });
+    for (i = 0; i < argc; i++)
+      argv[i] = va_arg(args, PN);
     va_end(args);
   }
-  return potion_vm(P, (PN)f, self, ary,
+  return potion_vm(P, (PN)f, self, argc, argv,
     PN_CLOSURE(cl)->extra - 1, &PN_CLOSURE(cl)->data[1]);
 }
 
@@ -47,8 +45,66 @@ PN potion_vm_class(Potion *P, PN cl, PN self) {
   return potion_class(P, PN_NIL, self, cl);
 }
 
+// is `cl` still a closure over the proto the compiler
+// inlined? (kept in the values of the calling proto.) or,
+// for a loop, the very method it inlined.
+PN potion_vm_guard(Potion *P, PN proto, PN cl, PN_SIZE n) {
+  PN want = PN_TUPLE_AT(PN_PROTO(proto)->values, n);
+  if (PN_IS_CLOSURE(want)) return PN_BOOL(cl == want);
+  return PN_BOOL(PN_IS_CLOSURE(cl) &&
+    PN_CLOSURE(cl)->extra > 0 && PN_CLOSURE(cl)->data[0] == want);
+}
+
+// l (i) = x, when it isn't a tuple slot that's already
+// there. (a tuple grows or becomes a table, a table puts,
+// anything else gets its callset called.)
+PN potion_vm_puttable(Potion *P, PN obj, PN key, PN value) {
+  PN argv[3];
+  if (PN_IS_TUPLE(obj))
+    return potion_tuple_put(P, PN_NIL, obj, key, value);
+  if (PN_IS_TABLE(obj))
+    return potion_table_put(P, PN_NIL, obj, key, value);
+  argv[0] = obj; argv[1] = key; argv[2] = value;
+  return potion_call(P, potion_obj_get_callset(P, obj), 3, argv);
+}
+
+// which slot a named arg goes in, given its call site. the
+// answer is kept until the callee's sig (or the name) changes,
+// or a collection moves them. (-1 if the sig hasn't the name.)
+int potion_vm_named(Potion *P, PN cl, PN name, PN_SIZE site) {
+  PN sig;
+  int gcs = P->mem->majors + P->mem->minors;
+  if (!PN_IS_CLOSURE(cl))
+    cl = potion_obj_get_call(P, cl);
+  if (!PN_IS_CLOSURE(cl))
+    return -1;
+
+  sig = PN_CLOSURE(cl)->sig;
+  site %= POTION_NAMED_SITES;
+  if (P->named[site].sig != sig || P->named[site].name != name || P->named[site].gcs != gcs) {
+    P->named[site].x = potion_sig_find(P, cl, name);
+    P->named[site].sig = sig;
+    P->named[site].name = name;
+    P->named[site].gcs = gcs;
+  }
+  return P->named[site].x;
+}
+
+// ("a", b, "c") join, given the pieces straight from registers
+// (and the sep, or nil) instead of a tuple. if join's been
+// changed, the tuple's made after all and sent it.
+PN potion_vm_concat(Potion *P, PN sep, PN_SIZE n, PN * volatile argv) {
+  PN join = potion_lookup(P, 0, PN_VTABLE(PN_TTUPLE), PN_join);
+  if (!PN_IS_CLOSURE(join) || PN_CLOSURE_F(join) != (PN_F)potion_tuple_join) {
+    PN_SIZE i;
+    PN tup = potion_tuple_with_size(P, n);
+    for (i = 0; i < n; i++) PN_TUPLE_AT(tup, i) = argv[i];
+    return sep == PN_NIL ? potion_send(tup, PN_join) : potion_send(tup, PN_join, sep);
+  }
+  return potion_str_join(P, sep, n, argv);
+}
+
 #define STACK_MAX 4096
-#define JUMPS_MAX 1024
 
 void potion_vm_init(Potion *P) {
   P->targets[POTION_X86] = potion_target_x86;
@@ -59,8 +115,8 @@ void potion_vm_init(Potion *P) {
 
 PN_F potion_jit_proto(Potion *P, PN proto, PN target_id) {
   long regs = 0, lregs = 0, need = 0, rsp = 0, argx = 0, protoargs = 4;
-  PN_SIZE pos;
-  PNJumps jmps[JUMPS_MAX]; size_t offs[JUMPS_MAX]; int jmpc = 0, jmpi = 0;
+  PN_SIZE pos, len;
+  PNJumps *jmps; size_t *offs; int jmpc = 0, jmpi = 0;
   vPN(Proto) f = (struct PNProto *)proto;
   int upc = PN_TUPLE_LEN(f->upvals);
   PNAsm * volatile asmb = potion_asm_new(P);
@@ -70,14 +126,8 @@ PN_F potion_jit_proto(Potion *P, PN proto, PN target_id) {
 
   if (PN_TUPLE_LEN(f->protos) > 0) {
     PN_TUPLE_EACH(f->protos, i, proto2, {
-      int p2args = 3;
       vPN(Proto) f2 = (struct PNProto *)proto2;
-      // TODO: i'm repeating this a lot. sad.
-      if (PN_IS_TUPLE(f2->sig)) {
-        PN_TUPLE_EACH(f2->sig, i, v, {
-          if (PN_IS_STR(v)) p2args++;
-        });
-      }
+      int p2args = 3 + f2->arity;
       if (f2->jit == NULL)
         potion_jit_proto(P, proto2, target_id);
       if (p2args > protoargs)
@@ -85,6 +135,17 @@ PN_F potion_jit_proto(Potion *P, PN proto, PN target_id) {
     });
   }
 
+  // calls (and concats) lay their args out at the bottom of the frame
+  len = PN_OP_LEN(f->asmb);
+  for (pos = 0; pos < len; pos++) {
+    PN_OP op = PN_OP_AT(f->asmb, pos);
+    if ((op.code == OP_CALL || op.code == OP_TAILCALL || op.code == OP_GETTABLE) &&
+        op.b - op.a + 5 > protoargs)
+      protoargs = op.b - op.a + 5;
+    if (op.code == OP_CONCAT && op.b - op.a + 6 > protoargs)
+      protoargs = op.b - op.a + 6;
+  }
+
   regs = PN_INT(f->stack);
   lregs = regs + PN_TUPLE_LEN(f->locals);
   need = lregs + upc + 3;
@@ -94,30 +155,21 @@ PN_F potion_jit_proto(Potion *P, PN proto, PN target_id) {
   target->registers(P, f, &asmb, need);
 
   // Read locals
-  if (PN_IS_TUPLE(f->sig)) {
-    argx = 0;
-    PN_TUPLE_EACH(f->sig, i, v, {
-      if (PN_IS_STR(v)) {
-        PN_SIZE num = PN_GET(f->locals, v);
-        target->local(P, f, &asmb, regs + num, argx);
-        argx++;
-      }
-    });
-  }
+  for (argx = 0; argx < f->arity; argx++)
+    target->local(P, f, &asmb, regs + PN_INT(PN_TUPLE_AT(f->argmap, argx)), argx);
 
   // if CL passed in with upvals, load them
   if (upc > 0)
     target->upvals(P, f, &asmb, lregs, need, upc);
 
-  for (pos = 0; pos < PN_FLEX_SIZE(f->asmb) / sizeof(PN_OP); pos++) {
-    offs[pos] = asmb->len;
-    for (jmpi = 0; jmpi < jmpc; jmpi++) {
-      if (jmps[jmpi].to == pos) {
-        unsigned char *asmj = asmb->ptr + jmps[jmpi].from;
-        target->jmpedit(P, f, &asmb, asmj, asmb->len - (jmps[jmpi].from + 4));
-      }
-    }
+  // one jump at most per op, and an offset for every op (plus the
+  // end.) forward jumps are all patched at once, after the last op.
+  len = PN_FLEX_SIZE(f->asmb) / sizeof(PN_OP);
+  jmps = malloc((len + 1) * sizeof(PNJumps));
+  offs = malloc((len + 1) * sizeof(size_t));
 
+  for (pos = 0; pos < len; pos++) {
+    offs[pos] = asmb->len;
     switch (PN_OP_AT(f->asmb, pos).code) {
       CASE_OP(MOVE, (P, f, &asmb, pos))
       CASE_OP(LOADPN, (P, f, &asmb, pos)) 
@@ -127,6 +179,7 @@ PN_F potion_jit_proto(Potion *P, PN proto, PN target_id) {
       CASE_OP(SETLOCAL, (P, f, &asmb, pos, regs))
       CASE_OP(GETUPVAL, (P, f, &asmb, pos, lregs))
       CASE_OP(SETUPVAL, (P, f, &asmb, pos, lregs))
+      CASE_OP(GETTABLE, (P, f, &asmb, pos, need))
       CASE_OP(NEWTUPLE, (P, f, &asmb, pos, need))
       CASE_OP(SETTUPLE, (P, f, &asmb, pos, need))
       CASE_OP(SETTABLE, (P, f, &asmb, pos, need))
@@ -160,15 +213,27 @@ PN_F potion_jit_proto(Potion *P, PN proto, PN target_id) {
       CASE_OP(NAMED, (P, f, &asmb, pos, need))
       CASE_OP(CALL, (P, f, &asmb, pos, need))
       CASE_OP(CALLSET, (P, f, &asmb, pos, need))
+      CASE_OP(TAILCALL, (P, f, &asmb, pos, need))
       CASE_OP(RETURN, (P, f, &asmb, pos))
       CASE_OP(PROTO, (P, f, &asmb, &pos, lregs, need, regs))
       CASE_OP(CLASS, (P, f, &asmb, pos, need))
+      CASE_OP(GUARD, (P, f, &asmb, pos, need))
+      CASE_OP(PUTTABLE, (P, f, &asmb, pos, need))
+      CASE_OP(CONCAT, (P, f, &asmb, pos, need))
     }
   }
+  offs[len] = asmb->len;
+
+  for (jmpi = 0; jmpi < jmpc; jmpi++) {
+    unsigned char *asmj = asmb->ptr + jmps[jmpi].from;
+    target->jmpedit(P, f, &asmb, asmj, offs[jmps[jmpi].to] - (jmps[jmpi].from + 4));
+  }
+  free(jmps);
+  free(offs);
 
   target->finish(P, f, &asmb);
 
-  fn = PN_ALLOC_FUNC(asmb->len);
+  fn = potion_code_new(P, (PN)f, asmb->ptr, asmb->len);
 #ifdef JIT_DEBUG
   printf("JIT(%p): ", fn);
   long ai = 0;
@@ -177,7 +242,6 @@ PN_F potion_jit_proto(Potion *P, PN proto, PN target_id) {
   }
   printf("\n");
 #endif
-  PN_MEMCPY_N(fn, asmb->ptr, u8, asmb->len);
 
   return f->jit = (PN_F)fn;
 }
@@ -188,7 +252,7 @@ PN_F potion_jit_proto(Potion *P, PN proto, PN target_id) {
   else \
     reg[op.a] = potion_obj_##name(P, reg[op.a], reg[op.b]);
 
-PN potion_vm(Potion *P, PN proto, PN self, PN vargs, PN_SIZE upc, PN *upargs) {
+PN potion_vm(Potion *P, PN proto, PN self, PN_SIZE argc, PN * volatile args, PN_SIZE upc, PN * volatile upargs) {
   vPN(Proto) f = (struct PNProto *)proto;
 
   // these variables persist as we jump around
@@ -198,13 +262,13 @@ PN potion_vm(Potion *P, PN proto, PN self, PN vargs, PN_SIZE upc, PN *upargs) {
   // these variables change from proto to proto
   // current = upvals | locals | self | reg
   PN_SIZE pos = 0;
-  long argx = 0;
-  PN *args = NULL, *upvals, *locals, *reg;
+  PN *upvals, *locals, *reg;
   PN *current = stack;
+  struct PNTraceRec *rec = NULL;
 
-  if (vargs != PN_NIL) args = PN_GET_TUPLE(vargs)->set;
 reentry:
-  if (current - stack >= STACK_MAX) {
+  // a wide proto's frame alone can be bigger than what's left
+  if ((current - stack) + f->upvalsize + f->localsize + 1 + PN_INT(f->stack) >= STACK_MAX) {
     fprintf(stderr, "all registers used up!");
     exit(1);
   }
@@ -214,27 +278,26 @@ reentry:
   reg = locals + f->localsize + 1;
 
   if (pos == 0) {
+    PN_SIZE i;
     reg[-1] = reg[0] = self;
+    // empty the locals that may become refs, since setlocal looks at what's there
+    for (i = 0; i < f->localsize; i++)
+      if (PN_LOCAL_REF(f, i)) locals[i] = PN_NIL;
     if (upc > 0 && upargs != NULL) {
-      PN_SIZE i;
       for (i = 0; i < upc; i++) {
         upvals[i] = upargs[i];
       }
     }
 
-    if (args != NULL) {
-      argx = 0;
-      PN_TUPLE_EACH(f->sig, i, v, {
-        if (PN_IS_STR(v)) {
-          PN_SIZE num = PN_GET(f->locals, v);
-          locals[num] = args[argx++];
-        }
-      });
-    }
+    // args land straight in their locals. any left off are nil.
+    for (i = 0; i < f->arity; i++)
+      locals[PN_INT(PN_TUPLE_AT(f->argmap, i))] = (i < argc ? args[i] : PN_NIL);
   }
 
   while (pos < PN_OP_LEN(f->asmb)) {
     PN_OP op = PN_OP_AT(f->asmb, pos);
+    if (rec != NULL)
+      potion_trace_record(P, &rec, f, current, pos);
     switch (op.code) {
       case OP_MOVE:
         reg[op.a] = reg[op.b];
@@ -249,20 +312,23 @@ reentry:
         reg[op.a] = reg[-1];
       break;
       case OP_GETLOCAL:
-        if (PN_IS_REF(locals[op.b]))
+        if (PN_LOCAL_REF(f, op.b) && PN_IS_REF(locals[op.b]))
           reg[op.a] = PN_DEREF(locals[op.b]);
         else
           reg[op.a] = locals[op.b];
       break;
       case OP_SETLOCAL:
-        if (PN_IS_REF(locals[op.b])) {
+        if (PN_LOCAL_REF(f, op.b) && PN_IS_REF(locals[op.b])) {
           PN_DEREF(locals[op.b]) = reg[op.a];
           PN_TOUCH(locals[op.b]);
         } else
           locals[op.b] = reg[op.a];
       break;
       case OP_GETUPVAL:
-        reg[op.a] = PN_DEREF(upvals[op.b]);
+        if (PN_UPVAL_FLAT(f, op.b))
+          reg[op.a] = upvals[op.b];
+        else
+          reg[op.a] = PN_DEREF(upvals[op.b]);
       break;
       case OP_SETUPVAL:
         PN_DEREF(upvals[op.b]) = reg[op.a];
@@ -352,6 +418,10 @@ reentry:
       break;
       case OP_JMP:
         pos += op.a;
+        if (op.a < 0 && P->trace) {
+          pos = potion_trace_loop(P, f, &rec, current, pos + 1);
+          continue;
+        }
       break;
       case OP_TEST:
         reg[op.a] = PN_BOOL(PN_TEST(reg[op.a]));
@@ -363,10 +433,64 @@ reentry:
         if (!PN_TEST(reg[op.a])) pos += op.b;
       break;
       case OP_NAMED: {
-        int x = potion_sig_find(P, reg[op.a], reg[op.b - 1]);
-        if (x >= 0) reg[op.a + x + 2] = reg[op.b];
+        int x = potion_vm_named(P, reg[op.a], reg[op.b - 1], ((PN)f >> 4) ^ pos);
+        if (x >= 0 && x < op.b - op.a - 3) reg[op.a + x + 2] = reg[op.b];
       }
       break;
+      case OP_CONCAT:
+        reg[op.a] = potion_vm_concat(P, reg[op.a], op.b - op.a, &reg[op.a + 1]);
+      break;
+      case OP_PUTTABLE:
+        // and l (i) = x writes one
+        if (PN_IS_TUPLE(reg[op.a]) && PN_IS_NUM(reg[op.a + 1])) {
+          long i = PN_INT(reg[op.a + 1]), len = PN_TUPLE_LEN(reg[op.a]);
+          if (i < 0) i += len;
+          if (i >= 0 && i < len) {
+            PN_TUPLE_AT(reg[op.a], i) = reg[op.b];
+            PN_TOUCH(reg[op.a]);
+            break;
+          }
+        }
+        reg[op.a] = potion_vm_puttable(P, reg[op.a], reg[op.a + 1], reg[op.b]);
+      break;
+      case OP_TAILCALL:
+        // a call to another bytecode proto reuses this frame: self
+        // and the args slide down to start its registers, and it
+        // returns to wherever this one would have. anything else is
+        // an ordinary call, with the RETURN after it.
+        if (PN_IS_CLOSURE(reg[op.a]) &&
+            PN_CLOSURE(reg[op.a])->method == (PN_F)potion_vm_proto) {
+          vPN(Closure) cl = PN_CLOSURE(reg[op.a]);
+          vPN(Proto) f2 = PN_PROTO(cl->data[0]);
+          PN *reg2 = current + f2->upvalsize + f2->localsize + 1;
+          if ((reg2 - stack) + PN_INT(f2->stack) + (op.b - op.a) + 8 < STACK_MAX) {
+            self = reg[op.a + 1];
+            argc = op.b - op.a - 1;
+            memmove((void *)(reg2 + 1), (void *)&reg[op.a + 2], sizeof(PN) * argc);
+            args = reg2 + 1;
+            upc = cl->extra - 1;
+            upargs = &cl->data[1];
+            f = f2;
+            pos = 0;
+            goto reentry;
+          }
+        }
+      case OP_GETTABLE:
+        // l (i) reads a tuple or a table right here, anything else
+        // is an ordinary call. a one-arg tail call that couldn't
+        // reuse the frame gets the same shortcut.
+        if (op.b == op.a + 2) {
+          if (PN_IS_TUPLE(reg[op.a]) && PN_IS_NUM(reg[op.b])) {
+            long i = PN_INT(reg[op.b]), len = PN_TUPLE_LEN(reg[op.a]);
+            if (i < 0) i += len;
+            reg[op.a] = (i >= 0 && i < len ? PN_TUPLE_AT(reg[op.a], i) : PN_NIL);
+            break;
+          }
+          if (PN_IS_TABLE(reg[op.a])) {
+            reg[op.a] = potion_table_at(P, PN_NIL, reg[op.a], reg[op.b]);
+            break;
+          }
+        }
       case OP_CALL:
         switch (PN_TYPE(reg[op.a])) {
           case PN_TVTABLE:
@@ -376,14 +500,12 @@ reentry:
             if (PN_CLOSURE(reg[op.a])->method != (PN_F)potion_vm_proto) {
               reg[op.a] = potion_call(P, reg[op.a], op.b - op.a, reg + op.a + 1);
             } else if (((reg - stack) + PN_INT(f->stack) + f->upvalsize + f->localsize + 8) >= STACK_MAX) {
-              int i;
-              PN argt = potion_tuple_with_size(P, (op.b - op.a) - 1);
-              for (i = 2; i < op.b - op.a; i++)
-                PN_TUPLE_AT(argt, i - 2) = reg[op.a + i];
-              reg[op.a] = potion_vm(P, PN_CLOSURE(reg[op.a])->data[0], reg[op.a + 1], argt,
+              reg[op.a] = potion_vm(P, PN_CLOSURE(reg[op.a])->data[0], reg[op.a + 1],
+                op.b - op.a - 1, &reg[op.a + 2],
                 PN_CLOSURE(reg[op.a])->extra - 1, &PN_CLOSURE(reg[op.a])->data[1]);
             } else {
               self = reg[op.a + 1];
+              argc = op.b - op.a - 1;
               args = &reg[op.a + 2];
               upc = PN_CLOSURE(reg[op.a])->extra - 1;
               upargs = &PN_CLOSURE(reg[op.a])->data[1];
@@ -440,6 +562,8 @@ reentry:
 
           if (op.code == OP_GETUPVAL) {
             cl->data[i+1] = upvals[op.b];
+          } else if (op.code == OP_GETLOCAL && PN_UPVAL_FLAT(PN_PROTO(proto), i)) {
+            cl->data[i+1] = locals[op.b];
           } else if (op.code == OP_GETLOCAL) {
             cl->data[i+1] = locals[op.b] = (PN)potion_ref(P, locals[op.b]);
           } else {
@@ -452,11 +576,16 @@ reentry:
       case OP_CLASS:
         reg[op.a] = potion_vm_class(P, reg[op.b], reg[op.a]);
       break;
+      case OP_GUARD:
+        reg[op.a] = potion_vm_guard(P, (PN)f, reg[op.a], op.b);
+      break;
     }
     pos++;
   }
 
 done:
+  if (rec != NULL)
+    potion_trace_abort(P, &rec);
   val = reg[0];
   return val;
 }
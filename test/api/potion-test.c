@@ -103,6 +103,27 @@ void potion_test_eval(CuTest *T) {
     PN_INT(num), 8);
 }
 
+static PN potion_test_sum(Potion *P, PN cl, PN self, PN_SIZE argc, PN * volatile argv) {
+  PN_SIZE i;
+  long sum = 0;
+  for (i = 0; i < argc; i++)
+    sum += PN_INT(argv[i]);
+  return PN_NUM(sum);
+}
+
+void potion_test_argv(CuTest *T) {
+  PN argv[21];
+  PN sum = PN_FUNCV(potion_test_sum, 0);
+  int i;
+  argv[0] = PN_NIL;
+  for (i = 1; i < 21; i++)
+    argv[i] = PN_NUM(i);
+  CuAssertIntEquals(T, "argv closure didn't get all its args",
+    PN_INT(potion_call(P, sum, 21, argv)), 210);
+  CuAssertIntEquals(T, "calling argv closure from c failed",
+    PN_INT(potion_closure_call(sum, PN_NIL, PN_NUM(3), PN_NUM(5))), 8);
+}
+
 void potion_test_allocated(CuTest *T) {
   void *scanptr = (void *)((char *)P->mem->birth_lo + PN_ALIGN(sizeof(struct PNMemory), 8));
   while ((PN)scanptr < (PN)P->mem->birth_cur) {
@@ -127,6 +148,7 @@ CuSuite *potion_suite() {
   SUITE_ADD_TEST(S, potion_test_tuple);
   SUITE_ADD_TEST(S, potion_test_sig);
   SUITE_ADD_TEST(S, potion_test_eval);
+  SUITE_ADD_TEST(S, potion_test_argv);
   SUITE_ADD_TEST(S, potion_test_allocated);
   return S;
 }